@@ -22,6 +22,9 @@ class AppDelegate: UIResponder, UIApplicationDelegate
     
     func application(application: UIApplication, didFinishLaunchingWithOptions launchOptions: [NSObject: AnyObject]?) -> Bool
     {
+        // Decode the message bubbles and icons in the background before the first conversation shows up
+        JSQMessagesAssetManager.sharedManager().preloadStandardImagesWithCompletion(nil)
+        
         window = UIWindow(frame: UIScreen.mainScreen().bounds)
         window?.tintColor = UIColor(red: 241.0 / 255.0, green: 110.0 / 255.0, blue: 0.0, alpha: 1.0)
         window?.rootViewController = UINavigationController(rootViewController: messagesViewController)
@@ -20,6 +20,12 @@
 
 @interface JSQSystemSoundPlayer (JSQMessages)
 
+/**
+ *  Loads the default sounds for received and sent messages on a background queue,
+ *  so that the first of them plays without delay. These sounds are pinned in the cache of the sound player.
+ */
++ (void)jsq_preloadMessageSounds;
+
 /**
  *  Plays the default sound for received messages.
  */
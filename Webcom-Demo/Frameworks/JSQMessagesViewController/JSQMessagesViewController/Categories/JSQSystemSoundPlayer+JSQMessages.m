@@ -29,6 +29,12 @@ static NSString * const kJSQMessageSentSoundName = @"message_sent";
 
 #pragma mark - Public
 
++ (void)jsq_preloadMessageSounds
+{
+    [self jsq_loadSoundFromJSQMessagesBundleWithName:kJSQMessageReceivedSoundName completion:nil];
+    [self jsq_loadSoundFromJSQMessagesBundleWithName:kJSQMessageSentSoundName completion:nil];
+}
+
 + (void)jsq_playMessageReceivedSound
 {
     [self jsq_playSoundFromJSQMessagesBundleWithName:kJSQMessageReceivedSoundName asAlert:NO];
@@ -51,25 +57,55 @@ static NSString * const kJSQMessageSentSoundName = @"message_sent";
 
 #pragma mark - Private
 
-+ (void)jsq_playSoundFromJSQMessagesBundleWithName:(NSString *)soundName asAlert:(BOOL)asAlert
++ (NSString *)jsq_fileNameForSoundName:(NSString *)soundName
+{
+    return [NSString stringWithFormat:@"JSQMessagesAssets.bundle/Sounds/%@", soundName];
+}
+
++ (void)jsq_loadSoundFromJSQMessagesBundleWithName:(NSString *)soundName
+                                        completion:(JSQSystemSoundPlayerLoadCompletionBlock)completion
 {
-    //  save sound player original bundle
-    NSString *originalPlayerBundleIdentifier = [JSQSystemSoundPlayer sharedPlayer].bundle.bundleIdentifier;
+    JSQSystemSoundPlayer *player = [JSQSystemSoundPlayer sharedPlayer];
+    NSString *fileName = [self jsq_fileNameForSoundName:soundName];
     
-    //  search for sounds in this library's bundle
-    [JSQSystemSoundPlayer sharedPlayer].bundle = [NSBundle jsq_messagesBundle];
+    //  message sounds play all the time, they are never evicted under memory pressure
+    [player pinSoundWithFilename:fileName];
     
-    NSString *fileName = [NSString stringWithFormat:@"JSQMessagesAssets.bundle/Sounds/%@", soundName];
+    //  search for sounds in this library's bundle, without touching the bundle of the shared player
+    [player loadSoundWithFilename:fileName
+                    fileExtension:kJSQSystemSoundTypeAIFF
+                           bundle:[NSBundle jsq_messagesBundle]
+                       completion:completion];
+}
+
++ (void)jsq_playSoundFromJSQMessagesBundleWithName:(NSString *)soundName asAlert:(BOOL)asAlert
+{
+    JSQSystemSoundPlayer *player = [JSQSystemSoundPlayer sharedPlayer];
     
-    if (asAlert) {
-        [[JSQSystemSoundPlayer sharedPlayer] playAlertSoundWithFilename:fileName fileExtension:kJSQSystemSoundTypeAIFF];
-    }
-    else {
-        [[JSQSystemSoundPlayer sharedPlayer] playSoundWithFilename:fileName fileExtension:kJSQSystemSoundTypeAIFF];
+    //  once loaded, sounds play by handle, bursts are coalesced by the player
+    JSQSystemSoundHandle handle = [player soundHandleForFilename:[self jsq_fileNameForSoundName:soundName]];
+    if (handle != JSQSystemSoundHandleNone) {
+        if (asAlert) {
+            [player playAlertSoundWithHandle:handle];
+        }
+        else {
+            [player playSoundWithHandle:handle];
+        }
+        return;
     }
     
-    //  restore original bundle
-    [JSQSystemSoundPlayer sharedPlayer].bundle = [NSBundle bundleWithIdentifier:originalPlayerBundleIdentifier];
+    [self jsq_loadSoundFromJSQMessagesBundleWithName:soundName completion:^(JSQSystemSoundHandle loadedHandle) {
+        if (loadedHandle == JSQSystemSoundHandleNone) {
+            return;
+        }
+        
+        if (asAlert) {
+            [player playAlertSoundWithHandle:loadedHandle];
+        }
+        else {
+            [player playSoundWithHandle:loadedHandle];
+        }
+    }];
 }
 
 @end
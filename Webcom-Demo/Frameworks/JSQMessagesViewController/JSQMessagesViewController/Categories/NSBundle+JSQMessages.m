@@ -29,9 +29,16 @@
 
 + (NSBundle *)jsq_messagesAssetBundle
 {
-    NSString *bundleResourcePath = [NSBundle jsq_messagesBundle].resourcePath;
-    NSString *assetPath = [bundleResourcePath stringByAppendingPathComponent:@"JSQMessagesAssets.bundle"];
-    return [NSBundle bundleWithPath:assetPath];
+    static NSBundle *_assetBundle = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        NSString *bundleResourcePath = [NSBundle jsq_messagesBundle].resourcePath;
+        NSString *assetPath = [bundleResourcePath stringByAppendingPathComponent:@"JSQMessagesAssets.bundle"];
+        _assetBundle = [NSBundle bundleWithPath:assetPath];
+    });
+    
+    return _assetBundle;
 }
 
 + (NSString *)jsq_localizedStringForKey:(NSString *)key
@@ -18,6 +18,8 @@
 
 #import <UIKit/UIKit.h>
 
+#import "JSQMessagesTintKernel.h"
+
 @interface UIColor (JSQMessages)
 
 #pragma mark - Message bubble colors
@@ -53,4 +55,13 @@
  */
 - (UIColor *)jsq_colorByDarkeningColorWithValue:(CGFloat)value;
 
+/**
+ *  Converts the receiver to a color with 8-bit components suitable for `JSQMessagesTintKernelApply`.
+ *
+ *  @param tintColor On return, the RGBA components of the receiver, clamped and rounded to 8 bits. This value must not be `NULL`.
+ *
+ *  @return `YES` if the receiver could be converted to RGBA, `NO` otherwise, for example for pattern colors.
+ */
+- (BOOL)jsq_getTintColor:(JSQMessagesTintColor *)tintColor;
+
 @end
\ No newline at end of file
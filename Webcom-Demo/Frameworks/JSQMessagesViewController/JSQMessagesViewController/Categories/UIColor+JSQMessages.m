@@ -87,4 +87,21 @@
     return retColor;
 }
 
+- (BOOL)jsq_getTintColor:(JSQMessagesTintColor *)tintColor
+{
+    NSParameterAssert(tintColor != NULL);
+    
+    CGFloat red = 0.0f, green = 0.0f, blue = 0.0f, alpha = 0.0f;
+    
+    if (![self getRed:&red green:&green blue:&blue alpha:&alpha]) {
+        return NO;
+    }
+    
+    tintColor->red = (uint8_t)lroundf(MAX(0.0f, MIN(red, 1.0f)) * 255.0f);
+    tintColor->green = (uint8_t)lroundf(MAX(0.0f, MIN(green, 1.0f)) * 255.0f);
+    tintColor->blue = (uint8_t)lroundf(MAX(0.0f, MIN(blue, 1.0f)) * 255.0f);
+    tintColor->alpha = (uint8_t)lroundf(MAX(0.0f, MIN(alpha, 1.0f)) * 255.0f);
+    return YES;
+}
+
 @end
\ No newline at end of file
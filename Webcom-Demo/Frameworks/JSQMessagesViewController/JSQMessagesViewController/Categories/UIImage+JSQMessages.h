@@ -29,6 +29,30 @@
  */
 - (UIImage *)jsq_imageMaskedWithColor:(UIColor *)maskColor;
 
+/**
+ *  Creates and returns a new image object that is masked with the specified mask color,
+ *  and a second one masked with the highlighted color, both produced in a single pass over the image.
+ *
+ *  @param maskColor        The color value for the mask. This value must not be `nil`.
+ *  @param highlightedColor The color value for the highlighted mask. This value must not be `nil`.
+ *  @param highlightedImage On return, a new image object masked with the highlighted color. Pass `NULL` if not needed.
+ *
+ *  @return A new image object masked with the specified color.
+ *
+ *  @discussion The images are tinted by `JSQMessagesTintKernelApply` on premultiplied RGBA buffers
+ *  rather than by clipping and filling a CoreGraphics context.
+ */
+- (UIImage *)jsq_imageMaskedWithColor:(UIColor *)maskColor
+                     highlightedColor:(UIColor *)highlightedColor
+                     highlightedImage:(UIImage * __autoreleasing *)highlightedImage;
+
+/**
+ *  Returns whether the image has an alpha channel.
+ *
+ *  @return `YES` if the pixels of the image have an alpha component, `NO` if the image is opaque.
+ */
+- (BOOL)jsq_hasAlpha;
+
 /**
  *  @return The regular message bubble image.
  */
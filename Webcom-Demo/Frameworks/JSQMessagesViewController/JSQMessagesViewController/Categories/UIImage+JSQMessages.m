@@ -18,7 +18,16 @@
 
 #import "UIImage+JSQMessages.h"
 
-#import "NSBundle+JSQMessages.h"
+#import "JSQMessagesAssetManager.h"
+#import "JSQMessagesTintKernel.h"
+
+#import "UIColor+JSQMessages.h"
+
+
+static void JSQReleasePixels(void *info, const void *data, size_t size)
+{
+    free((void *)data);
+}
 
 
 @implementation UIImage (JSQMessages)
@@ -26,7 +35,86 @@
 - (UIImage *)jsq_imageMaskedWithColor:(UIColor *)maskColor
 {
     NSParameterAssert(maskColor != nil);
+    return [self jsq_imageMaskedWithColor:maskColor highlightedColor:maskColor highlightedImage:NULL];
+}
+
+- (UIImage *)jsq_imageMaskedWithColor:(UIColor *)maskColor
+                     highlightedColor:(UIColor *)highlightedColor
+                     highlightedImage:(UIImage * __autoreleasing *)highlightedImage
+{
+    NSParameterAssert(maskColor != nil);
+    NSParameterAssert(highlightedColor != nil);
     
+    JSQMessagesTintColor tintColor;
+    JSQMessagesTintColor highlightedTintColor;
+    
+    CGImageRef imageRef = self.CGImage;
+    CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(imageRef);
+    BOOL hasAlpha = (alphaInfo != kCGImageAlphaNone && alphaInfo != kCGImageAlphaNoneSkipFirst && alphaInfo != kCGImageAlphaNoneSkipLast);
+    
+    if (imageRef == NULL
+        || !hasAlpha
+        || ![maskColor jsq_getTintColor:&tintColor]
+        || ![highlightedColor jsq_getTintColor:&highlightedTintColor]) {
+        //  pattern colors, opaque images and CIImage-backed images cannot go through the kernel
+        if (highlightedImage != NULL) {
+            *highlightedImage = [self jsq_imageMaskedWithColorUsingCoreGraphics:highlightedColor];
+        }
+        return [self jsq_imageMaskedWithColorUsingCoreGraphics:maskColor];
+    }
+    
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    size_t bytesPerRow = 4 * width;
+    
+    //  CoreGraphics only extracts the alpha channel here, the tinting itself is done by the kernel
+    CGContextRef maskContext = CGBitmapContextCreate(NULL, width, height, 8, 0, NULL, (CGBitmapInfo)kCGImageAlphaOnly);
+    if (maskContext == NULL) {
+        return nil;
+    }
+    
+    CGContextDrawImage(maskContext, CGRectMake(0.0f, 0.0f, width, height), imageRef);
+    
+    uint8_t *pixels = malloc(bytesPerRow * height);
+    uint8_t *highlightedPixels = (highlightedImage != NULL) ? malloc(bytesPerRow * height) : NULL;
+    
+    if (pixels == NULL || (highlightedImage != NULL && highlightedPixels == NULL)) {
+        free(pixels);
+        free(highlightedPixels);
+        CGContextRelease(maskContext);
+        return nil;
+    }
+    
+    JSQMessagesTintKernelApply(CGBitmapContextGetData(maskContext),
+                               CGBitmapContextGetBytesPerRow(maskContext),
+                               width,
+                               height,
+                               tintColor,
+                               pixels,
+                               highlightedTintColor,
+                               highlightedPixels,
+                               bytesPerRow);
+    
+    CGContextRelease(maskContext);
+    
+    if (highlightedImage != NULL) {
+        *highlightedImage = [UIImage jsq_imageWithPixels:highlightedPixels width:width height:height scale:self.scale];
+    }
+    
+    return [UIImage jsq_imageWithPixels:pixels width:width height:height scale:self.scale];
+}
+
+- (BOOL)jsq_hasAlpha
+{
+    CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(self.CGImage);
+    
+    return alphaInfo != kCGImageAlphaNone
+            && alphaInfo != kCGImageAlphaNoneSkipFirst
+            && alphaInfo != kCGImageAlphaNoneSkipLast;
+}
+
+- (UIImage *)jsq_imageMaskedWithColorUsingCoreGraphics:(UIColor *)maskColor
+{
     CGRect imageRect = CGRectMake(0.0f, 0.0f, self.size.width, self.size.height);
     UIImage *newImage = nil;
     
@@ -48,11 +136,28 @@
     return newImage;
 }
 
++ (UIImage *)jsq_imageWithPixels:(uint8_t *)pixels width:(size_t)width height:(size_t)height scale:(CGFloat)scale
+{
+    //  the image takes ownership of the pixels, they are freed with the data provider
+    CGDataProviderRef provider = CGDataProviderCreateWithData(NULL, pixels, 4 * width * height, JSQReleasePixels);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    
+    CGImageRef imageRef = CGImageCreate(width, height, 8, 32, 4 * width, colorSpace,
+                                        (CGBitmapInfo)kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big,
+                                        provider, NULL, false, kCGRenderingIntentDefault);
+    
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
 + (UIImage *)jsq_bubbleImageFromBundleWithName:(NSString *)name
 {
-    NSBundle *bundle = [NSBundle jsq_messagesAssetBundle];
-    NSString *path = [bundle pathForResource:name ofType:@"png" inDirectory:@"Images"];
-    return [UIImage imageWithContentsOfFile:path];
+    return [[JSQMessagesAssetManager sharedManager] imageNamed:name];
 }
 
 + (UIImage *)jsq_bubbleRegularImage
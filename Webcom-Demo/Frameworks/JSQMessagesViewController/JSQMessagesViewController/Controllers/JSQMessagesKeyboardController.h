@@ -69,6 +69,9 @@ FOUNDATION_EXPORT NSString * const JSQMessagesKeyboardControllerUserInfoKeyKeybo
  *  allow the user to interactively pan the keyboard up and down in the `contextView`.
  *  
  *  When the system keyboard frame changes, it posts the `JSQMessagesKeyboardControllerNotificationKeyboardDidChangeFrame`.
+ *
+ *  @discussion Frame changes made while the user pans the keyboard are coalesced into at most one update
+ *  per display frame. Keyboard show and hide animations are reported right away, inside their animation blocks.
  */
 @interface JSQMessagesKeyboardController : NSObject
 
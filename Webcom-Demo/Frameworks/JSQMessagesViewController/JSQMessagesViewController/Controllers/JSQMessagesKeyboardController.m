@@ -41,6 +41,14 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
 
 @property (weak, nonatomic) UIView *keyboardView;
 
+@property (strong, nonatomic) CADisplayLink *displayLink;
+
+@property (assign, nonatomic) BOOL hasPendingKeyboardFrame;
+
+@property (assign, nonatomic) CGRect pendingKeyboardFrame;
+
+@property (assign, nonatomic) CGRect lastNotifiedKeyboardFrame;
+
 - (void)jsq_registerForNotifications;
 - (void)jsq_unregisterForNotifications;
 
@@ -54,6 +62,11 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
 - (void)jsq_notifyKeyboardFrameNotificationForFrame:(CGRect)frame;
 - (void)jsq_resetKeyboardAndTextView;
 
+- (void)jsq_scheduleKeyboardFrameUpdate;
+- (void)jsq_flushPendingKeyboardFrame;
+- (void)jsq_invalidateDisplayLink;
+- (void)jsq_displayLinkDidFire:(CADisplayLink *)displayLink;
+
 - (void)jsq_removeKeyboardFrameObserver;
 
 - (void)jsq_handlePanGestureRecognizer:(UIPanGestureRecognizer *)pan;
@@ -83,12 +96,16 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
         _panGestureRecognizer = panGestureRecognizer;
         _delegate = delegate;
         _jsq_isObserving = NO;
+        _pendingKeyboardFrame = CGRectNull;
+        _lastNotifiedKeyboardFrame = CGRectNull;
     }
     return self;
 }
 
 - (void)dealloc
 {
+    [_displayLink invalidate];
+    _displayLink = nil;
     [self jsq_removeKeyboardFrameObserver];
     [self jsq_unregisterForNotifications];
     _textView = nil;
@@ -148,6 +165,7 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
 - (void)endListeningForKeyboard
 {
     [self jsq_unregisterForNotifications];
+    [self jsq_invalidateDisplayLink];
 
     [self jsq_setKeyboardViewHidden:NO];
     self.keyboardView = nil;
@@ -256,6 +274,10 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
 
 - (void)jsq_notifyKeyboardFrameNotificationForFrame:(CGRect)frame
 {
+    //  a change reported directly supersedes the coalesced one
+    self.hasPendingKeyboardFrame = NO;
+    self.lastNotifiedKeyboardFrame = frame;
+
     [self.delegate keyboardController:self keyboardDidChangeFrame:frame];
 
     [[NSNotificationCenter defaultCenter] postNotificationName:JSQMessagesKeyboardControllerNotificationKeyboardDidChangeFrame
@@ -267,9 +289,57 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
 {
     [self jsq_setKeyboardViewHidden:YES];
     [self jsq_removeKeyboardFrameObserver];
+    [self jsq_invalidateDisplayLink];
     [self.textView resignFirstResponder];
 }
 
+#pragma mark - Display link
+
+- (void)jsq_scheduleKeyboardFrameUpdate
+{
+    if (self.displayLink != nil) {
+        return;
+    }
+
+    //  common modes, so that updates keep coming while the collection view is tracking the pan
+    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(jsq_displayLinkDidFire:)];
+    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)jsq_flushPendingKeyboardFrame
+{
+    if (!self.hasPendingKeyboardFrame) {
+        return;
+    }
+
+    CGRect keyboardFrame = self.pendingKeyboardFrame;
+    self.hasPendingKeyboardFrame = NO;
+
+    if (CGRectEqualToRect(keyboardFrame, self.lastNotifiedKeyboardFrame)) {
+        return;
+    }
+
+    [self jsq_notifyKeyboardFrameNotificationForFrame:keyboardFrame];
+}
+
+- (void)jsq_invalidateDisplayLink
+{
+    //  the display link retains its target, it only lives while frames are changing
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+    self.hasPendingKeyboardFrame = NO;
+}
+
+- (void)jsq_displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    if (!self.hasPendingKeyboardFrame) {
+        [self jsq_invalidateDisplayLink];
+        return;
+    }
+
+    [self jsq_flushPendingKeyboardFrame];
+}
+
 #pragma mark - Key-value observing
 
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
@@ -285,9 +355,11 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
                 return;
             }
             
-            CGRect keyboardEndFrameConverted = [self.contextView convertRect:newKeyboardFrame
-                                                                    fromView:self.keyboardView.superview];
-            [self jsq_notifyKeyboardFrameNotificationForFrame:keyboardEndFrameConverted];
+            //  coalesce to one update per display frame, the last frame wins
+            self.pendingKeyboardFrame = [self.contextView convertRect:newKeyboardFrame
+                                                             fromView:self.keyboardView.superview];
+            self.hasPendingKeyboardFrame = YES;
+            [self jsq_scheduleKeyboardFrameUpdate];
         }
     }
 }
@@ -379,6 +451,9 @@ typedef void (^JSQAnimationCompletionBlock)(BOOL finished);
                                 options:UIViewAnimationOptionBeginFromCurrentState | UIViewAnimationCurveEaseOut
                              animations:^{
                                  self.keyboardView.frame = newKeyboardViewFrame;
+
+                                 //  report the final frame inside the animation block, so that the delegate animates along
+                                 [self jsq_flushPendingKeyboardFrame];
                              }
                              completion:^(BOOL finished) {
                                  self.keyboardView.userInteractionEnabled = !shouldHide;
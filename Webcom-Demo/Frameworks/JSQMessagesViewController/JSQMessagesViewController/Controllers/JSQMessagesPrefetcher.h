@@ -0,0 +1,103 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class JSQMessagesCollectionView;
+@class JSQMessagesDataDetector;
+
+/**
+ *  An instance of `JSQMessagesPrefetcher` warms the work needed to display message cells
+ *  before they scroll on screen. For each item it computes the cell size, loads the bubble and avatar images,
+ *  loads the media view of media messages and requests link detection for text messages.
+ *
+ *  Items are fed either by `UICollectionViewDataSourcePrefetching` on iOS 10 and later, or by
+ *  `scrollViewDidScroll:`, which looks ahead of the scroll direction by a distance proportional to the scroll velocity.
+ *  Work is spread across run loop passes so that it does not stall scrolling, and items that leave the
+ *  prefetch window are dropped before they are warmed.
+ */
+@interface JSQMessagesPrefetcher : NSObject
+
+/**
+ *  The collection view whose items are prefetched.
+ */
+@property (weak, nonatomic, readonly) JSQMessagesCollectionView *collectionView;
+
+/**
+ *  The data detector asked to detect links in text messages ahead of display.
+ *  The default value is `nil`, which skips link detection.
+ */
+@property (strong, nonatomic) JSQMessagesDataDetector *dataDetector;
+
+/**
+ *  The maximum distance to look ahead of the visible bounds when scrolling, in screens.
+ *  The default value is `2.0`.
+ */
+@property (assign, nonatomic) CGFloat maximumScreensAhead;
+
+/**
+ *  The maximum number of items warmed per run loop pass. The default value is `4`.
+ */
+@property (assign, nonatomic) NSUInteger maximumItemsPerPass;
+
+/**
+ *  Creates and returns a prefetcher for the given collection view.
+ *
+ *  @param collectionView The collection view whose items should be prefetched. This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesPrefetcher` object if successful, `nil` otherwise.
+ */
+- (instancetype)initWithCollectionView:(JSQMessagesCollectionView *)collectionView NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Not a valid initializer.
+ */
+- (id)init NS_UNAVAILABLE;
+
+/**
+ *  Schedules the items at the given index paths to be warmed.
+ *
+ *  @param indexPaths The index paths of the items that are about to be displayed.
+ */
+- (void)prefetchItemsAtIndexPaths:(NSArray *)indexPaths;
+
+/**
+ *  Drops the items at the given index paths if they have not been warmed yet.
+ *  Link detection requested for warmed items is cancelled if it has not started yet.
+ *
+ *  @param indexPaths The index paths of the items that are no longer about to be displayed.
+ */
+- (void)cancelPrefetchingForItemsAtIndexPaths:(NSArray *)indexPaths;
+
+/**
+ *  Drops all items that have not been warmed yet. Link detection already requested runs to completion and is cached.
+ *
+ *  @discussion Call this method when the index paths of the collection view change, for example after reloading data.
+ */
+- (void)cancelAllPrefetching;
+
+/**
+ *  Updates the scroll velocity and schedules the items ahead of the scroll direction.
+ *
+ *  @param scrollView The scroll view that scrolled. This should be the prefetcher's collection view.
+ */
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView;
+
+@end
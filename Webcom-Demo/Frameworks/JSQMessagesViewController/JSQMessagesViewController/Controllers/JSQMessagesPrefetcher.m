@@ -0,0 +1,288 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesPrefetcher.h"
+
+#import "JSQMessagesCollectionView.h"
+#import "JSQMessagesCollectionViewFlowLayout.h"
+#import "JSQMessagesDataDetector.h"
+
+#import "JSQMessageData.h"
+#import "JSQMessageMediaData.h"
+#import "JSQMessageBubbleImageDataSource.h"
+#import "JSQMessageAvatarImageDataSource.h"
+#import "JSQMessagesSenderTable.h"
+
+
+/**
+ *  The scroll duration covered by the lookahead distance at the current velocity.
+ */
+static const CFTimeInterval kJSQMessagesPrefetcherLookaheadDuration = 0.5;
+
+
+@interface JSQMessagesPrefetcher ()
+
+@property (weak, nonatomic) JSQMessagesCollectionView *collectionView;
+
+@property (strong, nonatomic) NSMutableOrderedSet *pendingIndexPaths;
+
+@property (assign, nonatomic) BOOL jsq_isPassScheduled;
+
+@property (assign, nonatomic) CGFloat lastContentOffsetY;
+
+@property (assign, nonatomic) CFTimeInterval lastScrollTimestamp;
+
+@property (assign, nonatomic) CGFloat lastLookaheadContentOffsetY;
+
+@property (assign, nonatomic) CGFloat scrollVelocity;
+
+- (void)jsq_scheduleNextPass;
+- (void)jsq_performPass;
+- (void)jsq_warmItemAtIndexPath:(NSIndexPath *)indexPath;
+- (id<JSQMessageData>)jsq_messageDataForItemAtIndexPath:(NSIndexPath *)indexPath;
+
+@end
+
+
+
+@implementation JSQMessagesPrefetcher
+
+#pragma mark - Initialization
+
+- (instancetype)initWithCollectionView:(JSQMessagesCollectionView *)collectionView
+{
+    NSParameterAssert(collectionView != nil);
+
+    self = [super init];
+    if (self) {
+        _collectionView = collectionView;
+        _maximumScreensAhead = 2.0f;
+        _maximumItemsPerPass = 4;
+        _pendingIndexPaths = [NSMutableOrderedSet new];
+        _jsq_isPassScheduled = NO;
+        _lastLookaheadContentOffsetY = CGFLOAT_MAX;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _collectionView = nil;
+    _dataDetector = nil;
+    _pendingIndexPaths = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: pendingItems=%@, scrollVelocity=%@, maximumScreensAhead=%@>",
+            [self class], @(self.pendingIndexPaths.count), @(self.scrollVelocity), @(self.maximumScreensAhead)];
+}
+
+#pragma mark - Prefetching
+
+- (void)prefetchItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    if (indexPaths.count == 0) {
+        return;
+    }
+
+    [self.pendingIndexPaths addObjectsFromArray:indexPaths];
+    [self jsq_scheduleNextPass];
+}
+
+- (void)cancelPrefetchingForItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    for (NSIndexPath *indexPath in indexPaths) {
+        if ([self.pendingIndexPaths containsObject:indexPath]) {
+            //  not warmed yet, so no link detection was requested
+            [self.pendingIndexPaths removeObject:indexPath];
+            continue;
+        }
+
+        if (self.dataDetector == nil) {
+            continue;
+        }
+
+        //  cancelling is a no-op once detection has started or finished, or if the item changed since
+        id<JSQMessageData> messageItem = [self jsq_messageDataForItemAtIndexPath:indexPath];
+        if (messageItem != nil && ![messageItem isMediaMessage]) {
+            [self.dataDetector cancelLinkDetectionForMessageData:messageItem];
+        }
+    }
+}
+
+- (void)cancelAllPrefetching
+{
+    [self.pendingIndexPaths removeAllObjects];
+
+    self.lastLookaheadContentOffsetY = CGFLOAT_MAX;
+}
+
+#pragma mark - Scrolling
+
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView
+{
+    CFTimeInterval timestamp = CACurrentMediaTime();
+    CGFloat contentOffsetY = scrollView.contentOffset.y;
+
+    CFTimeInterval elapsed = timestamp - self.lastScrollTimestamp;
+    if (self.lastScrollTimestamp > 0.0 && elapsed > 0.0) {
+        self.scrollVelocity = (contentOffsetY - self.lastContentOffsetY) / elapsed;
+    }
+
+    self.lastContentOffsetY = contentOffsetY;
+    self.lastScrollTimestamp = timestamp;
+
+    //  ignore programmatic scrolling, such as scrolling to the most recent message
+    if (!scrollView.isTracking && !scrollView.isDecelerating) {
+        return;
+    }
+
+    CGRect bounds = scrollView.bounds;
+    CGFloat screenHeight = CGRectGetHeight(bounds);
+    if (screenHeight <= 0.0f || self.scrollVelocity == 0.0f) {
+        return;
+    }
+
+    //  re-evaluate the lookahead window every quarter screen
+    if (fabs(contentOffsetY - self.lastLookaheadContentOffsetY) < screenHeight / 4.0f) {
+        return;
+    }
+
+    self.lastLookaheadContentOffsetY = contentOffsetY;
+
+    CGFloat lookahead = MAX(screenHeight, fabs(self.scrollVelocity) * kJSQMessagesPrefetcherLookaheadDuration);
+    lookahead = MIN(lookahead, screenHeight * self.maximumScreensAhead);
+
+    CGRect lookaheadRect = bounds;
+    lookaheadRect.size.height = lookahead;
+    lookaheadRect.origin.y = (self.scrollVelocity > 0.0f) ? CGRectGetMaxY(bounds) : CGRectGetMinY(bounds) - lookahead;
+
+    NSArray *attributes = [self.collectionView.collectionViewLayout layoutAttributesForElementsInRect:lookaheadRect];
+
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:attributes.count];
+    for (UICollectionViewLayoutAttributes *itemAttributes in attributes) {
+        if (itemAttributes.representedElementCategory == UICollectionElementCategoryCell) {
+            [indexPaths addObject:itemAttributes.indexPath];
+        }
+    }
+
+    //  drop pending items that are no longer ahead of the scroll direction
+    NSMutableOrderedSet *staleIndexPaths = [self.pendingIndexPaths mutableCopy];
+    [staleIndexPaths minusSet:[NSSet setWithArray:indexPaths]];
+    [self cancelPrefetchingForItemsAtIndexPaths:[staleIndexPaths array]];
+
+    //  warm the items closest to the visible bounds first
+    if (self.scrollVelocity < 0.0f) {
+        indexPaths = [[[indexPaths reverseObjectEnumerator] allObjects] mutableCopy];
+    }
+
+    [self prefetchItemsAtIndexPaths:indexPaths];
+}
+
+#pragma mark - Private
+
+- (void)jsq_scheduleNextPass
+{
+    if (self.jsq_isPassScheduled || self.pendingIndexPaths.count == 0) {
+        return;
+    }
+
+    self.jsq_isPassScheduled = YES;
+
+    __weak JSQMessagesPrefetcher *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf jsq_performPass];
+    });
+}
+
+- (void)jsq_performPass
+{
+    self.jsq_isPassScheduled = NO;
+
+    NSUInteger count = MIN(self.pendingIndexPaths.count, MAX(self.maximumItemsPerPass, 1));
+    NSArray *indexPaths = [[self.pendingIndexPaths array] subarrayWithRange:NSMakeRange(0, count)];
+    [self.pendingIndexPaths removeObjectsInRange:NSMakeRange(0, count)];
+
+    for (NSIndexPath *indexPath in indexPaths) {
+        [self jsq_warmItemAtIndexPath:indexPath];
+    }
+
+    [self jsq_scheduleNextPass];
+}
+
+- (void)jsq_warmItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    JSQMessagesCollectionView *collectionView = self.collectionView;
+    id<JSQMessagesCollectionViewDataSource> dataSource = collectionView.dataSource;
+
+    id<JSQMessageData> messageItem = [self jsq_messageDataForItemAtIndexPath:indexPath];
+    if (messageItem == nil) {
+        return;
+    }
+
+    JSQMessagesCollectionViewFlowLayout *layout = collectionView.collectionViewLayout;
+    [layout sizeForItemAtIndexPath:indexPath];
+
+    if ([messageItem isMediaMessage]) {
+        [[messageItem media] mediaView];
+    }
+    else {
+        id<JSQMessageBubbleImageDataSource> bubbleImageDataSource = [dataSource collectionView:collectionView messageBubbleImageDataForItemAtIndexPath:indexPath];
+        [bubbleImageDataSource messageBubbleImage];
+
+        if (self.dataDetector != nil && [self.dataDetector cachedLinksForMessageData:messageItem] == nil) {
+            [self.dataDetector detectLinksForMessageData:messageItem completion:nil];
+        }
+    }
+
+    BOOL isOutgoingMessage = [JSQMessagesSenderTable isOutgoingMessageData:messageItem forDataSource:dataSource];
+    CGSize avatarSize = isOutgoingMessage ? layout.outgoingAvatarViewSize : layout.incomingAvatarViewSize;
+
+    if (!CGSizeEqualToSize(avatarSize, CGSizeZero)) {
+        id<JSQMessageAvatarImageDataSource> avatarImageDataSource = [dataSource collectionView:collectionView avatarImageDataForItemAtIndexPath:indexPath];
+        [avatarImageDataSource avatarImage];
+    }
+}
+
+- (id<JSQMessageData>)jsq_messageDataForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    JSQMessagesCollectionView *collectionView = self.collectionView;
+    id<JSQMessagesCollectionViewDataSource> dataSource = collectionView.dataSource;
+
+    if (collectionView == nil || dataSource == nil) {
+        return nil;
+    }
+
+    //  the data may have changed since the item was scheduled
+    if (indexPath.section >= [collectionView numberOfSections]
+        || indexPath.item >= [collectionView numberOfItemsInSection:indexPath.section]) {
+        return nil;
+    }
+
+    return [dataSource collectionView:collectionView messageDataForItemAtIndexPath:indexPath];
+}
+
+@end
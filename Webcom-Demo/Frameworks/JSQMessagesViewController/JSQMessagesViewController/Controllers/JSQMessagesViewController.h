@@ -23,6 +23,11 @@
 #import "JSQMessagesInputToolbar.h"
 #import "JSQMessagesKeyboardController.h"
 
+@class JSQMessagesDataDetector;
+@class JSQMessagesCellRenderer;
+@class JSQMessagesPrefetcher;
+@class JSQMessagesDaySections;
+
 /**
  *  The `JSQMessagesViewController` class is an abstract class that represents a view controller whose content consists of
  *  a `JSQMessagesCollectionView` and `JSQMessagesInputToolbar` and is specialized to display a messaging interface.
@@ -66,6 +71,14 @@
  */
 @property (copy, nonatomic) NSString *senderId;
 
+/**
+ *  The ordinal of `senderId` in the shared `JSQMessagesSenderTable`, updated whenever `senderId` is set.
+ *
+ *  @discussion Messages that provide a `senderOrdinal` are compared to this value to determine
+ *  if they are outgoing. The value is `JSQMessagesSenderOrdinalNone` until `senderId` is set.
+ */
+@property (assign, nonatomic, readonly) NSUInteger senderOrdinal;
+
 /**
  *  Specifies whether or not the view controller should automatically scroll to the most recent message
  *  when the view appears and when sending, receiving, and composing a new message.
@@ -172,8 +185,68 @@
  */
 @property (assign, nonatomic) CGFloat topContentAdditionalInset;
 
+/**
+ *  The data detector used to find links, phone numbers and addresses in text messages.
+ *
+ *  @discussion Detection runs once per message on a background queue and the results are cached.
+ *  Cells display the cached ranges as links instead of enabling `dataDetectorTypes` on their text view.
+ *  The default value is `[JSQMessagesDataDetector sharedDetector]`. Set to `nil` to disable link detection.
+ */
+@property (strong, nonatomic) JSQMessagesDataDetector *dataDetector;
+
+/**
+ *  The renderer used to display text message cells asynchronously.
+ *
+ *  @discussion When this value is non-nil, the labels, bubble and text of each text message cell are drawn into
+ *  a bitmap on a background queue and cached. Cells display their bubble image as a placeholder until the bitmap is ready.
+ *  Rendering is scheduled in `collectionView:willDisplayCell:forItemAtIndexPath:`, after subclasses have customized
+ *  the cell in `collectionView:cellForItemAtIndexPath:`. If you override that method, you must call super.
+ *
+ *  The default value is `nil`, which displays cells synchronously. Pass `[JSQMessagesCellRenderer sharedRenderer]`
+ *  to enable asynchronous display.
+ */
+@property (strong, nonatomic) JSQMessagesCellRenderer *cellRenderer;
+
+/**
+ *  The prefetcher that warms cell sizes, bubble and avatar images, media views and link detection
+ *  for messages that are about to scroll on screen.
+ *
+ *  @discussion On iOS 10 and later, the view controller is the `prefetchDataSource` of its collection view and
+ *  forwards prefetch requests to this object. On all versions, it forwards `scrollViewDidScroll:` so that the
+ *  prefetcher can look ahead of the scroll direction. If you override `scrollViewDidScroll:`, you must call super.
+ *
+ *  The default value is a prefetcher for the view controller's collection view that uses its `dataDetector`.
+ *  Set to `nil` to disable prefetching.
+ */
+@property (strong, nonatomic) JSQMessagesPrefetcher *prefetcher;
+
+/**
+ *  The day sections of the messages displayed by the view controller.
+ *
+ *  @discussion When this property is set, the view controller displays one section per day, each with a
+ *  `JSQMessagesDayHeaderView` showing its day. It answers `numberOfSectionsInCollectionView:`,
+ *  `collectionView:numberOfItemsInSection:` and `collectionView:attributedTextForDayHeaderInSection:` from it,
+ *  so you should not override them. Use its `messageIndexForIndexPath:` method to find your messages from index paths, and
+ *  append new messages to the day sections as well. The typing indicator is displayed after the last section,
+ *  and in the first section, the "load earlier messages" header is displayed above the day header when it is shown.
+ *
+ *  The default value is `nil`, which displays all messages in a single section.
+ */
+@property (strong, nonatomic) JSQMessagesDaySections *daySections;
+
 #pragma mark - Class methods
 
+/**
+ *  Specifies whether the view controller loads its views from `nib`.
+ *
+ *  @return `YES` to load the view controller, its input toolbar and its message cells from nibs laid out
+ *  with Auto Layout. `NO` to build them in code and lay out the toolbar content and cells by frame.
+ *
+ *  @discussion The default implementation returns `YES`, so subclasses that customize `nib` keep working.
+ *  Override this method to return `NO` to avoid decoding nibs for the view controller and for each new cell.
+ */
++ (BOOL)loadsViewsFromNib;
+
 /**
  *  Returns the `UINib` object initialized for a `JSQMessagesViewController`.
  *
@@ -181,8 +254,8 @@
  *  or the nib file could not be located.
  *
  *  @discussion You may override this method to provide a customized nib. If you do,
- *  you should also override `messagesViewController` to return your
- *  view controller loaded from your custom nib.
+ *  you should also override `loadsViewsFromNib` to return `YES`, and override `messagesViewController`
+ *  to return your view controller loaded from your custom nib.
  */
 + (UINib *)nib;
 
@@ -268,4 +341,14 @@
  */
 - (void)scrollToBottomAnimated:(BOOL)animated;
 
+/**
+ *  Scrolls the collection view such that the day section of the given date is at the top.
+ *  If there are no messages that day, scrolls to the next day with messages.
+ *  This is a no-op if `daySections` is `nil`.
+ *
+ *  @param date     The date to scroll to. This value must not be `nil`.
+ *  @param animated Pass `YES` if you want to animate scrolling, `NO` if it should be immediate.
+ */
+- (void)scrollToDate:(NSDate *)date animated:(BOOL)animated;
+
 @end
@@ -29,16 +29,24 @@
 
 #import "JSQMessagesTypingIndicatorFooterView.h"
 #import "JSQMessagesLoadEarlierHeaderView.h"
+#import "JSQMessagesDayHeaderView.h"
 
 #import "JSQMessagesToolbarContentView.h"
 #import "JSQMessagesInputToolbar.h"
 #import "JSQMessagesComposerTextView.h"
 
 #import "JSQMessagesTimestampFormatter.h"
+#import "JSQMessagesDataDetector.h"
+#import "JSQMessagesCellRenderer.h"
+#import "JSQMessagesPrefetcher.h"
+#import "JSQMessagesAvatarRenderer.h"
+#import "JSQMessagesDaySections.h"
+#import "JSQMessagesSenderTable.h"
 
 #import "NSString+JSQMessages.h"
 #import "UIColor+JSQMessages.h"
 #import "UIDevice+JSQMessages.h"
+#import "UIView+JSQMessages.h"
 #import "NSBundle+JSQMessages.h"
 
 
@@ -47,7 +55,11 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 
 @interface JSQMessagesViewController () <JSQMessagesInputToolbarDelegate,
-                                         JSQMessagesKeyboardControllerDelegate>
+                                         JSQMessagesKeyboardControllerDelegate
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+                                         , UICollectionViewDataSourcePrefetching
+#endif
+                                         >
 
 @property (weak, nonatomic) IBOutlet JSQMessagesCollectionView *collectionView;
 @property (weak, nonatomic) IBOutlet JSQMessagesInputToolbar *inputToolbar;
@@ -65,13 +77,18 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 @property (assign, nonatomic) BOOL textViewWasFirstResponderDuringInteractivePop;
 
+@property (strong, nonatomic) NSMapTable *renderRequestsForCells;
+
 - (void)jsq_configureMessagesViewController;
 
+- (void)jsq_loadViews;
+
 - (NSString *)jsq_currentlyComposedMessageText;
 
 - (void)jsq_handleDidChangeStatusBarFrameNotification:(NSNotification *)notification;
 - (void)jsq_didReceiveMenuWillShowNotification:(NSNotification *)notification;
 - (void)jsq_didReceiveMenuWillHideNotification:(NSNotification *)notification;
+- (void)jsq_didReceiveAvatarRendererDidRenderAvatarNotification:(NSNotification *)notification;
 
 - (void)jsq_updateKeyboardTriggerPoint;
 - (void)jsq_setToolbarBottomLayoutGuideConstant:(CGFloat)constant;
@@ -88,6 +105,15 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 - (BOOL)jsq_isMenuVisible;
 
+- (void)jsq_applyDetectedLinksForMessageData:(id<JSQMessageData>)messageData
+                                      toCell:(JSQMessagesCollectionViewCell *)cell
+                                 atIndexPath:(NSIndexPath *)indexPath;
+
+- (id<JSQMessageAvatarImageDataSource>)jsq_applyAvatarImageDataToCell:(JSQMessagesCollectionViewCell *)cell
+                                                          atIndexPath:(NSIndexPath *)indexPath
+                                                    isOutgoingMessage:(BOOL)isOutgoingMessage;
+- (void)jsq_reloadVisibleAvatarImages;
+
 - (void)jsq_addObservers;
 - (void)jsq_removeObservers;
 
@@ -109,8 +135,17 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
                           bundle:[NSBundle bundleForClass:[JSQMessagesViewController class]]];
 }
 
++ (BOOL)loadsViewsFromNib
+{
+    return YES;
+}
+
 + (instancetype)messagesViewController
 {
+    if (![self loadsViewsFromNib]) {
+        return [[[self class] alloc] initWithNibName:nil bundle:nil];
+    }
+
     return [[[self class] alloc] initWithNibName:NSStringFromClass([JSQMessagesViewController class])
                                           bundle:[NSBundle bundleForClass:[JSQMessagesViewController class]]];
 }
@@ -149,6 +184,19 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
     self.topContentAdditionalInset = 0.0f;
 
+    self.dataDetector = [JSQMessagesDataDetector sharedDetector];
+
+    self.renderRequestsForCells = [NSMapTable weakToStrongObjectsMapTable];
+
+    self.prefetcher = [[JSQMessagesPrefetcher alloc] initWithCollectionView:self.collectionView];
+    self.prefetcher.dataDetector = self.dataDetector;
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+    if ([self.collectionView respondsToSelector:@selector(setPrefetchDataSource:)]) {
+        self.collectionView.prefetchDataSource = self;
+    }
+#endif
+
     [self jsq_updateCollectionViewInsets];
 
     // Don't set keyboardController if client creates custom content view via -loadToolbarContentView
@@ -160,6 +208,56 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     }
 }
 
+- (void)jsq_loadViews
+{
+    //  mirrors the view hierarchy and constraints of the nib
+    UIView *view = [[UIView alloc] initWithFrame:[UIScreen mainScreen].bounds];
+    view.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    view.backgroundColor = [UIColor whiteColor];
+
+    JSQMessagesCollectionView *collectionView = [[JSQMessagesCollectionView alloc] initWithFrame:view.bounds
+                                                                            collectionViewLayout:[JSQMessagesCollectionViewFlowLayout new]];
+
+    CGFloat toolbarHeight = 44.0f;
+    JSQMessagesInputToolbar *inputToolbar = [[JSQMessagesInputToolbar alloc] initWithFrame:CGRectMake(0.0f,
+                                                                                                      CGRectGetHeight(view.bounds) - toolbarHeight,
+                                                                                                      CGRectGetWidth(view.bounds),
+                                                                                                      toolbarHeight)];
+    [inputToolbar setTranslatesAutoresizingMaskIntoConstraints:NO];
+
+    [view addSubview:collectionView];
+    [view addSubview:inputToolbar];
+
+    [view jsq_pinAllEdgesOfSubview:collectionView];
+    [view jsq_pinSubview:inputToolbar toEdge:NSLayoutAttributeLeading];
+    [view jsq_pinSubview:inputToolbar toEdge:NSLayoutAttributeTrailing];
+
+    //  the keyboard and composer code drive these two constants
+    NSLayoutConstraint *toolbarBottomLayoutGuide = [NSLayoutConstraint constraintWithItem:view
+                                                                                attribute:NSLayoutAttributeBottom
+                                                                                relatedBy:NSLayoutRelationEqual
+                                                                                   toItem:inputToolbar
+                                                                                attribute:NSLayoutAttributeBottom
+                                                                               multiplier:1.0f
+                                                                                 constant:0.0f];
+    [view addConstraint:toolbarBottomLayoutGuide];
+
+    NSLayoutConstraint *toolbarHeightConstraint = [NSLayoutConstraint constraintWithItem:inputToolbar
+                                                                               attribute:NSLayoutAttributeHeight
+                                                                               relatedBy:NSLayoutRelationEqual
+                                                                                  toItem:nil
+                                                                               attribute:NSLayoutAttributeNotAnAttribute
+                                                                              multiplier:1.0f
+                                                                                constant:toolbarHeight];
+    [inputToolbar addConstraint:toolbarHeightConstraint];
+
+    self.view = view;
+    self.collectionView = collectionView;
+    self.inputToolbar = inputToolbar;
+    self.toolbarBottomLayoutGuide = toolbarBottomLayoutGuide;
+    self.toolbarHeightConstraint = toolbarHeightConstraint;
+}
+
 - (void)dealloc
 {
     [self jsq_registerForNotifications:NO];
@@ -167,8 +265,16 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
     _collectionView.dataSource = nil;
     _collectionView.delegate = nil;
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+    if ([_collectionView respondsToSelector:@selector(setPrefetchDataSource:)]) {
+        _collectionView.prefetchDataSource = nil;
+    }
+#endif
     _collectionView = nil;
 
+    [_prefetcher cancelAllPrefetching];
+    _prefetcher = nil;
+
     _inputToolbar.contentView.textView.delegate = nil;
     _inputToolbar.delegate = nil;
     _inputToolbar = nil;
@@ -187,6 +293,18 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 #pragma mark - Setters
 
+- (void)setSenderId:(NSString *)senderId
+{
+    _senderId = [senderId copy];
+    _senderOrdinal = (senderId != nil) ? [[JSQMessagesSenderTable sharedTable] ordinalForSenderId:senderId] : JSQMessagesSenderOrdinalNone;
+}
+
+- (void)setDataDetector:(JSQMessagesDataDetector *)dataDetector
+{
+    _dataDetector = dataDetector;
+    self.prefetcher.dataDetector = dataDetector;
+}
+
 - (void)setShowTypingIndicator:(BOOL)showTypingIndicator
 {
     if (_showTypingIndicator == showTypingIndicator) {
@@ -198,6 +316,13 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     [self.collectionView.collectionViewLayout invalidateLayout];
 }
 
+- (void)setDaySections:(JSQMessagesDaySections *)daySections
+{
+    _daySections = daySections;
+    [self.collectionView.collectionViewLayout invalidateLayoutWithContext:[JSQMessagesCollectionViewFlowLayoutInvalidationContext context]];
+    [self.collectionView reloadData];
+}
+
 - (void)setShowLoadEarlierMessagesHeader:(BOOL)showLoadEarlierMessagesHeader
 {
     if (_showLoadEarlierMessagesHeader == showLoadEarlierMessagesHeader) {
@@ -218,11 +343,23 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 #pragma mark - View lifecycle
 
+- (void)loadView
+{
+    if ([[self class] loadsViewsFromNib]) {
+        [super loadView];
+        return;
+    }
+
+    [self jsq_loadViews];
+}
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
 
-    [[[self class] nib] instantiateWithOwner:self options:nil];
+    if ([[self class] loadsViewsFromNib]) {
+        [[[self class] nib] instantiateWithOwner:self options:nil];
+    }
 
     [self jsq_configureMessagesViewController];
     [self jsq_registerForNotifications:YES];
@@ -341,6 +478,7 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
     [[NSNotificationCenter defaultCenter] postNotificationName:UITextViewTextDidChangeNotification object:textView];
 
+    [self.prefetcher cancelAllPrefetching];
     [self.collectionView.collectionViewLayout invalidateLayoutWithContext:[JSQMessagesCollectionViewFlowLayoutInvalidationContext context]];
     [self.collectionView reloadData];
 
@@ -358,6 +496,7 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
     self.showTypingIndicator = NO;
 
+    [self.prefetcher cancelAllPrefetching];
     [self.collectionView.collectionViewLayout invalidateLayoutWithContext:[JSQMessagesCollectionViewFlowLayoutInvalidationContext context]];
     [self.collectionView reloadData];
 
@@ -368,11 +507,13 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 - (void)scrollToBottomAnimated:(BOOL)animated
 {
-    if ([self.collectionView numberOfSections] == 0) {
+    NSInteger finalSection = [self.collectionView numberOfSections] - 1;
+
+    if (finalSection < 0) {
         return;
     }
 
-    NSInteger items = [self.collectionView numberOfItemsInSection:0];
+    NSInteger items = [self.collectionView numberOfItemsInSection:finalSection];
 
     if (items == 0) {
         return;
@@ -393,8 +534,8 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     //  workaround for really long messages not scrolling
     //  if last message is too long, use scroll position bottom for better appearance, else use top
     //  possibly a UIKit bug, see #480 on GitHub
-    NSUInteger finalRow = MAX(0, [self.collectionView numberOfItemsInSection:0] - 1);
-    NSIndexPath *finalIndexPath = [NSIndexPath indexPathForItem:finalRow inSection:0];
+    NSUInteger finalRow = MAX(0, items - 1);
+    NSIndexPath *finalIndexPath = [NSIndexPath indexPathForItem:finalRow inSection:finalSection];
     CGSize finalCellSize = [self.collectionView.collectionViewLayout sizeForItemAtIndexPath:finalIndexPath];
 
     CGFloat maxHeightForVisibleMessage = CGRectGetHeight(self.collectionView.bounds) - self.collectionView.contentInset.top - CGRectGetHeight(self.inputToolbar.bounds);
@@ -406,6 +547,32 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
                                         animated:animated];
 }
 
+- (void)scrollToDate:(NSDate *)date animated:(BOOL)animated
+{
+    NSParameterAssert(date != nil);
+
+    NSInteger section = [self.daySections sectionForDate:date];
+    if (section == NSNotFound || section >= [self.collectionView numberOfSections]) {
+        return;
+    }
+
+    //  bring the day header to the top, not only the first message of the day
+    NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
+    UICollectionViewLayoutAttributes *headerAttributes = [self.collectionView.collectionViewLayout layoutAttributesForSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                                                                                                                   atIndexPath:indexPath];
+    CGFloat sectionTop = CGRectGetMinY(headerAttributes.frame);
+    if (headerAttributes == nil || CGRectIsEmpty(headerAttributes.frame)) {
+        sectionTop = CGRectGetMinY([self.collectionView.collectionViewLayout layoutAttributesForItemAtIndexPath:indexPath].frame);
+    }
+
+    CGFloat contentHeight = [self.collectionView.collectionViewLayout collectionViewContentSize].height;
+    CGFloat maxOffsetY = MAX(-self.collectionView.contentInset.top,
+                             contentHeight + self.collectionView.contentInset.bottom - CGRectGetHeight(self.collectionView.bounds));
+    CGFloat offsetY = MIN(sectionTop - self.collectionView.contentInset.top, maxOffsetY);
+
+    [self.collectionView setContentOffset:CGPointMake(self.collectionView.contentOffset.x, offsetY) animated:animated];
+}
+
 #pragma mark - JSQMessages collection view data source
 
 - (id<JSQMessageData>)collectionView:(JSQMessagesCollectionView *)collectionView messageDataForItemAtIndexPath:(NSIndexPath *)indexPath
@@ -446,16 +613,22 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     return nil;
 }
 
+- (NSAttributedString *)collectionView:(JSQMessagesCollectionView *)collectionView attributedTextForDayHeaderInSection:(NSInteger)section
+{
+    return [self.daySections attributedHeaderTextForSection:section];
+}
+
 #pragma mark - Collection view data source
 
 - (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section
 {
-    return 0;
+    return [self.daySections numberOfItemsInSection:section];
 }
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView
 {
-    return 1;
+    //  keep a section when there are no messages, for the typing indicator and the load earlier header
+    return MAX(1, self.daySections.numberOfSections);
 }
 
 - (UICollectionViewCell *)collectionView:(JSQMessagesCollectionView *)collectionView cellForItemAtIndexPath:(NSIndexPath *)indexPath
@@ -463,10 +636,9 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     id<JSQMessageData> messageItem = [collectionView.dataSource collectionView:collectionView messageDataForItemAtIndexPath:indexPath];
     NSParameterAssert(messageItem != nil);
 
-    NSString *messageSenderId = [messageItem senderId];
-    NSParameterAssert(messageSenderId != nil);
+    NSParameterAssert([messageItem senderId] != nil);
 
-    BOOL isOutgoingMessage = [messageSenderId isEqualToString:self.senderId];
+    BOOL isOutgoingMessage = [JSQMessagesSenderTable isOutgoingMessageData:messageItem forDataSource:self];
     BOOL isMediaMessage = [messageItem isMediaMessage];
 
     NSString *cellIdentifier = nil;
@@ -495,6 +667,8 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
         id<JSQMessageBubbleImageDataSource> bubbleImageDataSource = [collectionView.dataSource collectionView:collectionView messageBubbleImageDataForItemAtIndexPath:indexPath];
         cell.messageBubbleImageView.image = [bubbleImageDataSource messageBubbleImage];
         cell.messageBubbleImageView.highlightedImage = [bubbleImageDataSource messageBubbleHighlightedImage];
+
+        [self jsq_applyDetectedLinksForMessageData:messageItem toCell:cell atIndexPath:indexPath];
     }
     else {
         id<JSQMessageMediaData> messageMedia = [messageItem media];
@@ -502,30 +676,9 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
         NSParameterAssert(cell.mediaView != nil);
     }
 
-    BOOL needsAvatar = YES;
-    if (isOutgoingMessage && CGSizeEqualToSize(collectionView.collectionViewLayout.outgoingAvatarViewSize, CGSizeZero)) {
-        needsAvatar = NO;
-    }
-    else if (!isOutgoingMessage && CGSizeEqualToSize(collectionView.collectionViewLayout.incomingAvatarViewSize, CGSizeZero)) {
-        needsAvatar = NO;
-    }
-
-    id<JSQMessageAvatarImageDataSource> avatarImageDataSource = nil;
-    if (needsAvatar) {
-        avatarImageDataSource = [collectionView.dataSource collectionView:collectionView avatarImageDataForItemAtIndexPath:indexPath];
-        if (avatarImageDataSource != nil) {
-
-            UIImage *avatarImage = [avatarImageDataSource avatarImage];
-            if (avatarImage == nil) {
-                cell.avatarImageView.image = [avatarImageDataSource avatarPlaceholderImage];
-                cell.avatarImageView.highlightedImage = nil;
-            }
-            else {
-                cell.avatarImageView.image = avatarImage;
-                cell.avatarImageView.highlightedImage = [avatarImageDataSource avatarHighlightedImage];
-            }
-        }
-    }
+    id<JSQMessageAvatarImageDataSource> avatarImageDataSource = [self jsq_applyAvatarImageDataToCell:cell
+                                                                                         atIndexPath:indexPath
+                                                                                   isOutgoingMessage:isOutgoingMessage];
 
     cell.cellTopLabel.attributedText = [collectionView.dataSource collectionView:collectionView attributedTextForCellTopLabelAtIndexPath:indexPath];
     cell.messageBubbleTopLabel.attributedText = [collectionView.dataSource collectionView:collectionView attributedTextForMessageBubbleTopLabelAtIndexPath:indexPath];
@@ -540,11 +693,10 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
         cell.messageBubbleTopLabel.textInsets = UIEdgeInsetsMake(0.0f, bubbleTopLabelInset, 0.0f, 0.0f);
     }
 
-    cell.textView.dataDetectorTypes = UIDataDetectorTypeAll;
-
     cell.backgroundColor = [UIColor clearColor];
-    cell.layer.rasterizationScale = [UIScreen mainScreen].scale;
-    cell.layer.shouldRasterize = YES;
+
+    //  the bitmap itself is requested in `collectionView:willDisplayCell:forItemAtIndexPath:`
+    cell.displaysRenderedContent = (self.cellRenderer != nil && !isMediaMessage);
 
     return cell;
 }
@@ -556,8 +708,20 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     if (self.showTypingIndicator && [kind isEqualToString:UICollectionElementKindSectionFooter]) {
         return [collectionView dequeueTypingIndicatorFooterViewForIndexPath:indexPath];
     }
-    else if (self.showLoadEarlierMessagesHeader && [kind isEqualToString:UICollectionElementKindSectionHeader]) {
-        return [collectionView dequeueLoadEarlierMessagesViewHeaderForIndexPath:indexPath];
+    else if ([kind isEqualToString:UICollectionElementKindSectionHeader]) {
+        NSAttributedString *dayText = [self collectionView:collectionView attributedTextForDayHeaderInSection:indexPath.section];
+        BOOL showsLoadEarlierMessages = (self.showLoadEarlierMessagesHeader && indexPath.section == 0);
+        
+        if (dayText == nil && showsLoadEarlierMessages) {
+            return [collectionView dequeueLoadEarlierMessagesViewHeaderForIndexPath:indexPath];
+        }
+        
+        //  the first day keeps its header, the load earlier button is displayed above it
+        JSQMessagesDayHeaderView *headerView = showsLoadEarlierMessages
+                                                ? [collectionView dequeueDayHeaderViewWithLoadEarlierMessagesViewForIndexPath:indexPath]
+                                                : [collectionView dequeueDayHeaderViewForIndexPath:indexPath];
+        headerView.textLabel.attributedText = dayText;
+        return headerView;
     }
 
     return nil;
@@ -566,7 +730,7 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 - (CGSize)collectionView:(UICollectionView *)collectionView
                   layout:(JSQMessagesCollectionViewFlowLayout *)collectionViewLayout referenceSizeForFooterInSection:(NSInteger)section
 {
-    if (!self.showTypingIndicator) {
+    if (!self.showTypingIndicator || section != [collectionView numberOfSections] - 1) {
         return CGSizeZero;
     }
 
@@ -576,15 +740,113 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 - (CGSize)collectionView:(UICollectionView *)collectionView
                   layout:(JSQMessagesCollectionViewFlowLayout *)collectionViewLayout referenceSizeForHeaderInSection:(NSInteger)section
 {
-    if (!self.showLoadEarlierMessagesHeader) {
+    CGFloat height = 0.0f;
+
+    if (self.showLoadEarlierMessagesHeader && section == 0) {
+        height += kJSQMessagesLoadEarlierHeaderViewHeight;
+    }
+
+    if ([self collectionView:(JSQMessagesCollectionView *)collectionView attributedTextForDayHeaderInSection:section] != nil) {
+        height += kJSQMessagesDayHeaderViewHeight;
+    }
+
+    if (height == 0.0f) {
         return CGSizeZero;
     }
 
-    return CGSizeMake([collectionViewLayout itemWidth], kJSQMessagesLoadEarlierHeaderViewHeight);
+    return CGSizeMake([collectionViewLayout itemWidth], height);
+}
+
+#if __IPHONE_OS_VERSION_MAX_ALLOWED >= 100000
+
+#pragma mark - Collection view data source prefetching
+
+- (void)collectionView:(UICollectionView *)collectionView prefetchItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    [self.prefetcher prefetchItemsAtIndexPaths:indexPaths];
+}
+
+- (void)collectionView:(UICollectionView *)collectionView cancelPrefetchingForItemsAtIndexPaths:(NSArray *)indexPaths
+{
+    [self.prefetcher cancelPrefetchingForItemsAtIndexPaths:indexPaths];
+}
+
+#endif
+
+#pragma mark - Scroll view delegate
+
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView
+{
+    [self.prefetcher scrollViewDidScroll:scrollView];
 }
 
 #pragma mark - Collection view delegate
 
+- (void)collectionView:(JSQMessagesCollectionView *)collectionView
+       willDisplayCell:(UICollectionViewCell *)cell
+    forItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (![cell isKindOfClass:[JSQMessagesCollectionViewCell class]]) {
+        return;
+    }
+
+    JSQMessagesCollectionViewCell *messagesCell = (JSQMessagesCollectionViewCell *)cell;
+    if (!messagesCell.displaysRenderedContent || self.cellRenderer == nil) {
+        return;
+    }
+
+    JSQMessagesCellRenderDescriptor *descriptor = [JSQMessagesCellRenderDescriptor descriptorWithCell:messagesCell];
+    if (descriptor == nil) {
+        messagesCell.displaysRenderedContent = NO;
+        return;
+    }
+
+    UIImage *cachedImage = [self.cellRenderer cachedImageForDescriptor:descriptor];
+    if (cachedImage != nil) {
+        messagesCell.renderedContentImage = cachedImage;
+        return;
+    }
+
+    __weak JSQMessagesCollectionViewCell *weakCell = messagesCell;
+    __weak JSQMessagesViewController *weakSelf = self;
+
+    JSQMessagesLoadRequest *request = [self.cellRenderer renderImageForDescriptor:descriptor completion:^(UIImage *image) {
+        //  the cell may have been reused for another message in the meantime
+        JSQMessagesLoadRequest *pendingRequest = [weakSelf.renderRequestsForCells objectForKey:weakCell];
+        if (![pendingRequest.key isEqual:descriptor]) {
+            return;
+        }
+
+        [weakSelf.renderRequestsForCells removeObjectForKey:weakCell];
+
+        if (image == nil) {
+            //  nothing could be rendered, show the live views instead
+            weakCell.displaysRenderedContent = NO;
+            return;
+        }
+
+        weakCell.renderedContentImage = image;
+    }];
+
+    if (request != nil) {
+        [self.renderRequestsForCells setObject:request forKey:messagesCell];
+    }
+}
+
+- (void)collectionView:(JSQMessagesCollectionView *)collectionView
+  didEndDisplayingCell:(UICollectionViewCell *)cell
+    forItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    JSQMessagesLoadRequest *request = [self.renderRequestsForCells objectForKey:cell];
+    if (request == nil) {
+        return;
+    }
+
+    //  only this cell stops waiting, other cells may be waiting on an equal descriptor
+    [self.renderRequestsForCells removeObjectForKey:cell];
+    [self.cellRenderer cancelRenderRequest:request];
+}
+
 - (BOOL)collectionView:(JSQMessagesCollectionView *)collectionView shouldShowMenuForItemAtIndexPath:(NSIndexPath *)indexPath
 {
     //  disable menu for media messages
@@ -783,6 +1045,13 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     self.selectedIndexPathForMenu = nil;
 }
 
+- (void)jsq_didReceiveAvatarRendererDidRenderAvatarNotification:(NSNotification *)notification
+{
+    //  renders tend to finish in bursts, refresh the visible cells once per run loop pass
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(jsq_reloadVisibleAvatarImages) object:nil];
+    [self performSelector:@selector(jsq_reloadVisibleAvatarImages) withObject:nil afterDelay:0.0];
+}
+
 #pragma mark - Key-value observing
 
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
@@ -797,6 +1066,11 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
             CGFloat dy = newContentSize.height - oldContentSize.height;
 
+            //  the content height only changes with the number of lines, most keystrokes stop here
+            if (dy == 0.0f) {
+                return;
+            }
+
             [self jsq_adjustInputToolbarForComposerTextViewContentSizeChange:dy];
             [self jsq_updateCollectionViewInsets];
             if (self.automaticallyScrollsToMostRecentMessage) {
@@ -823,6 +1097,10 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 
 - (void)jsq_setToolbarBottomLayoutGuideConstant:(CGFloat)constant
 {
+    if (self.toolbarBottomLayoutGuide.constant == constant) {
+        return;
+    }
+
     self.toolbarBottomLayoutGuide.constant = constant;
     [self.view setNeedsUpdateConstraints];
     [self.view layoutIfNeeded];
@@ -967,6 +1245,13 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
 - (void)jsq_setCollectionViewInsetsTopValue:(CGFloat)top bottomValue:(CGFloat)bottom
 {
     UIEdgeInsets insets = UIEdgeInsetsMake(top, 0.0f, bottom, 0.0f);
+
+    //  insets do not affect the messages layout, skip redundant updates that would still trigger a layout pass
+    if (UIEdgeInsetsEqualToEdgeInsets(self.collectionView.contentInset, insets)
+        && UIEdgeInsetsEqualToEdgeInsets(self.collectionView.scrollIndicatorInsets, insets)) {
+        return;
+    }
+
     self.collectionView.contentInset = insets;
     self.collectionView.scrollIndicatorInsets = insets;
 }
@@ -978,6 +1263,72 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
     return self.selectedIndexPathForMenu != nil && [[UIMenuController sharedMenuController] isMenuVisible];
 }
 
+- (void)jsq_applyDetectedLinksForMessageData:(id<JSQMessageData>)messageData
+                                      toCell:(JSQMessagesCollectionViewCell *)cell
+                                 atIndexPath:(NSIndexPath *)indexPath
+{
+    if (self.dataDetector == nil) {
+        return;
+    }
+
+    NSAttributedString *links = [self.dataDetector cachedLinksForMessageData:messageData];
+    if (links != nil) {
+        [cell.textView jsq_applyDetectedLinks:links];
+        return;
+    }
+
+    //  detection finishes asynchronously, by then the cell may have been reused for another message
+    __weak JSQMessagesCollectionView *weakCollectionView = self.collectionView;
+    __weak JSQMessagesCollectionViewCell *weakCell = cell;
+
+    [self.dataDetector detectLinksForMessageData:messageData completion:^(NSAttributedString *detectedLinks) {
+        if ([[weakCollectionView indexPathForCell:weakCell] isEqual:indexPath]) {
+            [weakCell.textView jsq_applyDetectedLinks:detectedLinks];
+        }
+    }];
+}
+
+- (id<JSQMessageAvatarImageDataSource>)jsq_applyAvatarImageDataToCell:(JSQMessagesCollectionViewCell *)cell
+                                                          atIndexPath:(NSIndexPath *)indexPath
+                                                    isOutgoingMessage:(BOOL)isOutgoingMessage
+{
+    JSQMessagesCollectionViewFlowLayout *collectionViewLayout = self.collectionView.collectionViewLayout;
+
+    if (isOutgoingMessage && CGSizeEqualToSize(collectionViewLayout.outgoingAvatarViewSize, CGSizeZero)) {
+        return nil;
+    }
+    else if (!isOutgoingMessage && CGSizeEqualToSize(collectionViewLayout.incomingAvatarViewSize, CGSizeZero)) {
+        return nil;
+    }
+
+    id<JSQMessageAvatarImageDataSource> avatarImageDataSource = [self.collectionView.dataSource collectionView:self.collectionView
+                                                                             avatarImageDataForItemAtIndexPath:indexPath];
+    if (avatarImageDataSource == nil) {
+        return nil;
+    }
+
+    UIImage *avatarImage = [avatarImageDataSource avatarImage];
+    if (avatarImage == nil) {
+        cell.avatarImageView.image = [avatarImageDataSource avatarPlaceholderImage];
+        cell.avatarImageView.highlightedImage = nil;
+    }
+    else {
+        cell.avatarImageView.image = avatarImage;
+        cell.avatarImageView.highlightedImage = [avatarImageDataSource avatarHighlightedImage];
+    }
+
+    return avatarImageDataSource;
+}
+
+- (void)jsq_reloadVisibleAvatarImages
+{
+    for (NSIndexPath *indexPath in [self.collectionView indexPathsForVisibleItems]) {
+        JSQMessagesCollectionViewCell *cell = (JSQMessagesCollectionViewCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+        BOOL isOutgoingMessage = [cell isKindOfClass:[JSQMessagesCollectionViewCellOutgoing class]];
+        [self jsq_applyAvatarImageDataToCell:cell atIndexPath:indexPath isOutgoingMessage:isOutgoingMessage];
+    }
+}
+
 #pragma mark - Utilities
 
 - (void)jsq_addObservers
@@ -1027,6 +1378,11 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
                                                  selector:@selector(jsq_didReceiveMenuWillHideNotification:)
                                                      name:UIMenuControllerWillHideMenuNotification
                                                    object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(jsq_didReceiveAvatarRendererDidRenderAvatarNotification:)
+                                                     name:JSQMessagesAvatarRendererDidRenderAvatarNotification
+                                                   object:nil];
     }
     else {
         [[NSNotificationCenter defaultCenter] removeObserver:self
@@ -1040,6 +1396,12 @@ static void * kJSQMessagesKeyValueObservingContext = &kJSQMessagesKeyValueObserv
         [[NSNotificationCenter defaultCenter] removeObserver:self
                                                         name:UIMenuControllerWillHideMenuNotification
                                                       object:nil];
+
+        [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                        name:JSQMessagesAvatarRendererDidRenderAvatarNotification
+                                                      object:nil];
+
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(jsq_reloadVisibleAvatarImages) object:nil];
     }
 }
 
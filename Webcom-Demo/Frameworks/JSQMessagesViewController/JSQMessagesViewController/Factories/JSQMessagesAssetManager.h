@@ -0,0 +1,75 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ *  A `JSQMessagesAssetManager` object loads the images of the JSQMessagesViewController asset bundle
+ *  and caches them, fully decoded, so that repeated lookups never touch the disk or decode a PNG.
+ *
+ *  @discussion The image accessors of the `UIImage (JSQMessages)` category are backed by the shared asset manager.
+ *  Call `preloadStandardImagesWithCompletion:` early, for example in `application:didFinishLaunchingWithOptions:`,
+ *  to load the bubbles and icons on a background queue before the first messages view controller needs them.
+ */
+@interface JSQMessagesAssetManager : NSObject
+
+/**
+ *  The asset bundle of JSQMessagesViewController, resolved once.
+ */
+@property (strong, nonatomic, readonly) NSBundle *assetBundle;
+
+/**
+ *  Returns the shared asset manager object.
+ *
+ *  @return The shared asset manager object.
+ */
++ (JSQMessagesAssetManager *)sharedManager;
+
+/**
+ *  Returns the names of the images used by JSQMessagesViewController out of the box,
+ *  such as the message bubbles, the accessory, typing indicator and play icons.
+ *
+ *  @return An array of image names, without the file extension.
+ */
++ (NSArray *)standardImageNames;
+
+/**
+ *  Returns the decoded image with the given name from the `Images` directory of the asset bundle.
+ *  This method can be called from any thread.
+ *
+ *  @param name The name of a PNG image in the asset bundle, without the file extension. This value must not be `nil`.
+ *
+ *  @return The decoded image, or `nil` if the asset bundle has no such image.
+ */
+- (UIImage *)imageNamed:(NSString *)name;
+
+/**
+ *  Loads and decodes the images named by `standardImageNames` on a background queue.
+ *
+ *  @param completion A block called on the main queue once all the images are cached. May be `nil`.
+ */
+- (void)preloadStandardImagesWithCompletion:(void (^)(void))completion;
+
+/**
+ *  Removes all cached images. They are loaded again on demand.
+ */
+- (void)removeAllCachedImages;
+
+@end
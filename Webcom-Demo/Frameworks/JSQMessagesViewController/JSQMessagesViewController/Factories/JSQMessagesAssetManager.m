@@ -0,0 +1,199 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesAssetManager.h"
+
+#import "JSQMessagesCostTrackingCache.h"
+#import "JSQMessagesMemoryCoordinator.h"
+
+#import "NSBundle+JSQMessages.h"
+
+
+@interface JSQMessagesAssetManager () <JSQMessagesPurgeableCache>
+
+@property (strong, nonatomic, readonly) JSQMessagesCostTrackingCache *cache;
+
++ (UIImage *)jsq_decodedImageFromImage:(UIImage *)image;
+
+@end
+
+
+
+@implementation JSQMessagesAssetManager
+
+#pragma mark - Initialization
+
++ (JSQMessagesAssetManager *)sharedManager
+{
+    static JSQMessagesAssetManager *_sharedManager = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedManager = [[JSQMessagesAssetManager alloc] init];
+    });
+    
+    return _sharedManager;
+}
+
++ (NSArray *)standardImageNames
+{
+    return @[ @"bubble_regular",
+              @"bubble_tailless",
+              @"bubble_stroked",
+              @"bubble_stroked_tailless",
+              @"bubble_min",
+              @"bubble_min_tailless",
+              @"clip",
+              @"typing",
+              @"play" ];
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _assetBundle = [NSBundle jsq_messagesAssetBundle];
+        
+        _cache = [JSQMessagesCostTrackingCache new];
+        _cache.name = @"JSQMessagesAssetManager.cache";
+        
+        [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _assetBundle = nil;
+    _cache = nil;
+}
+
+#pragma mark - Purgeable cache
+
+- (NSString *)cacheName
+{
+    return self.cache.name;
+}
+
+- (NSUInteger)cacheByteCost
+{
+    return self.cache.totalCost;
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    //  images are decoded again from the asset bundle
+    return JSQMessagesCacheRebuildCostLow;
+}
+
+- (void)purgeCache
+{
+    [self removeAllCachedImages];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: assetBundle=%@>", [self class], self.assetBundle.bundlePath];
+}
+
+#pragma mark - Images
+
+- (UIImage *)imageNamed:(NSString *)name
+{
+    NSParameterAssert(name != nil);
+    
+    UIImage *image = [self.cache objectForKey:name];
+    if (image != nil) {
+        return image;
+    }
+    
+    //  two threads asking for the same image at once both decode it, the images are small enough not to bother
+    NSString *path = [self.assetBundle pathForResource:name ofType:@"png" inDirectory:@"Images"];
+    if (path == nil) {
+        return nil;
+    }
+    
+    image = [JSQMessagesAssetManager jsq_decodedImageFromImage:[UIImage imageWithContentsOfFile:path]];
+    if (image != nil) {
+        CGImageRef imageRef = image.CGImage;
+        [self.cache setObject:image forKey:name cost:CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef)];
+    }
+    
+    return image;
+}
+
+- (void)preloadStandardImagesWithCompletion:(void (^)(void))completion
+{
+    NSArray *names = [JSQMessagesAssetManager standardImageNames];
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        for (NSString *eachName in names) {
+            [self imageNamed:eachName];
+        }
+        
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), completion);
+        }
+    });
+}
+
+- (void)removeAllCachedImages
+{
+    [self.cache removeAllObjects];
+}
+
+#pragma mark - Utilities
+
++ (UIImage *)jsq_decodedImageFromImage:(UIImage *)image
+{
+    CGImageRef imageRef = image.CGImage;
+    if (imageRef == NULL) {
+        return image;
+    }
+    
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    
+    //  UIImage decodes lazily on first draw, drawing into a bitmap now keeps that work off the main thread
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    
+    if (context == NULL) {
+        return image;
+    }
+    
+    CGContextDrawImage(context, CGRectMake(0.0f, 0.0f, width, height), imageRef);
+    CGImageRef decodedImageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    
+    if (decodedImageRef == NULL) {
+        return image;
+    }
+    
+    UIImage *decodedImage = [UIImage imageWithCGImage:decodedImageRef scale:image.scale orientation:image.imageOrientation];
+    CGImageRelease(decodedImageRef);
+    
+    return decodedImage;
+}
+
+@end
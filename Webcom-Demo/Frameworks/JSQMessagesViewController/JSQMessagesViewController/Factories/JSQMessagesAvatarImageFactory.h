@@ -96,4 +96,42 @@
                                                    font:(UIFont *)font
                                                diameter:(NSUInteger)diameter;
 
+/**
+ *  Creates and returns a `JSQMessagesAvatarImage` object like `avatarImageWithImage:diameter:`,
+ *  rendering its images at the given scale.
+ *
+ *  @param image    An image object that represents an avatar image. This value must not be `nil`.
+ *  @param diameter An integer value specifying the diameter size of the avatar in points. This value must be greater than `0`.
+ *  @param scale    The scale of the rendered images. This value must be greater than `0.0`.
+ *
+ *  @return An initialized `JSQMessagesAvatarImage` object if created successfully, `nil` otherwise.
+ *
+ *  @discussion Unlike the methods above, this method does not read the scale of the main screen,
+ *  so it may be called from a background queue.
+ */
++ (JSQMessagesAvatarImage *)avatarImageWithImage:(UIImage *)image diameter:(NSUInteger)diameter scale:(CGFloat)scale;
+
+/**
+ *  Creates and returns a `JSQMessagesAvatarImage` object like `avatarImageWithUserInitials:backgroundColor:textColor:font:diameter:`,
+ *  rendering its images at the given scale.
+ *
+ *  @param userInitials    The user initials to display in the avatar image. This value must not be `nil`.
+ *  @param backgroundColor The background color of the avatar. This value must not be `nil`.
+ *  @param textColor       The color of the text of the userInitials. This value must not be `nil`.
+ *  @param font            The font applied to userInitials. This value must not be `nil`.
+ *  @param diameter        The diameter of the avatar image. This value must be greater than `0`.
+ *  @param scale           The scale of the rendered images. This value must be greater than `0.0`.
+ *
+ *  @return An initialized `JSQMessagesAvatarImage` object if created successfully, `nil` otherwise.
+ *
+ *  @discussion Unlike the methods above, this method does not read the scale of the main screen,
+ *  so it may be called from a background queue.
+ */
++ (JSQMessagesAvatarImage *)avatarImageWithUserInitials:(NSString *)userInitials
+                                        backgroundColor:(UIColor *)backgroundColor
+                                              textColor:(UIColor *)textColor
+                                                   font:(UIFont *)font
+                                               diameter:(NSUInteger)diameter
+                                                  scale:(CGFloat)scale;
+
 @end
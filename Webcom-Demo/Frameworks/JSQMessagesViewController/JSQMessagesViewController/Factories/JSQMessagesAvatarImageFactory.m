@@ -25,13 +25,17 @@
 
 + (UIImage *)jsq_circularImage:(UIImage *)image
                   withDiameter:(NSUInteger)diameter
-              highlightedColor:(UIColor *)highlightedColor;
+              highlightedColor:(UIColor *)highlightedColor
+                         scale:(CGFloat)scale;
 
 + (UIImage *)jsq_imageWitInitials:(NSString *)initials
                   backgroundColor:(UIColor *)backgroundColor
                         textColor:(UIColor *)textColor
                              font:(UIFont *)font
-                         diameter:(NSUInteger)diameter;
+                         diameter:(NSUInteger)diameter
+                            scale:(CGFloat)scale;
+
++ (UIColor *)jsq_highlightedOverlayColor;
 
 @end
 
@@ -45,15 +49,28 @@
 {
     UIImage *circlePlaceholderImage = [JSQMessagesAvatarImageFactory jsq_circularImage:placeholderImage
                                                                           withDiameter:diameter
-                                                                      highlightedColor:nil];
+                                                                      highlightedColor:nil
+                                                                                 scale:[UIScreen mainScreen].scale];
 
     return [JSQMessagesAvatarImage avatarImageWithPlaceholder:circlePlaceholderImage];
 }
 
 + (JSQMessagesAvatarImage *)avatarImageWithImage:(UIImage *)image diameter:(NSUInteger)diameter
 {
-    UIImage *avatar = [JSQMessagesAvatarImageFactory circularAvatarImage:image withDiameter:diameter];
-    UIImage *highlightedAvatar = [JSQMessagesAvatarImageFactory circularAvatarHighlightedImage:image withDiameter:diameter];
+    return [JSQMessagesAvatarImageFactory avatarImageWithImage:image diameter:diameter scale:[UIScreen mainScreen].scale];
+}
+
++ (JSQMessagesAvatarImage *)avatarImageWithImage:(UIImage *)image diameter:(NSUInteger)diameter scale:(CGFloat)scale
+{
+    UIImage *avatar = [JSQMessagesAvatarImageFactory jsq_circularImage:image
+                                                          withDiameter:diameter
+                                                      highlightedColor:nil
+                                                                 scale:scale];
+    
+    UIImage *highlightedAvatar = [JSQMessagesAvatarImageFactory jsq_circularImage:image
+                                                                     withDiameter:diameter
+                                                                 highlightedColor:[JSQMessagesAvatarImageFactory jsq_highlightedOverlayColor]
+                                                                            scale:scale];
 
     return [[JSQMessagesAvatarImage alloc] initWithAvatarImage:avatar
                                               highlightedImage:highlightedAvatar
@@ -64,14 +81,30 @@
 {
     return [JSQMessagesAvatarImageFactory jsq_circularImage:image
                                                withDiameter:diameter
-                                           highlightedColor:nil];
+                                           highlightedColor:nil
+                                                      scale:[UIScreen mainScreen].scale];
 }
 
 + (UIImage *)circularAvatarHighlightedImage:(UIImage *)image withDiameter:(NSUInteger)diameter
 {
     return [JSQMessagesAvatarImageFactory jsq_circularImage:image
                                                withDiameter:diameter
-                                           highlightedColor:[UIColor colorWithWhite:0.1f alpha:0.3f]];
+                                           highlightedColor:[JSQMessagesAvatarImageFactory jsq_highlightedOverlayColor]
+                                                      scale:[UIScreen mainScreen].scale];
+}
+
++ (JSQMessagesAvatarImage *)avatarImageWithUserInitials:(NSString *)userInitials
+                                        backgroundColor:(UIColor *)backgroundColor
+                                              textColor:(UIColor *)textColor
+                                                   font:(UIFont *)font
+                                               diameter:(NSUInteger)diameter
+{
+    return [JSQMessagesAvatarImageFactory avatarImageWithUserInitials:userInitials
+                                                      backgroundColor:backgroundColor
+                                                            textColor:textColor
+                                                                 font:font
+                                                             diameter:diameter
+                                                                scale:[UIScreen mainScreen].scale];
 }
 
 + (JSQMessagesAvatarImage *)avatarImageWithUserInitials:(NSString *)userInitials
@@ -79,16 +112,19 @@
                                               textColor:(UIColor *)textColor
                                                    font:(UIFont *)font
                                                diameter:(NSUInteger)diameter
+                                                  scale:(CGFloat)scale
 {
     UIImage *avatarImage = [JSQMessagesAvatarImageFactory jsq_imageWitInitials:userInitials
                                                                backgroundColor:backgroundColor
                                                                      textColor:textColor
                                                                           font:font
-                                                                      diameter:diameter];
+                                                                      diameter:diameter
+                                                                         scale:scale];
 
     UIImage *avatarHighlightedImage = [JSQMessagesAvatarImageFactory jsq_circularImage:avatarImage
                                                                           withDiameter:diameter
-                                                                      highlightedColor:[UIColor colorWithWhite:0.1f alpha:0.3f]];
+                                                                      highlightedColor:[JSQMessagesAvatarImageFactory jsq_highlightedOverlayColor]
+                                                                                 scale:scale];
 
     return [[JSQMessagesAvatarImage alloc] initWithAvatarImage:avatarImage
                                               highlightedImage:avatarHighlightedImage
@@ -97,17 +133,24 @@
 
 #pragma mark - Private
 
++ (UIColor *)jsq_highlightedOverlayColor
+{
+    return [UIColor colorWithWhite:0.1f alpha:0.3f];
+}
+
 + (UIImage *)jsq_imageWitInitials:(NSString *)initials
                   backgroundColor:(UIColor *)backgroundColor
                         textColor:(UIColor *)textColor
                              font:(UIFont *)font
                          diameter:(NSUInteger)diameter
+                            scale:(CGFloat)scale
 {
     NSParameterAssert(initials != nil);
     NSParameterAssert(backgroundColor != nil);
     NSParameterAssert(textColor != nil);
     NSParameterAssert(font != nil);
     NSParameterAssert(diameter > 0);
+    NSParameterAssert(scale > 0.0f);
 
     CGRect frame = CGRectMake(0.0f, 0.0f, diameter, diameter);
 
@@ -127,10 +170,14 @@
     CGPoint drawPoint = CGPointMake(dx, dy);
     UIImage *image = nil;
 
-    UIGraphicsBeginImageContextWithOptions(frame.size, NO, [UIScreen mainScreen].scale);
+    //  clip to the circle right away, rather than cropping the square image in a second pass
+    UIGraphicsBeginImageContextWithOptions(frame.size, NO, scale);
     {
         CGContextRef context = UIGraphicsGetCurrentContext();
 
+        CGContextAddEllipseInRect(context, frame);
+        CGContextClip(context);
+
         CGContextSetFillColorWithColor(context, backgroundColor.CGColor);
         CGContextFillRect(context, frame);
         [initials drawAtPoint:drawPoint withAttributes:attributes];
@@ -140,18 +187,22 @@
     }
     UIGraphicsEndImageContext();
 
-    return [JSQMessagesAvatarImageFactory jsq_circularImage:image withDiameter:diameter highlightedColor:nil];
+    return image;
 }
 
-+ (UIImage *)jsq_circularImage:(UIImage *)image withDiameter:(NSUInteger)diameter highlightedColor:(UIColor *)highlightedColor
++ (UIImage *)jsq_circularImage:(UIImage *)image
+                  withDiameter:(NSUInteger)diameter
+              highlightedColor:(UIColor *)highlightedColor
+                         scale:(CGFloat)scale
 {
     NSParameterAssert(image != nil);
     NSParameterAssert(diameter > 0);
+    NSParameterAssert(scale > 0.0f);
 
     CGRect frame = CGRectMake(0.0f, 0.0f, diameter, diameter);
     UIImage *newImage = nil;
 
-    UIGraphicsBeginImageContextWithOptions(frame.size, NO, [UIScreen mainScreen].scale);
+    UIGraphicsBeginImageContextWithOptions(frame.size, NO, scale);
     {
         CGContextRef context = UIGraphicsGetCurrentContext();
 
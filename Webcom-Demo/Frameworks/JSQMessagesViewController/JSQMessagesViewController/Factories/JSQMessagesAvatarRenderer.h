@@ -0,0 +1,106 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+@class JSQMessagesAvatarImage;
+
+/**
+ *  Posted on the main queue by a `JSQMessagesAvatarRenderer` each time it finishes rendering an avatar.
+ *  The notification object is the renderer. `JSQMessagesViewController` observes it to refresh the avatars of its visible cells.
+ */
+FOUNDATION_EXPORT NSString * const JSQMessagesAvatarRendererDidRenderAvatarNotification;
+
+/**
+ *  A `JSQMessagesAvatarRenderer` object renders avatar images on a background queue and caches them.
+ *
+ *  @discussion The methods of the renderer return immediately. When the avatar is cached, the returned object is complete.
+ *  Otherwise it only has a placeholder image, and its `avatarImage` and `avatarHighlightedImage` properties
+ *  are set once the render finishes. Concurrent requests for the same avatar are coalesced into a single render.
+ *
+ *  Avatars are cached by initials or image identifier, colors, font, diameter and scale,
+ *  so a room with many senders renders each avatar once.
+ */
+@interface JSQMessagesAvatarRenderer : NSObject
+
+/**
+ *  The maximum total cost, in bytes, of the avatars kept in the cache. The default value is 8 MB.
+ */
+@property (assign, nonatomic) NSUInteger totalCostLimit;
+
+/**
+ *  The maximum number of avatars rendered at the same time. The default value is `2`.
+ */
+@property (assign, nonatomic) NSInteger maxConcurrentRenderCount;
+
+/**
+ *  Returns the shared avatar renderer object.
+ *
+ *  @return The shared avatar renderer object.
+ */
++ (JSQMessagesAvatarRenderer *)sharedRenderer;
+
+/**
+ *  Returns an avatar displaying the given initials, rendered like
+ *  `JSQMessagesAvatarImageFactory avatarImageWithUserInitials:backgroundColor:textColor:font:diameter:`.
+ *
+ *  @param userInitials    The user initials to display in the avatar image. This value must not be `nil`.
+ *  @param backgroundColor The background color of the avatar. This value must not be `nil`.
+ *  @param textColor       The color of the text of the userInitials. This value must not be `nil`.
+ *  @param font            The font applied to userInitials. This value must not be `nil`.
+ *  @param diameter        The diameter of the avatar image. This value must be greater than `0`.
+ *  @param completion      A block called on the main queue with the complete avatar. May be `nil`.
+ *  If the avatar is already cached, the block is called synchronously.
+ *
+ *  @return The cached avatar, or an avatar whose placeholder is a circle of the background color.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (JSQMessagesAvatarImage *)avatarImageWithUserInitials:(NSString *)userInitials
+                                        backgroundColor:(UIColor *)backgroundColor
+                                              textColor:(UIColor *)textColor
+                                                   font:(UIFont *)font
+                                               diameter:(NSUInteger)diameter
+                                             completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion;
+
+/**
+ *  Returns an avatar displaying the given image, rendered like `JSQMessagesAvatarImageFactory avatarImageWithImage:diameter:`.
+ *
+ *  @param image      An image object that represents an avatar image. This value must not be `nil`.
+ *  @param identifier A string identifying the image, such as its URL or the identifier of the user. This value must not be `nil`.
+ *  @param diameter   The diameter of the avatar image. This value must be greater than `0`.
+ *  @param completion A block called on the main queue with the complete avatar. May be `nil`.
+ *  If the avatar is already cached, the block is called synchronously.
+ *
+ *  @return The cached avatar, or an avatar whose placeholder is a light gray circle.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (JSQMessagesAvatarImage *)avatarImageWithImage:(UIImage *)image
+                                      identifier:(NSString *)identifier
+                                        diameter:(NSUInteger)diameter
+                                      completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion;
+
+/**
+ *  Empties the avatar cache.
+ */
+- (void)removeAllCachedAvatars;
+
+@end
@@ -0,0 +1,359 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesAvatarRenderer.h"
+
+#import "JSQMessagesAvatarImage.h"
+#import "JSQMessagesAvatarImageFactory.h"
+#import "JSQMessagesCostTrackingCache.h"
+#import "JSQMessagesMemoryCoordinator.h"
+
+#import "UIColor+JSQMessages.h"
+
+
+NSString * const JSQMessagesAvatarRendererDidRenderAvatarNotification = @"JSQMessagesAvatarRendererDidRenderAvatarNotification";
+
+
+@interface JSQMessagesAvatarRenderer () <JSQMessagesPurgeableCache>
+
+@property (strong, nonatomic, readonly) JSQMessagesCostTrackingCache *cache;
+
+@property (strong, nonatomic, readonly) NSOperationQueue *renderQueue;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingAvatars;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingCompletions;
+
+- (JSQMessagesAvatarImage *)jsq_avatarImageForKey:(NSString *)key
+                                 placeholderColor:(UIColor *)placeholderColor
+                                         diameter:(NSUInteger)diameter
+                                      renderBlock:(JSQMessagesAvatarImage *(^)(void))renderBlock
+                                       completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion;
+
+- (void)jsq_finishRenderingAvatarForKey:(NSString *)key withAvatarImage:(JSQMessagesAvatarImage *)avatarImage;
+
+- (UIImage *)jsq_placeholderImageWithColor:(UIColor *)color diameter:(NSUInteger)diameter;
+
++ (NSString *)jsq_keyForColor:(UIColor *)color;
+
++ (NSUInteger)jsq_costForImage:(UIImage *)image;
+
+@end
+
+
+
+@implementation JSQMessagesAvatarRenderer
+
+#pragma mark - Initialization
+
++ (JSQMessagesAvatarRenderer *)sharedRenderer
+{
+    static JSQMessagesAvatarRenderer *_sharedRenderer = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedRenderer = [[JSQMessagesAvatarRenderer alloc] init];
+    });
+    
+    return _sharedRenderer;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _cache = [JSQMessagesCostTrackingCache new];
+        _cache.name = @"JSQMessagesAvatarRenderer.cache";
+        _cache.totalCostLimit = 8 * 1024 * 1024;
+        
+        _renderQueue = [NSOperationQueue new];
+        _renderQueue.name = @"com.jessesquires.JSQMessagesAvatarRenderer";
+        _renderQueue.maxConcurrentOperationCount = 2;
+        
+        _pendingAvatars = [NSMutableDictionary new];
+        _pendingCompletions = [NSMutableDictionary new];
+        
+        [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_renderQueue cancelAllOperations];
+    _renderQueue = nil;
+    _cache = nil;
+    _pendingAvatars = nil;
+    _pendingCompletions = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.cache.totalCostLimit = totalCostLimit;
+}
+
+- (void)setMaxConcurrentRenderCount:(NSInteger)maxConcurrentRenderCount
+{
+    NSParameterAssert(maxConcurrentRenderCount > 0);
+    self.renderQueue.maxConcurrentOperationCount = maxConcurrentRenderCount;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalCostLimit
+{
+    return self.cache.totalCostLimit;
+}
+
+- (NSInteger)maxConcurrentRenderCount
+{
+    return self.renderQueue.maxConcurrentOperationCount;
+}
+
+#pragma mark - Purgeable cache
+
+- (NSString *)cacheName
+{
+    return self.cache.name;
+}
+
+- (NSUInteger)cacheByteCost
+{
+    return self.cache.totalCost;
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    //  avatars are rendered again in the background
+    return JSQMessagesCacheRebuildCostMedium;
+}
+
+- (void)purgeCache
+{
+    [self removeAllCachedAvatars];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: totalCostLimit=%@, maxConcurrentRenderCount=%@, pending=%@>",
+            [self class], @(self.totalCostLimit), @(self.maxConcurrentRenderCount), @(self.pendingAvatars.count)];
+}
+
+#pragma mark - Avatars
+
+- (JSQMessagesAvatarImage *)avatarImageWithUserInitials:(NSString *)userInitials
+                                        backgroundColor:(UIColor *)backgroundColor
+                                              textColor:(UIColor *)textColor
+                                                   font:(UIFont *)font
+                                               diameter:(NSUInteger)diameter
+                                             completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion
+{
+    NSParameterAssert(userInitials != nil);
+    NSParameterAssert(backgroundColor != nil);
+    NSParameterAssert(textColor != nil);
+    NSParameterAssert(font != nil);
+    NSParameterAssert(diameter > 0);
+    
+    CGFloat scale = [UIScreen mainScreen].scale;
+    
+    NSString *key = [NSString stringWithFormat:@"initials:%@|%@|%@|%@-%.2f|%lu@%.0fx",
+                     userInitials,
+                     [JSQMessagesAvatarRenderer jsq_keyForColor:backgroundColor],
+                     [JSQMessagesAvatarRenderer jsq_keyForColor:textColor],
+                     font.fontName, font.pointSize,
+                     (unsigned long)diameter, scale];
+    
+    return [self jsq_avatarImageForKey:key
+                      placeholderColor:backgroundColor
+                              diameter:diameter
+                           renderBlock:^JSQMessagesAvatarImage *{
+                               return [JSQMessagesAvatarImageFactory avatarImageWithUserInitials:userInitials
+                                                                                 backgroundColor:backgroundColor
+                                                                                       textColor:textColor
+                                                                                            font:font
+                                                                                        diameter:diameter
+                                                                                           scale:scale];
+                           }
+                            completion:completion];
+}
+
+- (JSQMessagesAvatarImage *)avatarImageWithImage:(UIImage *)image
+                                      identifier:(NSString *)identifier
+                                        diameter:(NSUInteger)diameter
+                                      completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion
+{
+    NSParameterAssert(image != nil);
+    NSParameterAssert(identifier != nil);
+    NSParameterAssert(diameter > 0);
+    
+    CGFloat scale = [UIScreen mainScreen].scale;
+    
+    NSString *key = [NSString stringWithFormat:@"image:%@|%lu@%.0fx", identifier, (unsigned long)diameter, scale];
+    
+    return [self jsq_avatarImageForKey:key
+                      placeholderColor:[UIColor jsq_messageBubbleLightGrayColor]
+                              diameter:diameter
+                           renderBlock:^JSQMessagesAvatarImage *{
+                               return [JSQMessagesAvatarImageFactory avatarImageWithImage:image diameter:diameter scale:scale];
+                           }
+                            completion:completion];
+}
+
+- (void)removeAllCachedAvatars
+{
+    [self.cache removeAllObjects];
+}
+
+- (JSQMessagesAvatarImage *)jsq_avatarImageForKey:(NSString *)key
+                                 placeholderColor:(UIColor *)placeholderColor
+                                         diameter:(NSUInteger)diameter
+                                      renderBlock:(JSQMessagesAvatarImage *(^)(void))renderBlock
+                                       completion:(void (^)(JSQMessagesAvatarImage *avatarImage))completion
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+    
+    JSQMessagesAvatarImage *cachedAvatarImage = [self.cache objectForKey:key];
+    if (cachedAvatarImage != nil) {
+        if (completion) {
+            completion(cachedAvatarImage);
+        }
+        return cachedAvatarImage;
+    }
+    
+    UIImage *placeholderImage = [self jsq_placeholderImageWithColor:placeholderColor diameter:diameter];
+    JSQMessagesAvatarImage *avatarImage = [JSQMessagesAvatarImage avatarImageWithPlaceholder:placeholderImage];
+    
+    //  every placeholder handed out for this key is filled in when the render finishes
+    NSMutableArray *avatars = [self.pendingAvatars objectForKey:key];
+    BOOL isRendering = (avatars != nil);
+    
+    if (!isRendering) {
+        avatars = [NSMutableArray new];
+        [self.pendingAvatars setObject:avatars forKey:key];
+        [self.pendingCompletions setObject:[NSMutableArray new] forKey:key];
+    }
+    
+    [avatars addObject:avatarImage];
+    
+    if (completion) {
+        [[self.pendingCompletions objectForKey:key] addObject:[completion copy]];
+    }
+    
+    if (isRendering) {
+        return avatarImage;
+    }
+    
+    __weak JSQMessagesAvatarRenderer *weakSelf = self;
+    
+    [self.renderQueue addOperationWithBlock:^{
+        JSQMessagesAvatarImage *renderedAvatarImage = renderBlock();
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf jsq_finishRenderingAvatarForKey:key withAvatarImage:renderedAvatarImage];
+        });
+    }];
+    
+    return avatarImage;
+}
+
+- (void)jsq_finishRenderingAvatarForKey:(NSString *)key withAvatarImage:(JSQMessagesAvatarImage *)avatarImage
+{
+    NSArray *avatars = [self.pendingAvatars objectForKey:key];
+    NSArray *completions = [self.pendingCompletions objectForKey:key];
+    
+    [self.pendingAvatars removeObjectForKey:key];
+    [self.pendingCompletions removeObjectForKey:key];
+    
+    if (avatarImage == nil) {
+        return;
+    }
+    
+    NSUInteger cost = [JSQMessagesAvatarRenderer jsq_costForImage:avatarImage.avatarImage]
+                      + [JSQMessagesAvatarRenderer jsq_costForImage:avatarImage.avatarHighlightedImage];
+    [self.cache setObject:avatarImage forKey:key cost:cost];
+    
+    for (JSQMessagesAvatarImage *eachAvatar in avatars) {
+        eachAvatar.avatarImage = avatarImage.avatarImage;
+        eachAvatar.avatarHighlightedImage = avatarImage.avatarHighlightedImage;
+    }
+    
+    for (void (^completion)(JSQMessagesAvatarImage *) in completions) {
+        completion(avatarImage);
+    }
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:JSQMessagesAvatarRendererDidRenderAvatarNotification object:self];
+}
+
+#pragma mark - Utilities
+
+- (UIImage *)jsq_placeholderImageWithColor:(UIColor *)color diameter:(NSUInteger)diameter
+{
+    CGFloat scale = [UIScreen mainScreen].scale;
+    NSString *key = [NSString stringWithFormat:@"placeholder:%@|%lu@%.0fx",
+                     [JSQMessagesAvatarRenderer jsq_keyForColor:color], (unsigned long)diameter, scale];
+    
+    UIImage *placeholderImage = [self.cache objectForKey:key];
+    if (placeholderImage != nil) {
+        return placeholderImage;
+    }
+    
+    CGRect frame = CGRectMake(0.0f, 0.0f, diameter, diameter);
+    
+    UIGraphicsBeginImageContextWithOptions(frame.size, NO, scale);
+    {
+        CGContextRef context = UIGraphicsGetCurrentContext();
+        CGContextSetFillColorWithColor(context, color.CGColor);
+        CGContextFillEllipseInRect(context, frame);
+        placeholderImage = UIGraphicsGetImageFromCurrentImageContext();
+    }
+    UIGraphicsEndImageContext();
+    
+    if (placeholderImage != nil) {
+        [self.cache setObject:placeholderImage forKey:key cost:[JSQMessagesAvatarRenderer jsq_costForImage:placeholderImage]];
+    }
+    
+    return placeholderImage;
+}
+
++ (NSString *)jsq_keyForColor:(UIColor *)color
+{
+    CGFloat red = 0.0f, green = 0.0f, blue = 0.0f, alpha = 0.0f;
+    
+    if (![color getRed:&red green:&green blue:&blue alpha:&alpha]) {
+        CGFloat white = 0.0f;
+        [color getWhite:&white alpha:&alpha];
+        red = green = blue = white;
+    }
+    
+    return [NSString stringWithFormat:@"%02x%02x%02x%02x",
+            (unsigned int)lroundf(red * 255.0f), (unsigned int)lroundf(green * 255.0f),
+            (unsigned int)lroundf(blue * 255.0f), (unsigned int)lroundf(alpha * 255.0f)];
+}
+
++ (NSUInteger)jsq_costForImage:(UIImage *)image
+{
+    CGImageRef imageRef = image.CGImage;
+    return CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+#import "JSQMessagesBubbleImage.h"
+
+/**
+ *  A `JSQMessagesBubbleImageAtlas` object renders every combination of a set of bubble template images,
+ *  colors and directions into a single atlas image on a background queue.
+ *
+ *  @discussion Once the atlas is ready, `JSQMessagesBubbleImageFactory` takes the bubble images of any combination
+ *  it contains from sub-rects of the atlas instead of tinting and flipping its template.
+ *  Prepare the atlas at launch with the templates and colors of your factories, so that no bubble is rendered
+ *  on the main thread afterwards. Combinations that are not in the atlas are rendered by the factory as usual.
+ *
+ *  The atlas is registered with the `JSQMessagesMemoryCoordinator`. Once purged, it is prepared again
+ *  with the same templates and colors the next time a bubble image is requested.
+ */
+@interface JSQMessagesBubbleImageAtlas : NSObject
+
+/**
+ *  The atlas image, or `nil` until the atlas is prepared.
+ */
+@property (strong, nonatomic, readonly) UIImage *atlasImage;
+
+/**
+ *  Returns the shared bubble image atlas object.
+ *
+ *  @return The shared bubble image atlas object.
+ */
++ (JSQMessagesBubbleImageAtlas *)sharedAtlas;
+
+/**
+ *  Renders the outgoing and incoming bubbles of each template image in each color, and their highlighted variants,
+ *  into a new atlas on a background queue. The new atlas replaces the previous one.
+ *
+ *  @param templateImages An array of `UIImage` objects representing *outgoing* bubbles, as given to
+ *  `JSQMessagesBubbleImageFactory initWithBubbleImage:capInsets:`. This value must not be `nil`.
+ *  @param colors         An array of `UIColor` objects. This value must not be `nil`.
+ *  @param completion     A block called on the main queue once the atlas is ready. May be `nil`.
+ */
+- (void)prepareWithTemplateImages:(NSArray *)templateImages
+                           colors:(NSArray *)colors
+                       completion:(void (^)(void))completion;
+
+/**
+ *  Returns the bubble image of the given combination, cut from the atlas.
+ *
+ *  @param templateImage The template image. This must be the same object that was given to
+ *  `prepareWithTemplateImages:colors:completion:`. This value must not be `nil`.
+ *  @param color         The color of the bubble. This value must not be `nil`.
+ *  @param incoming      Whether the bubble is flipped horizontally for incoming messages.
+ *
+ *  @return A bubble image whose images are not resizable yet, or `nil` if the atlas does not contain the combination.
+ */
+- (JSQMessagesBubbleImage *)bubbleImageWithTemplateImage:(UIImage *)templateImage
+                                                   color:(UIColor *)color
+                                                incoming:(BOOL)incoming;
+
+@end
@@ -0,0 +1,357 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesBubbleImageAtlas.h"
+
+#import "JSQMessagesMemoryCoordinator.h"
+#import "JSQMessagesTintKernel.h"
+
+#import "UIColor+JSQMessages.h"
+
+
+static const size_t kJSQMessagesBubbleImageAtlasMaximumWidth = 2048;
+
+
+static void JSQReleaseAtlasPixels(void *info, const void *data, size_t size)
+{
+    free((void *)data);
+}
+
+
+@interface JSQMessagesBubbleImageAtlas () <JSQMessagesPurgeableCache>
+
+@property (strong, nonatomic, readwrite) UIImage *atlasImage;
+
+@property (copy, nonatomic) NSDictionary *bubbleImages;
+
+@property (copy, nonatomic) NSArray *templateImages;
+
+@property (copy, nonatomic) NSArray *colors;
+
+@property (assign, nonatomic) BOOL needsPrepare;
+
+@property (strong, nonatomic, readonly) dispatch_queue_t renderQueue;
+
++ (NSString *)jsq_keyForTemplateImage:(UIImage *)templateImage tintColor:(JSQMessagesTintColor)tintColor incoming:(BOOL)incoming;
+
++ (uint8_t *)jsq_newMaskForImage:(CGImageRef)imageRef mirrored:(BOOL)mirrored;
+
+@end
+
+
+
+@implementation JSQMessagesBubbleImageAtlas
+
+#pragma mark - Initialization
+
++ (JSQMessagesBubbleImageAtlas *)sharedAtlas
+{
+    static JSQMessagesBubbleImageAtlas *_sharedAtlas = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedAtlas = [[JSQMessagesBubbleImageAtlas alloc] init];
+    });
+    
+    return _sharedAtlas;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _renderQueue = dispatch_queue_create("com.jessesquires.JSQMessagesBubbleImageAtlas", DISPATCH_QUEUE_SERIAL);
+        
+        [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _atlasImage = nil;
+    _bubbleImages = nil;
+    _templateImages = nil;
+    _colors = nil;
+}
+
+#pragma mark - Purgeable cache
+
+- (NSString *)cacheName
+{
+    return @"JSQMessagesBubbleImageAtlas";
+}
+
+- (NSUInteger)cacheByteCost
+{
+    CGImageRef atlasRef = self.atlasImage.CGImage;
+    return CGImageGetBytesPerRow(atlasRef) * CGImageGetHeight(atlasRef);
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    //  bubbles are rendered again on the render queue
+    return JSQMessagesCacheRebuildCostMedium;
+}
+
+- (void)purgeCache
+{
+    if (self.atlasImage == nil) {
+        return;
+    }
+    
+    //  bubble images already handed out keep their own sub-images alive
+    self.atlasImage = nil;
+    self.bubbleImages = nil;
+    self.needsPrepare = YES;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: atlasImage=%@, bubbleImages=%@>",
+            [self class], self.atlasImage, @(self.bubbleImages.count)];
+}
+
+- (id)debugQuickLookObject
+{
+    return self.atlasImage;
+}
+
+#pragma mark - Atlas
+
+- (void)prepareWithTemplateImages:(NSArray *)templateImages
+                           colors:(NSArray *)colors
+                       completion:(void (^)(void))completion
+{
+    NSParameterAssert(templateImages != nil);
+    NSParameterAssert(colors != nil);
+    
+    //  resolve the colors up front, the highlighted colors must match the ones of JSQMessagesBubbleImageFactory
+    NSMutableData *tintColors = [NSMutableData new];
+    
+    for (UIColor *eachColor in colors) {
+        JSQMessagesTintColor pair[2];
+        if ([eachColor jsq_getTintColor:&pair[0]]
+            && [[eachColor jsq_colorByDarkeningColorWithValue:0.12f] jsq_getTintColor:&pair[1]]) {
+            [tintColors appendBytes:pair length:sizeof(pair)];
+        }
+    }
+    
+    NSArray *templates = [templateImages copy];
+    NSArray *colorsToPrepare = [colors copy];
+    self.needsPrepare = NO;
+    
+    __weak JSQMessagesBubbleImageAtlas *weakSelf = self;
+    
+    dispatch_async(self.renderQueue, ^{
+        const JSQMessagesTintColor *colorPairs = tintColors.bytes;
+        NSUInteger colorPairCount = tintColors.length / (2 * sizeof(JSQMessagesTintColor));
+        
+        //  one cell per template, color, direction and state, packed in rows
+        size_t atlasWidth = kJSQMessagesBubbleImageAtlasMaximumWidth;
+        for (UIImage *eachTemplate in templates) {
+            atlasWidth = MAX(atlasWidth, CGImageGetWidth(eachTemplate.CGImage));
+        }
+        
+        NSUInteger cellCount = templates.count * colorPairCount * 4;
+        CGRect *cellRects = calloc(MAX(cellCount, 1), sizeof(CGRect));
+        
+        size_t x = 0;
+        size_t y = 0;
+        size_t rowHeight = 0;
+        NSUInteger cellIndex = 0;
+        
+        for (UIImage *eachTemplate in templates) {
+            size_t width = CGImageGetWidth(eachTemplate.CGImage);
+            size_t height = CGImageGetHeight(eachTemplate.CGImage);
+            
+            for (NSUInteger i = 0; i < colorPairCount * 4; i++) {
+                if (x + width > atlasWidth) {
+                    x = 0;
+                    y += rowHeight;
+                    rowHeight = 0;
+                }
+                
+                cellRects[cellIndex++] = CGRectMake(x, y, width, height);
+                x += width;
+                rowHeight = MAX(rowHeight, height);
+            }
+        }
+        
+        size_t atlasHeight = y + rowHeight;
+        size_t bytesPerRow = 4 * atlasWidth;
+        uint8_t *pixels = (atlasHeight > 0) ? calloc(atlasHeight, bytesPerRow) : NULL;
+        
+        if (pixels == NULL) {
+            free(cellRects);
+            if (completion) {
+                dispatch_async(dispatch_get_main_queue(), completion);
+            }
+            return;
+        }
+        
+        cellIndex = 0;
+        
+        for (UIImage *eachTemplate in templates) {
+            CGImageRef templateRef = eachTemplate.CGImage;
+            size_t width = CGImageGetWidth(templateRef);
+            size_t height = CGImageGetHeight(templateRef);
+            
+            for (NSUInteger direction = 0; direction < 2; direction++) {
+                uint8_t *mask = [JSQMessagesBubbleImageAtlas jsq_newMaskForImage:templateRef mirrored:(direction == 1)];
+                
+                for (NSUInteger colorIndex = 0; colorIndex < colorPairCount; colorIndex++) {
+                    CGRect normalRect = cellRects[cellIndex++];
+                    CGRect highlightedRect = cellRects[cellIndex++];
+                    
+                    if (mask == NULL) {
+                        continue;
+                    }
+                    
+                    JSQMessagesTintKernelApply(mask, width, width, height,
+                                               colorPairs[2 * colorIndex],
+                                               pixels + (size_t)CGRectGetMinY(normalRect) * bytesPerRow + 4 * (size_t)CGRectGetMinX(normalRect),
+                                               colorPairs[2 * colorIndex + 1],
+                                               pixels + (size_t)CGRectGetMinY(highlightedRect) * bytesPerRow + 4 * (size_t)CGRectGetMinX(highlightedRect),
+                                               bytesPerRow);
+                }
+                
+                free(mask);
+            }
+        }
+        
+        CGDataProviderRef provider = CGDataProviderCreateWithData(NULL, pixels, bytesPerRow * atlasHeight, JSQReleaseAtlasPixels);
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGImageRef atlasRef = CGImageCreate(atlasWidth, atlasHeight, 8, 32, bytesPerRow, colorSpace,
+                                            (CGBitmapInfo)kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big,
+                                            provider, NULL, false, kCGRenderingIntentDefault);
+        CGColorSpaceRelease(colorSpace);
+        CGDataProviderRelease(provider);
+        
+        //  sub-images share the pixels of the atlas
+        NSMutableDictionary *bubbleImages = [NSMutableDictionary new];
+        cellIndex = 0;
+        
+        for (UIImage *eachTemplate in templates) {
+            for (NSUInteger direction = 0; direction < 2; direction++) {
+                for (NSUInteger colorIndex = 0; colorIndex < colorPairCount; colorIndex++) {
+                    CGImageRef normalRef = CGImageCreateWithImageInRect(atlasRef, cellRects[cellIndex++]);
+                    CGImageRef highlightedRef = CGImageCreateWithImageInRect(atlasRef, cellRects[cellIndex++]);
+                    
+                    if (normalRef != NULL && highlightedRef != NULL) {
+                        UIImage *normalImage = [UIImage imageWithCGImage:normalRef scale:eachTemplate.scale orientation:UIImageOrientationUp];
+                        UIImage *highlightedImage = [UIImage imageWithCGImage:highlightedRef scale:eachTemplate.scale orientation:UIImageOrientationUp];
+                        
+                        NSString *key = [JSQMessagesBubbleImageAtlas jsq_keyForTemplateImage:eachTemplate
+                                                                                    tintColor:colorPairs[2 * colorIndex]
+                                                                                     incoming:(direction == 1)];
+                        [bubbleImages setObject:[[JSQMessagesBubbleImage alloc] initWithMessageBubbleImage:normalImage
+                                                                                          highlightedImage:highlightedImage]
+                                         forKey:key];
+                    }
+                    
+                    CGImageRelease(normalRef);
+                    CGImageRelease(highlightedRef);
+                }
+            }
+        }
+        
+        UIImage *atlasImage = (atlasRef != NULL) ? [UIImage imageWithCGImage:atlasRef] : nil;
+        CGImageRelease(atlasRef);
+        free(cellRects);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            JSQMessagesBubbleImageAtlas *strongSelf = weakSelf;
+            
+            //  the templates are kept alive so that their addresses in the keys stay unique
+            strongSelf.templateImages = templates;
+            strongSelf.colors = colorsToPrepare;
+            strongSelf.bubbleImages = bubbleImages;
+            strongSelf.atlasImage = atlasImage;
+            strongSelf.needsPrepare = NO;
+            
+            if (completion) {
+                completion();
+            }
+        });
+    });
+}
+
+- (JSQMessagesBubbleImage *)bubbleImageWithTemplateImage:(UIImage *)templateImage
+                                                   color:(UIColor *)color
+                                                incoming:(BOOL)incoming
+{
+    NSParameterAssert(templateImage != nil);
+    NSParameterAssert(color != nil);
+    
+    if (self.needsPrepare) {
+        [self prepareWithTemplateImages:self.templateImages colors:self.colors completion:nil];
+    }
+    
+    JSQMessagesTintColor tintColor;
+    if (self.bubbleImages.count == 0 || ![color jsq_getTintColor:&tintColor]) {
+        return nil;
+    }
+    
+    NSString *key = [JSQMessagesBubbleImageAtlas jsq_keyForTemplateImage:templateImage tintColor:tintColor incoming:incoming];
+    return [self.bubbleImages objectForKey:key];
+}
+
+#pragma mark - Utilities
+
++ (NSString *)jsq_keyForTemplateImage:(UIImage *)templateImage tintColor:(JSQMessagesTintColor)tintColor incoming:(BOOL)incoming
+{
+    return [NSString stringWithFormat:@"%p|%02x%02x%02x%02x|%@",
+            templateImage, tintColor.red, tintColor.green, tintColor.blue, tintColor.alpha, incoming ? @"in" : @"out"];
+}
+
++ (uint8_t *)jsq_newMaskForImage:(CGImageRef)imageRef mirrored:(BOOL)mirrored
+{
+    if (imageRef == NULL) {
+        return NULL;
+    }
+    
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    uint8_t *mask = calloc(width * height, 1);
+    
+    if (mask == NULL) {
+        return NULL;
+    }
+    
+    CGContextRef context = CGBitmapContextCreate(mask, width, height, 8, width, NULL, (CGBitmapInfo)kCGImageAlphaOnly);
+    if (context == NULL) {
+        free(mask);
+        return NULL;
+    }
+    
+    if (mirrored) {
+        CGContextTranslateCTM(context, width, 0.0f);
+        CGContextScaleCTM(context, -1.0f, 1.0f);
+    }
+    
+    CGContextDrawImage(context, CGRectMake(0.0f, 0.0f, width, height), imageRef);
+    CGContextRelease(context);
+    
+    return mask;
+}
+
+@end
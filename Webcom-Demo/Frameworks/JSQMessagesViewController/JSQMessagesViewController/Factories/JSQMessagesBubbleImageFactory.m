@@ -18,6 +18,8 @@
 
 #import "JSQMessagesBubbleImageFactory.h"
 
+#import "JSQMessagesBubbleImageAtlas.h"
+
 #import "UIImage+JSQMessages.h"
 #import "UIColor+JSQMessages.h"
 
@@ -96,12 +98,26 @@
 {
     NSParameterAssert(color != nil);
     
-    UIImage *normalBubble = [self.bubbleImage jsq_imageMaskedWithColor:color];
-    UIImage *highlightedBubble = [self.bubbleImage jsq_imageMaskedWithColor:[color jsq_colorByDarkeningColorWithValue:0.12f]];
+    UIImage *normalBubble = nil;
+    UIImage *highlightedBubble = nil;
     
-    if (flippedForIncoming) {
-        normalBubble = [self jsq_horizontallyFlippedImageFromImage:normalBubble];
-        highlightedBubble = [self jsq_horizontallyFlippedImageFromImage:highlightedBubble];
+    JSQMessagesBubbleImage *atlasBubbleImage = [[JSQMessagesBubbleImageAtlas sharedAtlas] bubbleImageWithTemplateImage:self.bubbleImage
+                                                                                                                  color:color
+                                                                                                               incoming:flippedForIncoming];
+    if (atlasBubbleImage != nil) {
+        //  already tinted and flipped
+        normalBubble = atlasBubbleImage.messageBubbleImage;
+        highlightedBubble = atlasBubbleImage.messageBubbleHighlightedImage;
+    }
+    else {
+        normalBubble = [self.bubbleImage jsq_imageMaskedWithColor:color
+                                                 highlightedColor:[color jsq_colorByDarkeningColorWithValue:0.12f]
+                                                 highlightedImage:&highlightedBubble];
+        
+        if (flippedForIncoming) {
+            normalBubble = [self jsq_horizontallyFlippedImageFromImage:normalBubble];
+            highlightedBubble = [self jsq_horizontallyFlippedImageFromImage:highlightedBubble];
+        }
     }
     
     normalBubble = [self jsq_stretchableImageFromImage:normalBubble withCapInsets:self.capInsets];
@@ -0,0 +1,107 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <UIKit/UIKit.h>
+
+@class JSQMessagesCollectionViewCell;
+
+/**
+ *  A `JSQMessagesCellRenderDescriptor` is an immutable snapshot of everything needed to draw the
+ *  labels, message bubble and text of a `JSQMessagesCollectionViewCell` into a bitmap.
+ *
+ *  Descriptors are created on the main thread from a configured cell and can then be rendered on any thread.
+ *  Two descriptors are equal if they would produce the same bitmap, which makes them suitable as cache keys.
+ *
+ *  @see JSQMessagesCellRenderer.
+ */
+@interface JSQMessagesCellRenderDescriptor : NSObject <NSCopying>
+
+/**
+ *  The size of the bitmap, in points. This is the size of the cell.
+ */
+@property (assign, nonatomic, readonly) CGSize size;
+
+/**
+ *  The scale factor of the bitmap.
+ */
+@property (assign, nonatomic, readonly) CGFloat scale;
+
+/**
+ *  The attributed text of the cell top label, or `nil` if the label is empty.
+ */
+@property (copy, nonatomic, readonly) NSAttributedString *cellTopLabelText;
+
+/**
+ *  The rect in which `cellTopLabelText` is drawn, in the coordinate space of the cell.
+ */
+@property (assign, nonatomic, readonly) CGRect cellTopLabelTextRect;
+
+/**
+ *  The attributed text of the message bubble top label, or `nil` if the label is empty.
+ */
+@property (copy, nonatomic, readonly) NSAttributedString *messageBubbleTopLabelText;
+
+/**
+ *  The rect in which `messageBubbleTopLabelText` is drawn, in the coordinate space of the cell.
+ */
+@property (assign, nonatomic, readonly) CGRect messageBubbleTopLabelTextRect;
+
+/**
+ *  The attributed text of the cell bottom label, or `nil` if the label is empty.
+ */
+@property (copy, nonatomic, readonly) NSAttributedString *cellBottomLabelText;
+
+/**
+ *  The rect in which `cellBottomLabelText` is drawn, in the coordinate space of the cell.
+ */
+@property (assign, nonatomic, readonly) CGRect cellBottomLabelTextRect;
+
+/**
+ *  The message bubble image. Bubble images are compared by identity.
+ */
+@property (strong, nonatomic, readonly) UIImage *messageBubbleImage;
+
+/**
+ *  The rect in which `messageBubbleImage` is drawn, in the coordinate space of the cell.
+ */
+@property (assign, nonatomic, readonly) CGRect messageBubbleRect;
+
+/**
+ *  The attributed message text, including its font, color and link attributes.
+ */
+@property (copy, nonatomic, readonly) NSAttributedString *text;
+
+/**
+ *  The rect in which `text` is drawn, in the coordinate space of the cell.
+ */
+@property (assign, nonatomic, readonly) CGRect textRect;
+
+/**
+ *  Creates and returns a descriptor for the current content of the given cell.
+ *
+ *  @param cell A fully configured text message cell. This value must not be `nil`.
+ *
+ *  @discussion This method must be called on the main thread, after the cell has been configured
+ *  by the data source, for example in `collectionView:willDisplayCell:forItemAtIndexPath:`.
+ *
+ *  @return A new descriptor, or `nil` if the cell displays a media message.
+ */
++ (instancetype)descriptorWithCell:(JSQMessagesCollectionViewCell *)cell;
+
+@end
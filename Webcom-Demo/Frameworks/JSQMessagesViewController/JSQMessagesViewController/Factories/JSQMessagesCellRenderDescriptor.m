@@ -0,0 +1,211 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesCellRenderDescriptor.h"
+
+#import "JSQMessagesCollectionViewCell.h"
+
+
+@interface JSQMessagesCellRenderDescriptor ()
+
+- (instancetype)initWithCell:(JSQMessagesCollectionViewCell *)cell;
+
++ (NSAttributedString *)jsq_drawableTextForLabel:(JSQMessagesLabel *)label;
+
++ (CGRect)jsq_textRectForLabel:(JSQMessagesLabel *)label inView:(UIView *)view;
+
++ (NSAttributedString *)jsq_drawableTextForTextView:(JSQMessagesCellTextView *)textView;
+
+@end
+
+
+
+@implementation JSQMessagesCellRenderDescriptor
+
+#pragma mark - Initialization
+
++ (instancetype)descriptorWithCell:(JSQMessagesCollectionViewCell *)cell
+{
+    NSParameterAssert(cell != nil);
+
+    if (cell.mediaView != nil || cell.textView == nil) {
+        return nil;
+    }
+
+    return [[self alloc] initWithCell:cell];
+}
+
+- (instancetype)initWithCell:(JSQMessagesCollectionViewCell *)cell
+{
+    self = [super init];
+    if (self) {
+        //  constraints may still be pending for a freshly dequeued cell
+        [cell layoutIfNeeded];
+
+        UIView *contentView = cell.contentView;
+
+        _size = cell.bounds.size;
+        _scale = [UIScreen mainScreen].scale;
+
+        _cellTopLabelText = [[self class] jsq_drawableTextForLabel:cell.cellTopLabel];
+        _cellTopLabelTextRect = [[self class] jsq_textRectForLabel:cell.cellTopLabel inView:contentView];
+
+        _messageBubbleTopLabelText = [[self class] jsq_drawableTextForLabel:cell.messageBubbleTopLabel];
+        _messageBubbleTopLabelTextRect = [[self class] jsq_textRectForLabel:cell.messageBubbleTopLabel inView:contentView];
+
+        _cellBottomLabelText = [[self class] jsq_drawableTextForLabel:cell.cellBottomLabel];
+        _cellBottomLabelTextRect = [[self class] jsq_textRectForLabel:cell.cellBottomLabel inView:contentView];
+
+        _messageBubbleImage = cell.messageBubbleImageView.image;
+        _messageBubbleRect = [cell.messageBubbleImageView convertRect:cell.messageBubbleImageView.bounds toView:contentView];
+
+        JSQMessagesCellTextView *textView = cell.textView;
+        _text = [[self class] jsq_drawableTextForTextView:textView];
+        _textRect = UIEdgeInsetsInsetRect([textView convertRect:textView.bounds toView:contentView], textView.textContainerInset);
+    }
+    return self;
+}
+
+#pragma mark - NSObject
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object) {
+        return YES;
+    }
+
+    if (![object isKindOfClass:[self class]]) {
+        return NO;
+    }
+
+    JSQMessagesCellRenderDescriptor *descriptor = (JSQMessagesCellRenderDescriptor *)object;
+
+    //  bubble images are compared by identity, reuse the same `JSQMessagesBubbleImage` objects to get cache hits
+    return CGSizeEqualToSize(self.size, descriptor.size)
+    && self.scale == descriptor.scale
+    && self.messageBubbleImage == descriptor.messageBubbleImage
+    && CGRectEqualToRect(self.messageBubbleRect, descriptor.messageBubbleRect)
+    && CGRectEqualToRect(self.textRect, descriptor.textRect)
+    && CGRectEqualToRect(self.cellTopLabelTextRect, descriptor.cellTopLabelTextRect)
+    && CGRectEqualToRect(self.messageBubbleTopLabelTextRect, descriptor.messageBubbleTopLabelTextRect)
+    && CGRectEqualToRect(self.cellBottomLabelTextRect, descriptor.cellBottomLabelTextRect)
+    && (self.text == descriptor.text || [self.text isEqualToAttributedString:descriptor.text])
+    && (self.cellTopLabelText == descriptor.cellTopLabelText || [self.cellTopLabelText isEqualToAttributedString:descriptor.cellTopLabelText])
+    && (self.messageBubbleTopLabelText == descriptor.messageBubbleTopLabelText || [self.messageBubbleTopLabelText isEqualToAttributedString:descriptor.messageBubbleTopLabelText])
+    && (self.cellBottomLabelText == descriptor.cellBottomLabelText || [self.cellBottomLabelText isEqualToAttributedString:descriptor.cellBottomLabelText]);
+}
+
+- (NSUInteger)hash
+{
+    NSUInteger width = (NSUInteger)self.size.width;
+    NSUInteger height = (NSUInteger)self.size.height;
+    return self.text.string.hash ^ self.messageBubbleTopLabelText.string.hash ^ (width << 16) ^ height ^ (NSUInteger)self.messageBubbleImage;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: size=%@, scale=%@, text=%@>",
+            [self class], NSStringFromCGSize(self.size), @(self.scale), self.text.string];
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+    //  immutable
+    return self;
+}
+
+#pragma mark - Utilities
+
++ (NSAttributedString *)jsq_drawableTextForLabel:(JSQMessagesLabel *)label
+{
+    NSAttributedString *attributedText = label.attributedText;
+
+    if (attributedText.length == 0 || CGRectGetHeight(label.bounds) <= 0.0f) {
+        return nil;
+    }
+
+    //  start from the label defaults, then apply any attributes set by the data source
+    NSMutableParagraphStyle *paragraphStyle = [[NSParagraphStyle defaultParagraphStyle] mutableCopy];
+    paragraphStyle.alignment = label.textAlignment;
+    paragraphStyle.lineBreakMode = NSLineBreakByTruncatingTail;
+
+    NSMutableDictionary *defaultAttributes = [NSMutableDictionary new];
+    defaultAttributes[NSParagraphStyleAttributeName] = paragraphStyle;
+    if (label.font) {
+        defaultAttributes[NSFontAttributeName] = label.font;
+    }
+    if (label.textColor) {
+        defaultAttributes[NSForegroundColorAttributeName] = label.textColor;
+    }
+
+    NSMutableAttributedString *drawableText = [[NSMutableAttributedString alloc] initWithString:attributedText.string
+                                                                                     attributes:defaultAttributes];
+
+    [attributedText enumerateAttributesInRange:NSMakeRange(0, attributedText.length)
+                                       options:0
+                                    usingBlock:^(NSDictionary *attributes, NSRange range, BOOL *stop) {
+                                        [drawableText addAttributes:attributes range:range];
+                                    }];
+
+    return [drawableText copy];
+}
+
++ (CGRect)jsq_textRectForLabel:(JSQMessagesLabel *)label inView:(UIView *)view
+{
+    //  matches -[JSQMessagesLabel drawTextInRect:]
+    CGRect frame = [label convertRect:label.bounds toView:view];
+    UIEdgeInsets insets = label.textInsets;
+
+    return CGRectMake(CGRectGetMinX(frame) + insets.left,
+                      CGRectGetMinY(frame) + insets.top,
+                      CGRectGetWidth(frame) - insets.right,
+                      CGRectGetHeight(frame) - insets.bottom);
+}
+
++ (NSAttributedString *)jsq_drawableTextForTextView:(JSQMessagesCellTextView *)textView
+{
+    NSAttributedString *attributedText = textView.attributedText;
+
+    if (attributedText.length == 0) {
+        return nil;
+    }
+
+    NSDictionary *linkTextAttributes = textView.linkTextAttributes;
+    if (linkTextAttributes.count == 0) {
+        return [attributedText copy];
+    }
+
+    //  UITextView styles links at display time, bake those attributes into the bitmap text
+    NSMutableAttributedString *drawableText = [attributedText mutableCopy];
+
+    [attributedText enumerateAttribute:NSLinkAttributeName
+                               inRange:NSMakeRange(0, attributedText.length)
+                               options:0
+                            usingBlock:^(id value, NSRange range, BOOL *stop) {
+                                if (value != nil) {
+                                    [drawableText addAttributes:linkTextAttributes range:range];
+                                }
+                            }];
+
+    return [drawableText copy];
+}
+
+@end
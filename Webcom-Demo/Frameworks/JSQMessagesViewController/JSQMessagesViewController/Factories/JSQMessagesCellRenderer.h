@@ -0,0 +1,103 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <UIKit/UIKit.h>
+
+#import "JSQMessagesCellRenderDescriptor.h"
+#import "JSQMessagesLoadRequest.h"
+
+/**
+ *  An instance of `JSQMessagesCellRenderer` draws the labels, message bubble and text described by a
+ *  `JSQMessagesCellRenderDescriptor` into a bitmap on background queues, and keeps the results in a cache
+ *  bounded by memory cost.
+ *
+ *  It backs the asynchronous display mode of `JSQMessagesViewController`, where cells show a cheap placeholder
+ *  and swap in the bitmap once it is ready, so that fast scrolling never waits on text rendering.
+ */
+@interface JSQMessagesCellRenderer : NSObject
+
+/**
+ *  The maximum total cost, in bytes, of the bitmaps kept in the cache.
+ *  The default value is 24 MB.
+ */
+@property (assign, nonatomic) NSUInteger totalCostLimit;
+
+/**
+ *  The maximum number of bitmaps rendered at the same time. The default value is `2`.
+ */
+@property (assign, nonatomic) NSInteger maxConcurrentRenderCount;
+
+/**
+ *  Returns the shared cell renderer object.
+ *
+ *  @return The shared cell renderer object.
+ */
++ (JSQMessagesCellRenderer *)sharedRenderer;
+
+/**
+ *  Returns the cached bitmap for the given descriptor, if any.
+ *
+ *  @param descriptor The render descriptor. This value must not be `nil`.
+ *
+ *  @return The cached bitmap, or `nil` if it has not been rendered yet.
+ */
+- (UIImage *)cachedImageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor;
+
+/**
+ *  Asynchronously renders the bitmap for the given descriptor and caches it.
+ *  Concurrent requests for equal descriptors are coalesced into a single render.
+ *
+ *  @param descriptor The render descriptor. This value must not be `nil`.
+ *  @param completion A block called on the main queue with the rendered bitmap, or `nil` if nothing could be rendered.
+ *  If the bitmap is already cached, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelRenderRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)renderImageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor
+                                          completion:(void (^)(UIImage *image))completion;
+
+/**
+ *  Cancels the given render request. Its completion block is not called.
+ *  Other requests for an equal descriptor are not affected, and the render itself is only cancelled
+ *  when no request is waiting on it anymore and it has not started yet.
+ *
+ *  @param request A request returned by `renderImageForDescriptor:completion:`. May be `nil`.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (void)cancelRenderRequest:(JSQMessagesLoadRequest *)request;
+
+/**
+ *  Removes all cached bitmaps.
+ */
+- (void)removeAllCachedImages;
+
+/**
+ *  Synchronously draws the bitmap for the given descriptor. This method can be called from any thread.
+ *
+ *  @param descriptor The render descriptor. This value must not be `nil`.
+ *
+ *  @return A new bitmap.
+ */
++ (UIImage *)imageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor;
+
+@end
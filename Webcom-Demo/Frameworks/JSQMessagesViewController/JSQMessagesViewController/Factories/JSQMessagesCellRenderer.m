@@ -0,0 +1,308 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesCellRenderer.h"
+
+#import "JSQMessagesCostTrackingCache.h"
+#import "JSQMessagesMemoryCoordinator.h"
+
+
+@interface JSQMessagesCellRenderer () <JSQMessagesPurgeableCache>
+
+@property (strong, nonatomic, readonly) JSQMessagesCostTrackingCache *cache;
+
+@property (strong, nonatomic, readonly) NSOperationQueue *renderQueue;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingOperations;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingCompletions;
+
+- (void)jsq_finishRenderingDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor withImage:(UIImage *)image;
+
++ (void)jsq_drawLabelText:(NSAttributedString *)text inRect:(CGRect)rect;
+
+@end
+
+
+
+@implementation JSQMessagesCellRenderer
+
+#pragma mark - Initialization
+
++ (JSQMessagesCellRenderer *)sharedRenderer
+{
+    static JSQMessagesCellRenderer *_sharedRenderer = nil;
+
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedRenderer = [[JSQMessagesCellRenderer alloc] init];
+    });
+
+    return _sharedRenderer;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _cache = [JSQMessagesCostTrackingCache new];
+        _cache.name = @"JSQMessagesCellRenderer.cache";
+        _cache.totalCostLimit = 24 * 1024 * 1024;
+
+        _renderQueue = [NSOperationQueue new];
+        _renderQueue.name = @"com.jessesquires.JSQMessagesCellRenderer";
+        _renderQueue.maxConcurrentOperationCount = 2;
+
+        _pendingOperations = [NSMutableDictionary new];
+        _pendingCompletions = [NSMutableDictionary new];
+
+        [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_renderQueue cancelAllOperations];
+    _renderQueue = nil;
+    _cache = nil;
+    _pendingOperations = nil;
+    _pendingCompletions = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.cache.totalCostLimit = totalCostLimit;
+}
+
+- (void)setMaxConcurrentRenderCount:(NSInteger)maxConcurrentRenderCount
+{
+    NSParameterAssert(maxConcurrentRenderCount > 0);
+    self.renderQueue.maxConcurrentOperationCount = maxConcurrentRenderCount;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalCostLimit
+{
+    return self.cache.totalCostLimit;
+}
+
+- (NSInteger)maxConcurrentRenderCount
+{
+    return self.renderQueue.maxConcurrentOperationCount;
+}
+
+#pragma mark - Purgeable cache
+
+- (NSString *)cacheName
+{
+    return self.cache.name;
+}
+
+- (NSUInteger)cacheByteCost
+{
+    return self.cache.totalCost;
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    //  cells are drawn live until their bitmaps are rendered again
+    return JSQMessagesCacheRebuildCostMedium;
+}
+
+- (void)purgeCache
+{
+    [self removeAllCachedImages];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: totalCostLimit=%@, maxConcurrentRenderCount=%@, pending=%@>",
+            [self class], @(self.totalCostLimit), @(self.maxConcurrentRenderCount), @(self.pendingOperations.count)];
+}
+
+#pragma mark - Rendering
+
+- (UIImage *)cachedImageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor
+{
+    NSParameterAssert(descriptor != nil);
+    return [self.cache objectForKey:descriptor];
+}
+
+- (JSQMessagesLoadRequest *)renderImageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor
+                                          completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(descriptor != nil);
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    UIImage *cachedImage = [self cachedImageForDescriptor:descriptor];
+    if (cachedImage != nil) {
+        if (completion) {
+            completion(cachedImage);
+        }
+        return nil;
+    }
+
+    NSMutableArray *requests = [self.pendingCompletions objectForKey:descriptor];
+    if (requests == nil) {
+        requests = [NSMutableArray new];
+        [self.pendingCompletions setObject:requests forKey:descriptor];
+    }
+
+    JSQMessagesLoadRequest *request = [[JSQMessagesLoadRequest alloc] initWithKey:descriptor completion:completion];
+    [requests addObject:request];
+
+    if ([self.pendingOperations objectForKey:descriptor] != nil) {
+        return request;
+    }
+
+    NSBlockOperation *operation = [NSBlockOperation new];
+    __weak NSBlockOperation *weakOperation = operation;
+    __weak JSQMessagesCellRenderer *weakSelf = self;
+
+    [operation addExecutionBlock:^{
+        if (weakOperation.isCancelled) {
+            return;
+        }
+
+        UIImage *image = [[weakSelf class] imageForDescriptor:descriptor];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf jsq_finishRenderingDescriptor:descriptor withImage:image];
+        });
+    }];
+
+    [self.pendingOperations setObject:operation forKey:descriptor];
+    [self.renderQueue addOperation:operation];
+
+    return request;
+}
+
+- (void)cancelRenderRequest:(JSQMessagesLoadRequest *)request
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    if (request == nil) {
+        return;
+    }
+
+    id key = request.key;
+    NSMutableArray *requests = [self.pendingCompletions objectForKey:key];
+    [requests removeObjectIdenticalTo:request];
+
+    //  equal descriptors are coalesced, other cells may still be waiting on the render
+    if (requests.count > 0) {
+        return;
+    }
+
+    [self.pendingCompletions removeObjectForKey:key];
+
+    //  a render that already started is left to finish, its bitmap is still cached
+    NSOperation *operation = [self.pendingOperations objectForKey:key];
+    if (operation == nil || operation.isExecuting) {
+        return;
+    }
+
+    [operation cancel];
+    [self.pendingOperations removeObjectForKey:key];
+}
+
+- (void)removeAllCachedImages
+{
+    [self.cache removeAllObjects];
+}
+
+- (void)jsq_finishRenderingDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor withImage:(UIImage *)image
+{
+    [self.pendingOperations removeObjectForKey:descriptor];
+
+    NSArray *requests = [self.pendingCompletions objectForKey:descriptor];
+    [self.pendingCompletions removeObjectForKey:descriptor];
+
+    if (image != nil) {
+        CGImageRef imageRef = image.CGImage;
+        NSUInteger cost = CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+        [self.cache setObject:image forKey:descriptor cost:cost];
+    }
+
+    //  waiters are also told about failures, so they can fall back to live content
+    for (JSQMessagesLoadRequest *request in requests) {
+        if (request.completion) {
+            request.completion(image);
+        }
+    }
+}
+
+#pragma mark - Drawing
+
++ (UIImage *)imageForDescriptor:(JSQMessagesCellRenderDescriptor *)descriptor
+{
+    NSParameterAssert(descriptor != nil);
+
+    if (descriptor.size.width <= 0.0f || descriptor.size.height <= 0.0f) {
+        return nil;
+    }
+
+    UIGraphicsBeginImageContextWithOptions(descriptor.size, NO, descriptor.scale);
+
+    [self jsq_drawLabelText:descriptor.cellTopLabelText inRect:descriptor.cellTopLabelTextRect];
+    [self jsq_drawLabelText:descriptor.messageBubbleTopLabelText inRect:descriptor.messageBubbleTopLabelTextRect];
+
+    [descriptor.messageBubbleImage drawInRect:descriptor.messageBubbleRect];
+
+    [descriptor.text drawWithRect:descriptor.textRect
+                          options:(NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading)
+                          context:nil];
+
+    [self jsq_drawLabelText:descriptor.cellBottomLabelText inRect:descriptor.cellBottomLabelTextRect];
+
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    return image;
+}
+
++ (void)jsq_drawLabelText:(NSAttributedString *)text inRect:(CGRect)rect
+{
+    if (text.length == 0 || CGRectIsEmpty(rect)) {
+        return;
+    }
+
+    //  labels draw a single line, vertically centered
+    CGRect textBounds = [text boundingRectWithSize:CGSizeMake(CGRectGetWidth(rect), CGFLOAT_MAX)
+                                           options:NSStringDrawingUsesFontLeading
+                                           context:nil];
+
+    CGFloat textHeight = MIN(ceilf(CGRectGetHeight(textBounds)), CGRectGetHeight(rect));
+    CGRect drawingRect = CGRectMake(CGRectGetMinX(rect),
+                                    CGRectGetMidY(rect) - textHeight / 2.0f,
+                                    CGRectGetWidth(rect),
+                                    textHeight);
+
+    [text drawWithRect:drawingRect
+               options:(NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingTruncatesLastVisibleLine)
+               context:nil];
+}
+
+@end
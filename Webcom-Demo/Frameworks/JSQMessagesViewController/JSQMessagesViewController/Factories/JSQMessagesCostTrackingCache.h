@@ -0,0 +1,37 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  A `JSQMessagesCostTrackingCache` is an `NSCache` that keeps track of the total cost of the objects it contains,
+ *  so that their memory footprint can be reported to the `JSQMessagesMemoryCoordinator`.
+ *
+ *  @warning The cache is its own delegate, in order to observe evictions. Do not change its delegate.
+ */
+@interface JSQMessagesCostTrackingCache : NSCache
+
+/**
+ *  Returns the sum of the costs of the objects in the cache.
+ *
+ *  @discussion This value is approximate when the same object is stored under several keys.
+ */
+@property (assign, nonatomic, readonly) NSUInteger totalCost;
+
+@end
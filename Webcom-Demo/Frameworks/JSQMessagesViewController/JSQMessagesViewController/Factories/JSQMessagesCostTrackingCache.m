@@ -0,0 +1,113 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesCostTrackingCache.h"
+
+
+@interface JSQMessagesCostTrackingCache () <NSCacheDelegate>
+
+@property (strong, nonatomic, readonly) NSMapTable *costs;
+
+@property (assign, nonatomic, readwrite) NSUInteger totalCost;
+
+- (void)jsq_removeCostForObject:(id)obj;
+
+@end
+
+
+
+@implementation JSQMessagesCostTrackingCache
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        //  weak keys compared by pointer, so that the table never keeps an evicted object alive
+        _costs = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                           valueOptions:NSPointerFunctionsStrongMemory
+                                               capacity:0];
+        _totalCost = 0;
+        super.delegate = self;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    super.delegate = nil;
+    _costs = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: name=%@, totalCost=%@, totalCostLimit=%@>",
+            [self class], self.name, @(self.totalCost), @(self.totalCostLimit)];
+}
+
+#pragma mark - NSCache
+
+- (void)setObject:(id)obj forKey:(id)key
+{
+    [self setObject:obj forKey:key cost:0];
+}
+
+- (void)setObject:(id)obj forKey:(id)key cost:(NSUInteger)g
+{
+    id previousObject = [self objectForKey:key];
+    if (previousObject != nil && previousObject != obj) {
+        [self jsq_removeCostForObject:previousObject];
+    }
+
+    //  the bookkeeping never calls into the cache while holding the lock, evictions may come from any thread
+    @synchronized (self.costs) {
+        NSUInteger previousCost = [[self.costs objectForKey:obj] unsignedIntegerValue];
+        [self.costs setObject:@(g) forKey:obj];
+        self.totalCost = self.totalCost - MIN(previousCost, self.totalCost) + g;
+    }
+
+    [super setObject:obj forKey:key cost:g];
+}
+
+#pragma mark - Cache delegate
+
+- (void)cache:(NSCache *)cache willEvictObject:(id)obj
+{
+    [self jsq_removeCostForObject:obj];
+}
+
+#pragma mark - Utilities
+
+- (void)jsq_removeCostForObject:(id)obj
+{
+    @synchronized (self.costs) {
+        NSNumber *cost = [self.costs objectForKey:obj];
+        if (cost == nil) {
+            return;
+        }
+
+        [self.costs removeObjectForKey:obj];
+        self.totalCost -= MIN([cost unsignedIntegerValue], self.totalCost);
+    }
+}
+
+@end
@@ -0,0 +1,92 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+#import "JSQMessageData.h"
+
+/**
+ *  An instance of `JSQMessagesDataDetector` runs `NSDataDetector` over the text of message data items
+ *  on a private background queue and caches the results per message.
+ *
+ *  Detected ranges are stored as an attributed string that carries *only* `NSLinkAttributeName` attributes,
+ *  so that a `JSQMessagesCellTextView` can display tappable links without enabling `dataDetectorTypes`,
+ *  which would otherwise re-run detection on the main thread every time a cell is displayed.
+ */
+@interface JSQMessagesDataDetector : NSObject
+
+/**
+ *  The types of data that the detector checks for.
+ *  The default value is `NSTextCheckingTypeLink | NSTextCheckingTypePhoneNumber | NSTextCheckingTypeAddress`.
+ */
+@property (assign, nonatomic, readonly) NSTextCheckingTypes checkingTypes;
+
+/**
+ *  Returns the shared data detector object.
+ *
+ *  @return The shared data detector object.
+ */
++ (JSQMessagesDataDetector *)sharedDetector;
+
+/**
+ *  Initializes and returns a data detector that checks for the given types.
+ *
+ *  @param checkingTypes The types of data to detect. Dates are not supported and will be ignored.
+ *
+ *  @return An initialized `JSQMessagesDataDetector` object if successful, `nil` otherwise.
+ */
+- (instancetype)initWithCheckingTypes:(NSTextCheckingTypes)checkingTypes NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Returns the cached detection results for the given message data item, if any.
+ *
+ *  @param messageData A text message data item. This value must not be `nil`.
+ *
+ *  @return An attributed string whose string is the message text and whose only attributes are
+ *  `NSLinkAttributeName` values for the detected ranges, or `nil` if detection has not completed yet.
+ */
+- (NSAttributedString *)cachedLinksForMessageData:(id<JSQMessageData>)messageData;
+
+/**
+ *  Asynchronously detects links in the text of the given message data item and caches the result.
+ *  Concurrent requests for the same message are coalesced into a single detection pass.
+ *
+ *  @param messageData A text message data item. This value must not be `nil`.
+ *  @param completion  A block called on the main queue with the detection results. May be `nil`.
+ *  If the results are already cached, the block is called synchronously.
+ */
+- (void)detectLinksForMessageData:(id<JSQMessageData>)messageData
+                       completion:(void (^)(NSAttributedString *links))completion;
+
+/**
+ *  Cancels a pending detection for the given message data item, if no completion block is waiting on it.
+ *  This is a no-op if detection has already started or finished.
+ *
+ *  @param messageData A text message data item. This value must not be `nil`.
+ *
+ *  @discussion Use this method to drop prefetch requests for messages that are no longer about to be displayed.
+ */
+- (void)cancelLinkDetectionForMessageData:(id<JSQMessageData>)messageData;
+
+/**
+ *  Removes all cached detection results.
+ */
+- (void)removeAllCachedLinks;
+
+@end
@@ -0,0 +1,250 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesDataDetector.h"
+
+
+@interface JSQMessagesDataDetector ()
+
+@property (strong, nonatomic, readonly) NSDataDetector *detector;
+
+@property (strong, nonatomic, readonly) NSCache *cache;
+
+@property (strong, nonatomic, readonly) NSOperationQueue *detectionQueue;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingOperations;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingCompletions;
+
+- (NSAttributedString *)jsq_linksForText:(NSString *)text;
+
+- (NSURL *)jsq_URLForTextCheckingResult:(NSTextCheckingResult *)result inText:(NSString *)text;
+
+@end
+
+
+
+@implementation JSQMessagesDataDetector
+
+#pragma mark - Initialization
+
++ (JSQMessagesDataDetector *)sharedDetector
+{
+    static JSQMessagesDataDetector *_sharedDetector = nil;
+
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedDetector = [[JSQMessagesDataDetector alloc] init];
+    });
+
+    return _sharedDetector;
+}
+
+- (instancetype)init
+{
+    return [self initWithCheckingTypes:NSTextCheckingTypeLink | NSTextCheckingTypePhoneNumber | NSTextCheckingTypeAddress];
+}
+
+- (instancetype)initWithCheckingTypes:(NSTextCheckingTypes)checkingTypes
+{
+    self = [super init];
+    if (self) {
+        //  calendar events cannot be expressed as link attributes, so dates are never detected
+        _checkingTypes = checkingTypes & ~NSTextCheckingTypeDate;
+        _detector = [NSDataDetector dataDetectorWithTypes:_checkingTypes error:nil];
+
+        _cache = [NSCache new];
+        _cache.name = @"JSQMessagesDataDetector.cache";
+        _cache.countLimit = 500;
+
+        _detectionQueue = [NSOperationQueue new];
+        _detectionQueue.name = @"com.jessesquires.JSQMessagesDataDetector";
+        _detectionQueue.maxConcurrentOperationCount = 1;
+
+        _pendingOperations = [NSMutableDictionary new];
+        _pendingCompletions = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _detector = nil;
+    _cache = nil;
+    [_detectionQueue cancelAllOperations];
+    _detectionQueue = nil;
+    _pendingOperations = nil;
+    _pendingCompletions = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: checkingTypes=%@, cache=%@>",
+            [self class], @(self.checkingTypes), self.cache];
+}
+
+#pragma mark - Detection
+
+- (NSAttributedString *)cachedLinksForMessageData:(id<JSQMessageData>)messageData
+{
+    NSParameterAssert(messageData != nil);
+
+    NSAttributedString *links = [self.cache objectForKey:@(JSQMessageDataFingerprint(messageData))];
+
+    //  guard against hash collisions, the cached string must match the message text
+    if (links != nil && [links.string isEqualToString:[messageData text]]) {
+        return links;
+    }
+
+    return nil;
+}
+
+- (void)detectLinksForMessageData:(id<JSQMessageData>)messageData
+                       completion:(void (^)(NSAttributedString *links))completion
+{
+    NSParameterAssert(messageData != nil);
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    NSAttributedString *cachedLinks = [self cachedLinksForMessageData:messageData];
+    if (cachedLinks != nil) {
+        if (completion) {
+            completion(cachedLinks);
+        }
+        return;
+    }
+
+    NSNumber *key = @(JSQMessageDataFingerprint(messageData));
+    NSMutableArray *completions = [self.pendingCompletions objectForKey:key];
+    BOOL isDetecting = (completions != nil);
+
+    if (!isDetecting) {
+        completions = [NSMutableArray new];
+        [self.pendingCompletions setObject:completions forKey:key];
+    }
+
+    if (completion) {
+        [completions addObject:[completion copy]];
+    }
+
+    if (isDetecting) {
+        return;
+    }
+
+    NSString *text = [[messageData text] copy];
+
+    NSBlockOperation *operation = [NSBlockOperation new];
+    __weak NSBlockOperation *weakOperation = operation;
+
+    [operation addExecutionBlock:^{
+        if (weakOperation.isCancelled) {
+            return;
+        }
+
+        NSAttributedString *links = [self jsq_linksForText:text];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self.cache setObject:links forKey:key];
+            [self.pendingOperations removeObjectForKey:key];
+
+            NSArray *pending = [self.pendingCompletions objectForKey:key];
+            [self.pendingCompletions removeObjectForKey:key];
+
+            for (void (^pendingCompletion)(NSAttributedString *) in pending) {
+                pendingCompletion(links);
+            }
+        });
+    }];
+
+    [self.pendingOperations setObject:operation forKey:key];
+    [self.detectionQueue addOperation:operation];
+}
+
+- (void)cancelLinkDetectionForMessageData:(id<JSQMessageData>)messageData
+{
+    NSParameterAssert(messageData != nil);
+
+    NSNumber *key = @(JSQMessageDataFingerprint(messageData));
+    NSOperation *operation = [self.pendingOperations objectForKey:key];
+
+    //  only drop requests nobody is waiting on, such as prefetches
+    if (operation == nil || operation.isExecuting || [[self.pendingCompletions objectForKey:key] count] > 0) {
+        return;
+    }
+
+    [operation cancel];
+    [self.pendingOperations removeObjectForKey:key];
+    [self.pendingCompletions removeObjectForKey:key];
+}
+
+- (void)removeAllCachedLinks
+{
+    [self.cache removeAllObjects];
+}
+
+#pragma mark - Utilities
+
+- (NSAttributedString *)jsq_linksForText:(NSString *)text
+{
+    NSMutableAttributedString *links = [[NSMutableAttributedString alloc] initWithString:text ?: @""];
+
+    if (text.length == 0 || self.detector == nil) {
+        return [links copy];
+    }
+
+    [self.detector enumerateMatchesInString:text
+                                    options:0
+                                      range:NSMakeRange(0, text.length)
+                                 usingBlock:^(NSTextCheckingResult *result, NSMatchingFlags flags, BOOL *stop) {
+                                     NSURL *URL = [self jsq_URLForTextCheckingResult:result inText:text];
+                                     if (URL != nil) {
+                                         [links addAttribute:NSLinkAttributeName value:URL range:result.range];
+                                     }
+                                 }];
+
+    return [links copy];
+}
+
+- (NSURL *)jsq_URLForTextCheckingResult:(NSTextCheckingResult *)result inText:(NSString *)text
+{
+    switch (result.resultType) {
+        case NSTextCheckingTypeLink:
+            return result.URL;
+
+        case NSTextCheckingTypePhoneNumber:
+        {
+            NSCharacterSet *allowed = [NSCharacterSet characterSetWithCharactersInString:@"+0123456789*#,;"];
+            NSString *digits = [[result.phoneNumber componentsSeparatedByCharactersInSet:[allowed invertedSet]] componentsJoinedByString:@""];
+            return (digits.length > 0) ? [NSURL URLWithString:[@"tel:" stringByAppendingString:digits]] : nil;
+        }
+
+        case NSTextCheckingTypeAddress:
+        {
+            NSString *address = [text substringWithRange:result.range];
+            NSString *query = [address stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLQueryAllowedCharacterSet]];
+            return (query.length > 0) ? [NSURL URLWithString:[@"http://maps.apple.com/?q=" stringByAppendingString:query]] : nil;
+        }
+
+        default:
+            return nil;
+    }
+}
+
+@end
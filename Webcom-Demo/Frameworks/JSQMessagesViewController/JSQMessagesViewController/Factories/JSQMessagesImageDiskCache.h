@@ -0,0 +1,96 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+/**
+ *  A `JSQMessagesImageDiskCache` object stores small, already downsampled images, such as media thumbnails,
+ *  as JPEG files in a subdirectory of the application's caches directory. Images with an alpha channel are stored
+ *  as PNG files, so that their transparency is preserved.
+ *
+ *  @discussion Reads are synchronous and decode the bitmap immediately, so they are meant to be performed
+ *  on a background queue. Writes and trimming are performed asynchronously on a private serial queue.
+ */
+@interface JSQMessagesImageDiskCache : NSObject
+
+/**
+ *  The directory in which the cache stores its files.
+ */
+@property (strong, nonatomic, readonly) NSURL *directoryURL;
+
+/**
+ *  The maximum size, in bytes, of the files kept in the cache. When the cache is created, and whenever
+ *  this value changes, the least recently written files are removed until the cache fits within this limit.
+ *  When a write takes the cache over this limit, files are removed until it fits within three quarters of it.
+ *  The default value is 50 MB.
+ */
+@property (assign, nonatomic) NSUInteger byteLimit;
+
+/**
+ *  Initializes and returns a disk cache storing its files in a directory with the given name.
+ *
+ *  @param name The name of the cache directory. This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesImageDiskCache` object if successful, `nil` otherwise.
+ */
+- (instancetype)initWithName:(NSString *)name NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Not a valid initializer.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Synchronously reads and decodes the image stored for the given key.
+ *
+ *  @param key   The key of the image. This value must not be `nil`.
+ *  @param scale The scale of the returned image.
+ *
+ *  @return The decoded image, or `nil` if no image is stored for key.
+ */
+- (UIImage *)imageForKey:(NSString *)key scale:(CGFloat)scale;
+
+/**
+ *  Synchronously reads and decodes the image stored for the given key, provided that it is not older
+ *  than the file it was produced from.
+ *
+ *  @param key           The key of the image. This value must not be `nil`.
+ *  @param scale         The scale of the returned image.
+ *  @param sourceFileURL The file URL of the photo or video the image was produced from. May be `nil`.
+ *
+ *  @return The decoded image, or `nil` if no image is stored for key or if the source file was modified
+ *  after the image was stored, in which case the stale image is removed.
+ */
+- (UIImage *)imageForKey:(NSString *)key scale:(CGFloat)scale sourceFileURL:(NSURL *)sourceFileURL;
+
+/**
+ *  Asynchronously stores the given image for the given key, replacing any previous image.
+ *
+ *  @param image The image to store. This value must not be `nil`.
+ *  @param key   The key of the image. This value must not be `nil`.
+ */
+- (void)storeImage:(UIImage *)image forKey:(NSString *)key;
+
+/**
+ *  Asynchronously removes all the images stored in the cache.
+ */
+- (void)removeAllImages;
+
+@end
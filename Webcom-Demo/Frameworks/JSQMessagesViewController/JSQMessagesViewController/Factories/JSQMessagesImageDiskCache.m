@@ -0,0 +1,261 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesImageDiskCache.h"
+
+#import <CommonCrypto/CommonDigest.h>
+#import <ImageIO/ImageIO.h>
+
+#import "UIImage+JSQMessages.h"
+
+
+static const CGFloat kJSQMessagesImageDiskCacheCompressionQuality = 0.85f;
+
+
+@interface JSQMessagesImageDiskCache ()
+
+@property (strong, nonatomic, readonly) dispatch_queue_t ioQueue;
+
+@property (assign, nonatomic) NSUInteger jsq_byteCount;
+
+- (NSURL *)jsq_fileURLForKey:(NSString *)key;
+
++ (NSDate *)jsq_modificationDateOfFileURL:(NSURL *)fileURL;
+
+- (void)jsq_trimToByteLimit:(NSUInteger)byteLimit;
+
+@end
+
+
+
+@implementation JSQMessagesImageDiskCache
+
+#pragma mark - Initialization
+
+- (instancetype)initWithName:(NSString *)name
+{
+    NSParameterAssert(name != nil);
+    
+    self = [super init];
+    if (self) {
+        NSURL *cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+        _directoryURL = [[cachesURL URLByAppendingPathComponent:@"com.jessesquires.JSQMessages" isDirectory:YES]
+                         URLByAppendingPathComponent:name isDirectory:YES];
+        
+        [[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL
+                                 withIntermediateDirectories:YES
+                                                  attributes:nil
+                                                       error:nil];
+        
+        NSString *queueLabel = [NSString stringWithFormat:@"com.jessesquires.JSQMessagesImageDiskCache.%@", name];
+        _ioQueue = dispatch_queue_create([queueLabel UTF8String], DISPATCH_QUEUE_SERIAL);
+        
+        _byteLimit = 50 * 1024 * 1024;
+        [self jsq_trimToByteLimit:_byteLimit];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _directoryURL = nil;
+    _ioQueue = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setByteLimit:(NSUInteger)byteLimit
+{
+    _byteLimit = byteLimit;
+    [self jsq_trimToByteLimit:byteLimit];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: directoryURL=%@, byteLimit=%@>",
+            [self class], self.directoryURL, @(self.byteLimit)];
+}
+
+#pragma mark - Reading and writing
+
+- (UIImage *)imageForKey:(NSString *)key scale:(CGFloat)scale
+{
+    return [self imageForKey:key scale:scale sourceFileURL:nil];
+}
+
+- (UIImage *)imageForKey:(NSString *)key scale:(CGFloat)scale sourceFileURL:(NSURL *)sourceFileURL
+{
+    NSParameterAssert(key != nil);
+    
+    NSURL *fileURL = [self jsq_fileURLForKey:key];
+    
+    if (sourceFileURL.isFileURL) {
+        //  a file replaced at the same URL must not be served from a stale thumbnail
+        NSDate *storedDate = [JSQMessagesImageDiskCache jsq_modificationDateOfFileURL:fileURL];
+        NSDate *sourceDate = [JSQMessagesImageDiskCache jsq_modificationDateOfFileURL:sourceFileURL];
+        
+        if (storedDate != nil && sourceDate != nil && [sourceDate compare:storedDate] == NSOrderedDescending) {
+            dispatch_async(self.ioQueue, ^{
+                [[NSFileManager new] removeItemAtURL:fileURL error:nil];
+            });
+            return nil;
+        }
+    }
+    
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)fileURL, NULL);
+    if (source == NULL) {
+        return nil;
+    }
+    
+    //  decode now, on the calling queue, rather than when the image is first drawn
+    NSDictionary *options = @{ (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES };
+    CGImageRef imageRef = CGImageSourceCreateImageAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+    
+    if (imageRef == NULL) {
+        return nil;
+    }
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
+- (void)storeImage:(UIImage *)image forKey:(NSString *)key
+{
+    NSParameterAssert(image != nil);
+    NSParameterAssert(key != nil);
+    
+    NSURL *fileURL = [self jsq_fileURLForKey:key];
+    
+    dispatch_async(self.ioQueue, ^{
+        //  JPEG has no alpha channel, transparent pixels would come back black
+        NSData *data = [image jsq_hasAlpha]
+                        ? UIImagePNGRepresentation(image)
+                        : UIImageJPEGRepresentation(image, kJSQMessagesImageDiskCacheCompressionQuality);
+        
+        if (![data writeToURL:fileURL atomically:YES]) {
+            return;
+        }
+        
+        //  an estimate, overwritten files are counted twice until the next trim measures the directory again
+        self.jsq_byteCount += data.length;
+        
+        //  trim below the limit, so that the directory is not measured again on each of the next writes
+        NSUInteger byteLimit = self.byteLimit;
+        if (self.jsq_byteCount > byteLimit) {
+            //  the trim runs after the writes already queued, and measures them along with the directory
+            self.jsq_byteCount = 0;
+            [self jsq_trimToByteLimit:byteLimit - byteLimit / 4];
+        }
+    });
+}
+
+- (void)removeAllImages
+{
+    NSURL *directoryURL = self.directoryURL;
+    
+    dispatch_async(self.ioQueue, ^{
+        NSFileManager *fileManager = [NSFileManager new];
+        [fileManager removeItemAtURL:directoryURL error:nil];
+        [fileManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+        self.jsq_byteCount = 0;
+    });
+}
+
+#pragma mark - Utilities
+
+- (NSURL *)jsq_fileURLForKey:(NSString *)key
+{
+    //  keys may contain paths or URLs, so files are named after a digest of the key
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(keyData.bytes, (CC_LONG)keyData.length, digest);
+    
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++) {
+        [fileName appendFormat:@"%02x", digest[i]];
+    }
+    
+    return [self.directoryURL URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
++ (NSDate *)jsq_modificationDateOfFileURL:(NSURL *)fileURL
+{
+    //  resource values are cached by the URL object, which may outlive the file
+    [fileURL removeAllCachedResourceValues];
+    
+    NSDate *date = nil;
+    [fileURL getResourceValue:&date forKey:NSURLContentModificationDateKey error:nil];
+    return date;
+}
+
+- (void)jsq_trimToByteLimit:(NSUInteger)byteLimit
+{
+    NSURL *directoryURL = self.directoryURL;
+    
+    dispatch_async(self.ioQueue, ^{
+        NSFileManager *fileManager = [NSFileManager new];
+        NSArray *keys = @[ NSURLContentModificationDateKey, NSURLTotalFileAllocatedSizeKey ];
+        
+        NSArray *fileURLs = [fileManager contentsOfDirectoryAtURL:directoryURL
+                                       includingPropertiesForKeys:keys
+                                                          options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                            error:nil];
+        
+        NSMutableDictionary *attributesForURLs = [NSMutableDictionary dictionaryWithCapacity:fileURLs.count];
+        NSUInteger totalSize = 0;
+        
+        for (NSURL *fileURL in fileURLs) {
+            NSDictionary *attributes = [fileURL resourceValuesForKeys:keys error:nil];
+            if (attributes == nil) {
+                continue;
+            }
+            
+            [attributesForURLs setObject:attributes forKey:fileURL];
+            totalSize += [[attributes objectForKey:NSURLTotalFileAllocatedSizeKey] unsignedIntegerValue];
+        }
+        
+        if (totalSize <= byteLimit) {
+            self.jsq_byteCount = totalSize;
+            return;
+        }
+        
+        NSArray *sortedURLs = [attributesForURLs keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *attributes1, NSDictionary *attributes2) {
+            return [[attributes1 objectForKey:NSURLContentModificationDateKey] compare:[attributes2 objectForKey:NSURLContentModificationDateKey]];
+        }];
+        
+        for (NSURL *fileURL in sortedURLs) {
+            if (totalSize <= byteLimit) {
+                break;
+            }
+            
+            if ([fileManager removeItemAtURL:fileURL error:nil]) {
+                totalSize -= [[[attributesForURLs objectForKey:fileURL] objectForKey:NSURLTotalFileAllocatedSizeKey] unsignedIntegerValue];
+            }
+        }
+        
+        self.jsq_byteCount = totalSize;
+    });
+}
+
+@end
@@ -0,0 +1,202 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+#import "JSQMessagesLoadRequest.h"
+
+@class JSQMessagesImageDiskCache;
+
+/**
+ *  A `JSQMessagesImageLoader` object produces decoded thumbnails of photos for media views.
+ *  Photos are downsampled to the requested pixel size on a background queue, so full resolution
+ *  bitmaps are never decoded on the main thread nor kept in memory.
+ *
+ *  @discussion Decoded thumbnails are kept in a memory cache limited by `totalCostLimit`.
+ *  Thumbnails of photos loaded from a file are also written to a disk cache, so they do not need to be
+ *  downsampled again after the memory cache is purged or the application is relaunched.
+ */
+@interface JSQMessagesImageLoader : NSObject
+
+/**
+ *  The maximum total cost, in bytes, of the decoded thumbnails kept in the memory cache.
+ *  The default value is 32 MB.
+ */
+@property (assign, nonatomic) NSUInteger totalCostLimit;
+
+/**
+ *  The maximum number of photos downsampled at the same time. The default value is `2`.
+ */
+@property (assign, nonatomic) NSInteger maxConcurrentLoadCount;
+
+/**
+ *  The disk cache in which the loader stores thumbnails of photos loaded from a file.
+ */
+@property (strong, nonatomic, readonly) JSQMessagesImageDiskCache *diskCache;
+
+/**
+ *  Returns the shared image loader object.
+ *
+ *  @return The shared image loader object.
+ */
++ (JSQMessagesImageLoader *)sharedLoader;
+
+/**
+ *  Initializes and returns an image loader whose disk cache uses a directory with the given name.
+ *
+ *  @param name The name of the disk cache directory. This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesImageLoader` object if successful, `nil` otherwise.
+ *
+ *  @discussion Use a separate loader for each kind of image, so that each has its own caches and concurrency limit.
+ */
+- (instancetype)initWithName:(NSString *)name NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Returns the thumbnail held in the memory cache for the given key, if any.
+ *
+ *  @param key The key of the thumbnail. This value must not be `nil`.
+ *
+ *  @return The decoded thumbnail, or `nil` if it is not in the memory cache.
+ */
+- (UIImage *)cachedImageForKey:(NSString *)key;
+
+/**
+ *  Asynchronously loads a thumbnail of the photo stored at the given file URL.
+ *  Concurrent requests for the same key are coalesced into a single load.
+ *
+ *  @param key        The key of the thumbnail, which should identify both the file and the pixel size. This value must not be `nil`.
+ *  @param fileURL    The file URL of the photo. This value must not be `nil`.
+ *  @param pixelSize  The size, in pixels, that the thumbnail must fill.
+ *  @param completion A block called on the main queue with the thumbnail, or `nil` if the photo could not be read.
+ *  If the thumbnail is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelLoadRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion The disk cache is checked before reading the photo, and a thumbnail older than the file is ignored. This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                              contentsOfURL:(NSURL *)fileURL
+                                  pixelSize:(CGSize)pixelSize
+                                 completion:(void (^)(UIImage *image))completion;
+
+/**
+ *  Asynchronously loads a thumbnail of the given image.
+ *  Concurrent requests for the same key are coalesced into a single load.
+ *
+ *  @param key        The key of the thumbnail, which should identify both the image and the pixel size. This value must not be `nil`.
+ *  @param image      The full size image. This value must not be `nil`.
+ *  @param pixelSize  The size, in pixels, that the thumbnail must fill.
+ *  @param completion A block called on the main queue with the thumbnail.
+ *  If the thumbnail is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelLoadRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion Thumbnails of in-memory images are not written to the disk cache. This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                                      image:(UIImage *)image
+                                  pixelSize:(CGSize)pixelSize
+                                 completion:(void (^)(UIImage *image))completion;
+
+/**
+ *  Asynchronously loads the image produced by the given block.
+ *  Concurrent requests for the same key are coalesced into a single load.
+ *
+ *  @param key        The key of the image, which should identify both its source and its pixel size. This value must not be `nil`.
+ *  @param block      A block called on a background queue with the scale of the main screen, returning a decoded image or `nil`.
+ *  This value must not be `nil`.
+ *  @param completion A block called on the main queue with the image, or `nil` if it could not be produced.
+ *  If the image is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelLoadRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion The disk cache is checked before calling block, and the image it returns is written to the disk cache.
+ *  This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                                 usingBlock:(UIImage *(^)(CGFloat scale))block
+                                 completion:(void (^)(UIImage *image))completion;
+
+/**
+ *  Asynchronously loads the image produced by the given block from the file at the given URL.
+ *  Concurrent requests for the same key are coalesced into a single load.
+ *
+ *  @param key           The key of the image, which should identify both its source and its pixel size. This value must not be `nil`.
+ *  @param sourceFileURL The file URL the image is produced from. May be `nil`.
+ *  @param block         A block called on a background queue with the scale of the main screen, returning a decoded image or `nil`.
+ *  This value must not be `nil`.
+ *  @param completion    A block called on the main queue with the image, or `nil` if it could not be produced.
+ *  If the image is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelLoadRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion The disk cache is checked before calling block, unless the file at sourceFileURL was modified after
+ *  the image was stored, and the image block returns is written to the disk cache. This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                              sourceFileURL:(NSURL *)sourceFileURL
+                                 usingBlock:(UIImage *(^)(CGFloat scale))block
+                                 completion:(void (^)(UIImage *image))completion;
+
+/**
+ *  Cancels the given load request. Its completion block is not called.
+ *  Other requests for the same key are not affected, and the load itself is only cancelled
+ *  when no request is waiting on it anymore and it has not started yet.
+ *
+ *  @param request A request returned by one of the load methods. May be `nil`.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (void)cancelLoadRequest:(JSQMessagesLoadRequest *)request;
+
+/**
+ *  Empties the memory cache. The disk cache is left untouched.
+ */
+- (void)removeAllCachedImages;
+
+/**
+ *  Synchronously creates a decoded thumbnail of the photo stored at the given file URL using ImageIO,
+ *  without decoding the photo at its full resolution.
+ *
+ *  @param fileURL   The file URL of the photo. This value must not be `nil`.
+ *  @param pixelSize The size, in pixels, that the thumbnail must fill when displayed with an aspect fill content mode.
+ *  @param scale     The scale of the returned image.
+ *
+ *  @return The thumbnail, or `nil` if the photo could not be read.
+ */
++ (UIImage *)downsampledImageWithContentsOfURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize scale:(CGFloat)scale;
+
+/**
+ *  Synchronously creates a decoded thumbnail of the given image.
+ *
+ *  @param image     The full size image. This value must not be `nil`.
+ *  @param pixelSize The size, in pixels, that the thumbnail must fill when displayed with an aspect fill content mode.
+ *  @param scale     The scale of the returned image.
+ *
+ *  @return The thumbnail.
+ */
++ (UIImage *)downsampledImageFromImage:(UIImage *)image pixelSize:(CGSize)pixelSize scale:(CGFloat)scale;
+
+@end
@@ -0,0 +1,410 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesImageLoader.h"
+
+#import <ImageIO/ImageIO.h>
+
+#import "JSQMessagesCostTrackingCache.h"
+#import "JSQMessagesImageDiskCache.h"
+#import "JSQMessagesMemoryCoordinator.h"
+
+#import "UIImage+JSQMessages.h"
+
+
+@interface JSQMessagesImageLoader () <JSQMessagesPurgeableCache>
+
+@property (strong, nonatomic, readonly) JSQMessagesCostTrackingCache *cache;
+
+@property (strong, nonatomic, readonly) NSOperationQueue *loadQueue;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingOperations;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *pendingCompletions;
+
+- (JSQMessagesLoadRequest *)jsq_loadImageForKey:(NSString *)key
+                                   usesDiskCache:(BOOL)usesDiskCache
+                                   sourceFileURL:(NSURL *)sourceFileURL
+                                       loadBlock:(UIImage *(^)(CGFloat scale))loadBlock
+                                      completion:(void (^)(UIImage *image))completion;
+
+- (void)jsq_finishLoadingImageForKey:(NSString *)key withImage:(UIImage *)image;
+
++ (CGSize)jsq_aspectFillSizeForSize:(CGSize)size toFillSize:(CGSize)fillSize;
+
+@end
+
+
+
+@implementation JSQMessagesImageLoader
+
+#pragma mark - Initialization
+
++ (JSQMessagesImageLoader *)sharedLoader
+{
+    static JSQMessagesImageLoader *_sharedLoader = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedLoader = [[JSQMessagesImageLoader alloc] init];
+    });
+    
+    return _sharedLoader;
+}
+
+- (instancetype)init
+{
+    return [self initWithName:@"Photos"];
+}
+
+- (instancetype)initWithName:(NSString *)name
+{
+    NSParameterAssert(name != nil);
+    
+    self = [super init];
+    if (self) {
+        _cache = [JSQMessagesCostTrackingCache new];
+        _cache.name = [NSString stringWithFormat:@"JSQMessagesImageLoader.%@.cache", name];
+        _cache.totalCostLimit = 32 * 1024 * 1024;
+        
+        _loadQueue = [NSOperationQueue new];
+        _loadQueue.name = [NSString stringWithFormat:@"com.jessesquires.JSQMessagesImageLoader.%@", name];
+        _loadQueue.maxConcurrentOperationCount = 2;
+        
+        _pendingOperations = [NSMutableDictionary new];
+        _pendingCompletions = [NSMutableDictionary new];
+        
+        _diskCache = [[JSQMessagesImageDiskCache alloc] initWithName:name];
+        
+        [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_loadQueue cancelAllOperations];
+    _loadQueue = nil;
+    _cache = nil;
+    _pendingOperations = nil;
+    _pendingCompletions = nil;
+    _diskCache = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.cache.totalCostLimit = totalCostLimit;
+}
+
+- (void)setMaxConcurrentLoadCount:(NSInteger)maxConcurrentLoadCount
+{
+    NSParameterAssert(maxConcurrentLoadCount > 0);
+    self.loadQueue.maxConcurrentOperationCount = maxConcurrentLoadCount;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalCostLimit
+{
+    return self.cache.totalCostLimit;
+}
+
+- (NSInteger)maxConcurrentLoadCount
+{
+    return self.loadQueue.maxConcurrentOperationCount;
+}
+
+#pragma mark - Purgeable cache
+
+- (NSString *)cacheName
+{
+    return self.cache.name;
+}
+
+- (NSUInteger)cacheByteCost
+{
+    return self.cache.totalCost;
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    //  images are read back from the disk cache and decoded again
+    return JSQMessagesCacheRebuildCostMedium;
+}
+
+- (void)purgeCache
+{
+    [self removeAllCachedImages];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: totalCostLimit=%@, maxConcurrentLoadCount=%@, pending=%@>",
+            [self class], @(self.totalCostLimit), @(self.maxConcurrentLoadCount), @(self.pendingOperations.count)];
+}
+
+#pragma mark - Loading
+
+- (UIImage *)cachedImageForKey:(NSString *)key
+{
+    NSParameterAssert(key != nil);
+    return [self.cache objectForKey:key];
+}
+
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                              contentsOfURL:(NSURL *)fileURL
+                                  pixelSize:(CGSize)pixelSize
+                                 completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(fileURL != nil);
+    
+    return [self jsq_loadImageForKey:key usesDiskCache:YES sourceFileURL:fileURL loadBlock:^UIImage *(CGFloat scale) {
+        return [JSQMessagesImageLoader downsampledImageWithContentsOfURL:fileURL pixelSize:pixelSize scale:scale];
+    } completion:completion];
+}
+
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                                      image:(UIImage *)image
+                                  pixelSize:(CGSize)pixelSize
+                                 completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(image != nil);
+    
+    return [self jsq_loadImageForKey:key usesDiskCache:NO sourceFileURL:nil loadBlock:^UIImage *(CGFloat scale) {
+        return [JSQMessagesImageLoader downsampledImageFromImage:image pixelSize:pixelSize scale:scale];
+    } completion:completion];
+}
+
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                                 usingBlock:(UIImage *(^)(CGFloat scale))block
+                                 completion:(void (^)(UIImage *image))completion
+{
+    return [self loadImageForKey:key sourceFileURL:nil usingBlock:block completion:completion];
+}
+
+- (JSQMessagesLoadRequest *)loadImageForKey:(NSString *)key
+                              sourceFileURL:(NSURL *)sourceFileURL
+                                 usingBlock:(UIImage *(^)(CGFloat scale))block
+                                 completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(block != nil);
+    return [self jsq_loadImageForKey:key usesDiskCache:YES sourceFileURL:sourceFileURL loadBlock:block completion:completion];
+}
+
+- (void)cancelLoadRequest:(JSQMessagesLoadRequest *)request
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+    
+    if (request == nil) {
+        return;
+    }
+    
+    id key = request.key;
+    NSMutableArray *requests = [self.pendingCompletions objectForKey:key];
+    [requests removeObjectIdenticalTo:request];
+    
+    //  several media views may be waiting on the same thumbnail, poster or snapshot
+    if (requests.count > 0) {
+        return;
+    }
+    
+    [self.pendingCompletions removeObjectForKey:key];
+    
+    //  a load that already started is left to finish, its image is still cached
+    NSOperation *operation = [self.pendingOperations objectForKey:key];
+    if (operation == nil || operation.isExecuting) {
+        return;
+    }
+    
+    [operation cancel];
+    [self.pendingOperations removeObjectForKey:key];
+}
+
+- (void)removeAllCachedImages
+{
+    [self.cache removeAllObjects];
+}
+
+- (JSQMessagesLoadRequest *)jsq_loadImageForKey:(NSString *)key
+                                   usesDiskCache:(BOOL)usesDiskCache
+                                   sourceFileURL:(NSURL *)sourceFileURL
+                                       loadBlock:(UIImage *(^)(CGFloat scale))loadBlock
+                                      completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(key != nil);
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+    
+    UIImage *cachedImage = [self cachedImageForKey:key];
+    if (cachedImage != nil) {
+        if (completion) {
+            completion(cachedImage);
+        }
+        return nil;
+    }
+    
+    NSMutableArray *requests = [self.pendingCompletions objectForKey:key];
+    if (requests == nil) {
+        requests = [NSMutableArray new];
+        [self.pendingCompletions setObject:requests forKey:key];
+    }
+    
+    JSQMessagesLoadRequest *request = [[JSQMessagesLoadRequest alloc] initWithKey:key completion:completion];
+    [requests addObject:request];
+    
+    if ([self.pendingOperations objectForKey:key] != nil) {
+        return request;
+    }
+    
+    CGFloat scale = [UIScreen mainScreen].scale;
+    JSQMessagesImageDiskCache *diskCache = usesDiskCache ? self.diskCache : nil;
+    
+    NSBlockOperation *operation = [NSBlockOperation new];
+    __weak NSBlockOperation *weakOperation = operation;
+    __weak JSQMessagesImageLoader *weakSelf = self;
+    
+    [operation addExecutionBlock:^{
+        if (weakOperation.isCancelled) {
+            return;
+        }
+        
+        UIImage *image = [diskCache imageForKey:key scale:scale sourceFileURL:sourceFileURL];
+        
+        if (image == nil) {
+            image = loadBlock(scale);
+            
+            if (image != nil) {
+                [diskCache storeImage:image forKey:key];
+            }
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf jsq_finishLoadingImageForKey:key withImage:image];
+        });
+    }];
+    
+    [self.pendingOperations setObject:operation forKey:key];
+    [self.loadQueue addOperation:operation];
+    
+    return request;
+}
+
+- (void)jsq_finishLoadingImageForKey:(NSString *)key withImage:(UIImage *)image
+{
+    [self.pendingOperations removeObjectForKey:key];
+    
+    NSArray *requests = [self.pendingCompletions objectForKey:key];
+    [self.pendingCompletions removeObjectForKey:key];
+    
+    if (image != nil) {
+        CGImageRef imageRef = image.CGImage;
+        NSUInteger cost = CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+        [self.cache setObject:image forKey:key cost:cost];
+    }
+    
+    for (JSQMessagesLoadRequest *request in requests) {
+        if (request.completion) {
+            request.completion(image);
+        }
+    }
+}
+
+#pragma mark - Downsampling
+
++ (UIImage *)downsampledImageWithContentsOfURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize scale:(CGFloat)scale
+{
+    NSParameterAssert(fileURL != nil);
+    
+    //  do not let ImageIO cache the full size image when creating the source
+    NSDictionary *sourceOptions = @{ (__bridge NSString *)kCGImageSourceShouldCache : @NO };
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)fileURL, (__bridge CFDictionaryRef)sourceOptions);
+    if (source == NULL) {
+        return nil;
+    }
+    
+    NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(source, 0, NULL);
+    CGSize imagePixelSize = CGSizeMake([[properties objectForKey:(__bridge NSString *)kCGImagePropertyPixelWidth] floatValue],
+                                       [[properties objectForKey:(__bridge NSString *)kCGImagePropertyPixelHeight] floatValue]);
+    
+    //  EXIF orientations 5 to 8 are rotated by 90 degrees
+    NSInteger orientation = [[properties objectForKey:(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+    if (orientation >= 5) {
+        imagePixelSize = CGSizeMake(imagePixelSize.height, imagePixelSize.width);
+    }
+    
+    CGSize thumbnailSize = [self jsq_aspectFillSizeForSize:imagePixelSize toFillSize:pixelSize];
+    if (thumbnailSize.width <= 0.0f || thumbnailSize.height <= 0.0f) {
+        CFRelease(source);
+        return nil;
+    }
+    
+    NSDictionary *thumbnailOptions = @{ (__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                                        (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                                        (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                                        (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(MAX(thumbnailSize.width, thumbnailSize.height)) };
+    
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+    CFRelease(source);
+    
+    if (imageRef == NULL) {
+        return nil;
+    }
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
++ (UIImage *)downsampledImageFromImage:(UIImage *)image pixelSize:(CGSize)pixelSize scale:(CGFloat)scale
+{
+    NSParameterAssert(image != nil);
+    
+    CGSize imagePixelSize = CGSizeMake(image.size.width * image.scale, image.size.height * image.scale);
+    CGSize thumbnailSize = [self jsq_aspectFillSizeForSize:imagePixelSize toFillSize:pixelSize];
+    
+    if (thumbnailSize.width <= 0.0f || thumbnailSize.height <= 0.0f) {
+        return nil;
+    }
+    
+    //  drawing into a bitmap decodes the image here rather than on the main thread,
+    //  an opaque one is cheaper to composite but would turn transparent pixels black
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(thumbnailSize.width / scale, thumbnailSize.height / scale), ![image jsq_hasAlpha], scale);
+    [image drawInRect:CGRectMake(0.0f, 0.0f, thumbnailSize.width / scale, thumbnailSize.height / scale)];
+    UIImage *thumbnail = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    return thumbnail;
+}
+
++ (CGSize)jsq_aspectFillSizeForSize:(CGSize)size toFillSize:(CGSize)fillSize
+{
+    if (size.width <= 0.0f || size.height <= 0.0f) {
+        return CGSizeZero;
+    }
+    
+    //  never upscale, a small photo is displayed as is
+    CGFloat ratio = MIN(MAX(fillSize.width / size.width, fillSize.height / size.height), 1.0f);
+    return CGSizeMake(ceilf(size.width * ratio), ceilf(size.height * ratio));
+}
+
+@end
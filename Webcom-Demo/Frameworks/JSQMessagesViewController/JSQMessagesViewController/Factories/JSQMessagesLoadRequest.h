@@ -0,0 +1,55 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  A `JSQMessagesLoadRequest` object identifies one caller waiting on an asynchronous, coalesced image load
+ *  or render. Equal keys share a single operation, and each caller gets its own request.
+ *
+ *  @discussion Pass the request back to the object that returned it in order to cancel it.
+ *  Cancelling a request only drops its own completion block. The shared operation is cancelled
+ *  once no request is waiting on it anymore.
+ *
+ *  @see `JSQMessagesImageLoader cancelLoadRequest:`.
+ *  @see `JSQMessagesCellRenderer cancelRenderRequest:`.
+ */
+@interface JSQMessagesLoadRequest : NSObject
+
+/**
+ *  The key of the load or render the request is waiting on.
+ */
+@property (copy, nonatomic, readonly) id<NSCopying> key;
+
+/**
+ *  The block called on the main queue when the load or render finishes. May be `nil`.
+ */
+@property (copy, nonatomic, readonly) void (^completion)(UIImage *image);
+
+/**
+ *  Initializes and returns a request for the given key.
+ *
+ *  @param key        The key of the load or render. This value must not be `nil`.
+ *  @param completion The block to call when it finishes. May be `nil`.
+ *
+ *  @return An initialized `JSQMessagesLoadRequest` object.
+ */
+- (instancetype)initWithKey:(id<NSCopying>)key completion:(void (^)(UIImage *image))completion NS_DESIGNATED_INITIALIZER;
+
+@end
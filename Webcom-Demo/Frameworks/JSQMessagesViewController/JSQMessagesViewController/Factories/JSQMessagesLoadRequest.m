@@ -0,0 +1,58 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesLoadRequest.h"
+
+
+@implementation JSQMessagesLoadRequest
+
+#pragma mark - Initialization
+
+- (instancetype)initWithKey:(id<NSCopying>)key completion:(void (^)(UIImage *image))completion
+{
+    NSParameterAssert(key != nil);
+
+    self = [super init];
+    if (self) {
+        _key = [(id)key copy];
+        _completion = [completion copy];
+    }
+    return self;
+}
+
+- (id)init
+{
+    NSAssert(NO, @"%s is not a valid initializer for %@.", __PRETTY_FUNCTION__, [self class]);
+    return nil;
+}
+
+- (void)dealloc
+{
+    _key = nil;
+    _completion = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: key=%@>", [self class], self.key];
+}
+
+@end
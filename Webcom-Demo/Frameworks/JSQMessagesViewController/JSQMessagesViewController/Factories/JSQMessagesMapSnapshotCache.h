@@ -0,0 +1,111 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import <MapKit/MapKit.h>
+
+#import "JSQMessagesLoadRequest.h"
+
+/**
+ *  A `JSQMessagesMapSnapshotCache` object produces and caches map snapshots for location media views.
+ *
+ *  @discussion The coordinate and region of each request are quantized to a grid of a few points at the
+ *  requested size, so that nearby locations displayed at the same zoom level share a single snapshot.
+ *  Identical requests are coalesced into a single `MKMapSnapshotter`, at most `maxConcurrentSnapshotCount`
+ *  snapshotters run at the same time, and finished snapshots are kept in a memory cache and in a disk cache.
+ */
+@interface JSQMessagesMapSnapshotCache : NSObject
+
+/**
+ *  The maximum total cost, in bytes, of the decoded snapshots kept in the memory cache.
+ *  The default value is 16 MB.
+ */
+@property (assign, nonatomic) NSUInteger totalCostLimit;
+
+/**
+ *  The maximum number of snapshots created at the same time. The default value is `2`.
+ */
+@property (assign, nonatomic) NSInteger maxConcurrentSnapshotCount;
+
+/**
+ *  Returns the shared map snapshot cache object.
+ *
+ *  @return The shared map snapshot cache object.
+ */
++ (JSQMessagesMapSnapshotCache *)sharedCache;
+
+/**
+ *  Initializes and returns a map snapshot cache whose disk cache uses a directory with the given name.
+ *
+ *  @param name The name of the disk cache directory. This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesMapSnapshotCache` object if successful, `nil` otherwise.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (instancetype)initWithName:(NSString *)name NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Returns the snapshot held in the memory cache for the given parameters, if any.
+ *
+ *  @param coordinate The coordinate of the pin.
+ *  @param region     The map region to capture.
+ *  @param size       The size of the snapshot, in points.
+ *
+ *  @return The snapshot, or `nil` if it is not in the memory cache.
+ */
+- (UIImage *)cachedSnapshotForCoordinate:(CLLocationCoordinate2D)coordinate
+                                  region:(MKCoordinateRegion)region
+                                    size:(CGSize)size;
+
+/**
+ *  Asynchronously creates a snapshot of the given region with a pin at the given coordinate.
+ *  Requests that quantize to the same snapshot are coalesced.
+ *
+ *  @param coordinate The coordinate of the pin.
+ *  @param region     The map region to capture.
+ *  @param size       The size of the snapshot, in points.
+ *  @param completion A block called on the main queue with the snapshot, or `nil` if it could not be created.
+ *  If the snapshot is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelSnapshotRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)snapshotForCoordinate:(CLLocationCoordinate2D)coordinate
+                                           region:(MKCoordinateRegion)region
+                                             size:(CGSize)size
+                                       completion:(void (^)(UIImage *snapshot))completion;
+
+/**
+ *  Cancels the given snapshot request. Other requests that quantize to the same snapshot are not affected,
+ *  and the snapshot is only cancelled when no request is waiting on it anymore and it has not started yet.
+ *
+ *  @param request A request returned by `snapshotForCoordinate:region:size:completion:`. May be `nil`.
+ */
+- (void)cancelSnapshotRequest:(JSQMessagesLoadRequest *)request;
+
+/**
+ *  Empties the memory cache. The disk cache is left untouched.
+ */
+- (void)removeAllCachedSnapshots;
+
+@end
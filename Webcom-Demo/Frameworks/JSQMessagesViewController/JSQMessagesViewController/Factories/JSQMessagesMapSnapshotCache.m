@@ -0,0 +1,307 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesMapSnapshotCache.h"
+
+#import "JSQMessagesImageLoader.h"
+
+
+/**
+ *  The size, in points, of the grid to which coordinates are quantized.
+ */
+static const CGFloat kJSQMessagesMapSnapshotQuantumPoints = 2.0f;
+
+/**
+ *  The relative step to which region spans are quantized.
+ */
+static const double kJSQMessagesMapSnapshotSpanQuantum = 0.01;
+
+/**
+ *  The time after which a snapshotter that did not complete is cancelled.
+ */
+static const int64_t kJSQMessagesMapSnapshotTimeout = 30;
+
+
+typedef struct {
+    NSInteger latitude;
+    NSInteger longitude;
+    NSInteger latitudeDelta;
+    NSInteger longitudeDelta;
+    NSInteger pinLatitude;
+    NSInteger pinLongitude;
+} JSQMessagesMapSnapshotGridPosition;
+
+
+@interface JSQMessagesMapSnapshotCache ()
+
+@property (strong, nonatomic, readonly) JSQMessagesImageLoader *loader;
+
+@property (strong, nonatomic, readonly) UIImage *pinImage;
+
+@property (assign, nonatomic, readonly) CGPoint pinOffset;
+
+- (NSString *)jsq_keyForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size;
+
++ (JSQMessagesMapSnapshotGridPosition)jsq_gridPositionForCoordinate:(CLLocationCoordinate2D)coordinate
+                                                             region:(MKCoordinateRegion)region
+                                                               size:(CGSize)size;
+
++ (MKCoordinateRegion)jsq_regionForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size;
+
++ (CLLocationCoordinate2D)jsq_pinCoordinateForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size;
+
+- (UIImage *)jsq_snapshotForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size scale:(CGFloat)scale;
+
+- (MKMapSnapshotter *)jsq_snapshotterWithOptions:(MKMapSnapshotOptions *)options;
+
+@end
+
+
+
+@implementation JSQMessagesMapSnapshotCache
+
+#pragma mark - Initialization
+
++ (JSQMessagesMapSnapshotCache *)sharedCache
+{
+    static JSQMessagesMapSnapshotCache *_sharedCache = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedCache = [[JSQMessagesMapSnapshotCache alloc] init];
+    });
+    
+    return _sharedCache;
+}
+
+- (instancetype)init
+{
+    return [self initWithName:@"MapSnapshots"];
+}
+
+- (instancetype)initWithName:(NSString *)name
+{
+    NSParameterAssert(name != nil);
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+    
+    self = [super init];
+    if (self) {
+        _loader = [[JSQMessagesImageLoader alloc] initWithName:name];
+        _loader.totalCostLimit = 16 * 1024 * 1024;
+        _loader.maxConcurrentLoadCount = 2;
+        
+        //  the pin is a view, read it once here rather than on the snapshot queues
+        MKAnnotationView *pin = [[MKPinAnnotationView alloc] initWithAnnotation:nil reuseIdentifier:nil];
+        _pinImage = pin.image;
+        _pinOffset = CGPointMake(pin.centerOffset.x - (CGRectGetWidth(pin.bounds) / 2.0f),
+                                 pin.centerOffset.y - (CGRectGetHeight(pin.bounds) / 2.0f));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _loader = nil;
+    _pinImage = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.loader.totalCostLimit = totalCostLimit;
+}
+
+- (void)setMaxConcurrentSnapshotCount:(NSInteger)maxConcurrentSnapshotCount
+{
+    self.loader.maxConcurrentLoadCount = maxConcurrentSnapshotCount;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalCostLimit
+{
+    return self.loader.totalCostLimit;
+}
+
+- (NSInteger)maxConcurrentSnapshotCount
+{
+    return self.loader.maxConcurrentLoadCount;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: totalCostLimit=%@, maxConcurrentSnapshotCount=%@>",
+            [self class], @(self.totalCostLimit), @(self.maxConcurrentSnapshotCount)];
+}
+
+#pragma mark - Snapshots
+
+- (UIImage *)cachedSnapshotForCoordinate:(CLLocationCoordinate2D)coordinate
+                                  region:(MKCoordinateRegion)region
+                                    size:(CGSize)size
+{
+    JSQMessagesMapSnapshotGridPosition position = [JSQMessagesMapSnapshotCache jsq_gridPositionForCoordinate:coordinate region:region size:size];
+    return [self.loader cachedImageForKey:[self jsq_keyForGridPosition:position size:size]];
+}
+
+- (JSQMessagesLoadRequest *)snapshotForCoordinate:(CLLocationCoordinate2D)coordinate
+                                           region:(MKCoordinateRegion)region
+                                             size:(CGSize)size
+                                       completion:(void (^)(UIImage *snapshot))completion
+{
+    JSQMessagesMapSnapshotGridPosition position = [JSQMessagesMapSnapshotCache jsq_gridPositionForCoordinate:coordinate region:region size:size];
+    
+    __weak JSQMessagesMapSnapshotCache *weakSelf = self;
+    
+    return [self.loader loadImageForKey:[self jsq_keyForGridPosition:position size:size] usingBlock:^UIImage *(CGFloat scale) {
+        return [weakSelf jsq_snapshotForGridPosition:position size:size scale:scale];
+    } completion:completion];
+}
+
+- (void)cancelSnapshotRequest:(JSQMessagesLoadRequest *)request
+{
+    [self.loader cancelLoadRequest:request];
+}
+
+- (void)removeAllCachedSnapshots
+{
+    [self.loader removeAllCachedImages];
+}
+
+- (UIImage *)jsq_snapshotForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size scale:(CGFloat)scale
+{
+    MKMapSnapshotOptions *options = [[MKMapSnapshotOptions alloc] init];
+    options.region = [JSQMessagesMapSnapshotCache jsq_regionForGridPosition:position size:size];
+    options.size = size;
+    options.scale = scale;
+    
+    CLLocationCoordinate2D pinCoordinate = [JSQMessagesMapSnapshotCache jsq_pinCoordinateForGridPosition:position size:size];
+    UIImage *pinImage = self.pinImage;
+    CGPoint pinOffset = self.pinOffset;
+    
+    __block UIImage *snapshotImage = nil;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    
+    //  the loader runs this block on its own queue, which bounds the number of running snapshotters
+    MKMapSnapshotter *snapshotter = [self jsq_snapshotterWithOptions:options];
+    
+    [snapshotter startWithQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)
+              completionHandler:^(MKMapSnapshot *snapshot, NSError *error) {
+                  if (error) {
+                      NSLog(@"%s Error creating map snapshot: %@", __PRETTY_FUNCTION__, error);
+                      dispatch_semaphore_signal(semaphore);
+                      return;
+                  }
+                  
+                  CGPoint coordinatePoint = [snapshot pointForCoordinate:pinCoordinate];
+                  UIImage *image = snapshot.image;
+                  
+                  coordinatePoint.x += pinOffset.x;
+                  coordinatePoint.y += pinOffset.y;
+                  
+                  UIGraphicsBeginImageContextWithOptions(image.size, YES, image.scale);
+                  {
+                      [image drawAtPoint:CGPointZero];
+                      [pinImage drawAtPoint:coordinatePoint];
+                      snapshotImage = UIGraphicsGetImageFromCurrentImageContext();
+                  }
+                  UIGraphicsEndImageContext();
+                  
+                  dispatch_semaphore_signal(semaphore);
+              }];
+    
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, kJSQMessagesMapSnapshotTimeout * NSEC_PER_SEC)) != 0) {
+        [snapshotter cancel];
+        return nil;
+    }
+    
+    return snapshotImage;
+}
+
+- (MKMapSnapshotter *)jsq_snapshotterWithOptions:(MKMapSnapshotOptions *)options
+{
+    return [[MKMapSnapshotter alloc] initWithOptions:options];
+}
+
+#pragma mark - Quantization
+
+- (NSString *)jsq_keyForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size
+{
+    return [NSString stringWithFormat:@"%ld,%ld,%ld,%ld,%ld,%ld-%@",
+            (long)position.latitude, (long)position.longitude,
+            (long)position.latitudeDelta, (long)position.longitudeDelta,
+            (long)position.pinLatitude, (long)position.pinLongitude,
+            NSStringFromCGSize(size)];
+}
+
++ (JSQMessagesMapSnapshotGridPosition)jsq_gridPositionForCoordinate:(CLLocationCoordinate2D)coordinate
+                                                             region:(MKCoordinateRegion)region
+                                                               size:(CGSize)size
+{
+    NSParameterAssert(size.width > 0.0f && size.height > 0.0f);
+    
+    JSQMessagesMapSnapshotGridPosition position = { 0, 0, 0, 0, 0, 0 };
+    
+    //  spans are quantized on a logarithmic scale, so every zoom level keeps the same relative precision
+    double logQuantum = log1p(kJSQMessagesMapSnapshotSpanQuantum);
+    position.latitudeDelta = (NSInteger)round(log(MAX(region.span.latitudeDelta, DBL_MIN)) / logQuantum);
+    position.longitudeDelta = (NSInteger)round(log(MAX(region.span.longitudeDelta, DBL_MIN)) / logQuantum);
+    
+    //  coordinates are quantized to a few points of the quantized span at the requested size
+    MKCoordinateRegion quantizedRegion = [self jsq_regionForGridPosition:position size:size];
+    double latitudeStep = quantizedRegion.span.latitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.height;
+    double longitudeStep = quantizedRegion.span.longitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.width;
+    
+    position.latitude = (NSInteger)round(region.center.latitude / latitudeStep);
+    position.longitude = (NSInteger)round(region.center.longitude / longitudeStep);
+    position.pinLatitude = (NSInteger)round(coordinate.latitude / latitudeStep);
+    position.pinLongitude = (NSInteger)round(coordinate.longitude / longitudeStep);
+    
+    return position;
+}
+
++ (MKCoordinateRegion)jsq_regionForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size
+{
+    double logQuantum = log1p(kJSQMessagesMapSnapshotSpanQuantum);
+    MKCoordinateSpan span = MKCoordinateSpanMake(exp(position.latitudeDelta * logQuantum),
+                                                 exp(position.longitudeDelta * logQuantum));
+    
+    double latitudeStep = span.latitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.height;
+    double longitudeStep = span.longitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.width;
+    
+    CLLocationCoordinate2D center = CLLocationCoordinate2DMake(position.latitude * latitudeStep,
+                                                               position.longitude * longitudeStep);
+    
+    return MKCoordinateRegionMake(center, span);
+}
+
++ (CLLocationCoordinate2D)jsq_pinCoordinateForGridPosition:(JSQMessagesMapSnapshotGridPosition)position size:(CGSize)size
+{
+    MKCoordinateRegion region = [self jsq_regionForGridPosition:position size:size];
+    
+    double latitudeStep = region.span.latitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.height;
+    double longitudeStep = region.span.longitudeDelta * kJSQMessagesMapSnapshotQuantumPoints / size.width;
+    
+    return CLLocationCoordinate2DMake(position.pinLatitude * latitudeStep, position.pinLongitude * longitudeStep);
+}
+
+@end
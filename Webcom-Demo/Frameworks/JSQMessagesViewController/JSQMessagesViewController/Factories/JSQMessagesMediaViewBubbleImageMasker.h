@@ -67,6 +67,9 @@
  *  Applies an outgoing bubble image mask to the specified mediaView.
  *
  *  @param mediaView The media view to mask.
+ *
+ *  @discussion Mask images are rendered once per size, direction and bubble image, and kept in a cache
+ *  shared by all maskers. The mask layer already installed on the view by a masker is reused.
  */
 - (void)applyOutgoingBubbleImageMaskToMediaView:(UIView *)mediaView;
 
@@ -77,9 +80,21 @@
  */
 - (void)applyIncomingBubbleImageMaskToMediaView:(UIView *)mediaView;
 
+/**
+ *  Returns the shared masker object, which uses a default instance of `JSQMessagesBubbleImageFactory`.
+ *
+ *  @return The shared masker object.
+ */
++ (JSQMessagesMediaViewBubbleImageMasker *)sharedMasker;
+
+/**
+ *  Empties the cache of rendered mask images shared by all maskers.
+ */
++ (void)removeAllCachedMasks;
+
 /**
  *  A convenience method for applying a bubble image mask to the specified mediaView.
- *  This method uses the default instance of `JSQMessagesBubbleImageFactory`.
+ *  This method uses the shared masker.
  *
  *  @param mediaView  The media view to mask.
  *  @param isOutgoing A boolean value specifiying whether or not the mask should be for an outgoing or incoming view.
@@ -21,9 +21,21 @@
 #import "JSQMessagesBubbleImageFactory.h"
 
 
+static NSString * const kJSQMessagesMediaViewMaskLayerName = @"JSQMessagesMediaViewBubbleImageMask";
+
+
 @interface JSQMessagesMediaViewBubbleImageMasker ()
 
-- (void)jsq_maskView:(UIView *)view withImage:(UIImage *)image;
+@property (copy, nonatomic, readonly) NSString *maskIdentifier;
+
+@property (strong, nonatomic) UIImage *outgoingBubbleImage;
+@property (strong, nonatomic) UIImage *incomingBubbleImage;
+
++ (NSCache *)jsq_maskImageCache;
+
+- (void)jsq_maskView:(UIView *)view withImage:(UIImage *)image isOutgoing:(BOOL)isOutgoing;
+
+- (UIImage *)jsq_maskImageWithBubbleImage:(UIImage *)bubbleImage size:(CGSize)size isOutgoing:(BOOL)isOutgoing;
 
 @end
 
@@ -32,6 +44,18 @@
 
 #pragma mark - Initialization
 
++ (JSQMessagesMediaViewBubbleImageMasker *)sharedMasker
+{
+    static JSQMessagesMediaViewBubbleImageMasker *_sharedMasker = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedMasker = [[JSQMessagesMediaViewBubbleImageMasker alloc] init];
+    });
+    
+    return _sharedMasker;
+}
+
 - (instancetype)init
 {
     return [self initWithBubbleImageFactory:[[JSQMessagesBubbleImageFactory alloc] init]];
@@ -44,27 +68,72 @@
     self = [super init];
     if (self) {
         _bubbleImageFactory = bubbleImageFactory;
+        _maskIdentifier = [[NSUUID UUID] UUIDString];
     }
     return self;
 }
 
+- (void)dealloc
+{
+    _bubbleImageFactory = nil;
+    _outgoingBubbleImage = nil;
+    _incomingBubbleImage = nil;
+}
+
+#pragma mark - Getters
+
+- (UIImage *)outgoingBubbleImage
+{
+    if (_outgoingBubbleImage == nil) {
+        _outgoingBubbleImage = [[self.bubbleImageFactory outgoingMessagesBubbleImageWithColor:[UIColor whiteColor]] messageBubbleImage];
+    }
+    return _outgoingBubbleImage;
+}
+
+- (UIImage *)incomingBubbleImage
+{
+    if (_incomingBubbleImage == nil) {
+        _incomingBubbleImage = [[self.bubbleImageFactory incomingMessagesBubbleImageWithColor:[UIColor whiteColor]] messageBubbleImage];
+    }
+    return _incomingBubbleImage;
+}
+
+#pragma mark - Mask cache
+
++ (NSCache *)jsq_maskImageCache
+{
+    static NSCache *_maskImageCache = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _maskImageCache = [NSCache new];
+        _maskImageCache.name = @"JSQMessagesMediaViewBubbleImageMasker.cache";
+        _maskImageCache.countLimit = 16;
+    });
+    
+    return _maskImageCache;
+}
+
++ (void)removeAllCachedMasks
+{
+    [[self jsq_maskImageCache] removeAllObjects];
+}
+
 #pragma mark - View masking
 
 - (void)applyOutgoingBubbleImageMaskToMediaView:(UIView *)mediaView
 {
-    JSQMessagesBubbleImage *bubbleImageData = [self.bubbleImageFactory outgoingMessagesBubbleImageWithColor:[UIColor whiteColor]];
-    [self jsq_maskView:mediaView withImage:[bubbleImageData messageBubbleImage]];
+    [self jsq_maskView:mediaView withImage:self.outgoingBubbleImage isOutgoing:YES];
 }
 
 - (void)applyIncomingBubbleImageMaskToMediaView:(UIView *)mediaView
 {
-    JSQMessagesBubbleImage *bubbleImageData = [self.bubbleImageFactory incomingMessagesBubbleImageWithColor:[UIColor whiteColor]];
-    [self jsq_maskView:mediaView withImage:[bubbleImageData messageBubbleImage]];
+    [self jsq_maskView:mediaView withImage:self.incomingBubbleImage isOutgoing:NO];
 }
 
 + (void)applyBubbleImageMaskToMediaView:(UIView *)mediaView isOutgoing:(BOOL)isOutgoing
 {
-    JSQMessagesMediaViewBubbleImageMasker *masker = [[JSQMessagesMediaViewBubbleImageMasker alloc] init];
+    JSQMessagesMediaViewBubbleImageMasker *masker = [JSQMessagesMediaViewBubbleImageMasker sharedMasker];
     
     if (isOutgoing) {
         [masker applyOutgoingBubbleImageMaskToMediaView:mediaView];
@@ -76,15 +145,55 @@
 
 #pragma mark - Private
 
-- (void)jsq_maskView:(UIView *)view withImage:(UIImage *)image
+- (void)jsq_maskView:(UIView *)view withImage:(UIImage *)image isOutgoing:(BOOL)isOutgoing
 {
     NSParameterAssert(view != nil);
     NSParameterAssert(image != nil);
     
-    UIImageView *imageViewMask = [[UIImageView alloc] initWithImage:image];
-    imageViewMask.frame = CGRectInset(view.frame, 2.0f, 2.0f);
+    CGRect maskFrame = CGRectInset(view.frame, 2.0f, 2.0f);
+    if (CGRectIsEmpty(maskFrame)) {
+        return;
+    }
+    
+    UIImage *maskImage = [self jsq_maskImageWithBubbleImage:image size:maskFrame.size isOutgoing:isOutgoing];
+    
+    CALayer *maskLayer = view.layer.mask;
+    if (![maskLayer.name isEqualToString:kJSQMessagesMediaViewMaskLayerName]) {
+        maskLayer = [CALayer layer];
+        maskLayer.name = kJSQMessagesMediaViewMaskLayerName;
+    }
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    maskLayer.contents = (__bridge id)maskImage.CGImage;
+    maskLayer.contentsScale = maskImage.scale;
+    maskLayer.frame = maskFrame;
+    [CATransaction commit];
+    
+    view.layer.mask = maskLayer;
+}
+
+- (UIImage *)jsq_maskImageWithBubbleImage:(UIImage *)bubbleImage size:(CGSize)size isOutgoing:(BOOL)isOutgoing
+{
+    NSCache *cache = [JSQMessagesMediaViewBubbleImageMasker jsq_maskImageCache];
+    NSString *key = [NSString stringWithFormat:@"%@-%@-%@", self.maskIdentifier, @(isOutgoing), NSStringFromCGSize(size)];
+    
+    UIImage *maskImage = [cache objectForKey:key];
+    if (maskImage != nil) {
+        return maskImage;
+    }
+    
+    //  render the stretched bubble once, so every view of this size shares the same bitmap
+    UIGraphicsBeginImageContextWithOptions(size, NO, 0.0f);
+    [bubbleImage drawInRect:(CGRect){ CGPointZero, size }];
+    maskImage = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    if (maskImage != nil) {
+        [cache setObject:maskImage forKey:key];
+    }
     
-    view.layer.mask = imageViewMask.layer;
+    return maskImage;
 }
 
 @end
@@ -0,0 +1,163 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The levels of memory pressure a `JSQMessagesMemoryCoordinator` responds to.
+ */
+typedef NS_ENUM(NSUInteger, JSQMessagesMemoryPressureLevel) {
+    /**
+     *  The application received a memory warning. Only caches that are cheap to rebuild are purged,
+     *  until half of the tracked memory is freed.
+     */
+    JSQMessagesMemoryPressureLevelWarning,
+    /**
+     *  The application entered the background. All caches are purged, except the ones that are expensive to rebuild.
+     */
+    JSQMessagesMemoryPressureLevelBackground,
+    /**
+     *  The system reported critical memory pressure, or memory warnings came in quick succession. All caches are purged.
+     */
+    JSQMessagesMemoryPressureLevelCritical
+};
+
+/**
+ *  The cost of rebuilding the contents of a cache after it was purged.
+ */
+typedef NS_ENUM(NSUInteger, JSQMessagesCacheRebuildCost) {
+    /**
+     *  The contents are decoded from local resources.
+     */
+    JSQMessagesCacheRebuildCostLow,
+    /**
+     *  The contents are rendered again, or read back from disk.
+     */
+    JSQMessagesCacheRebuildCostMedium,
+    /**
+     *  The contents require measuring or laying out messages again.
+     */
+    JSQMessagesCacheRebuildCostHigh
+};
+
+/**
+ *  Posted on the main queue after a `JSQMessagesMemoryCoordinator` purged caches.
+ *  The object of the notification is the coordinator.
+ */
+FOUNDATION_EXPORT NSString * const JSQMessagesMemoryCoordinatorDidPurgeCachesNotification;
+
+/**
+ *  The user info key of the `JSQMessagesMemoryPressureLevel` that caused the purge, as an `NSNumber`.
+ */
+FOUNDATION_EXPORT NSString * const JSQMessagesMemoryCoordinatorPressureLevelKey;
+
+/**
+ *  The user info key of an `NSDictionary` mapping the name of each purged cache to the number of bytes it freed, as an `NSNumber`.
+ */
+FOUNDATION_EXPORT NSString * const JSQMessagesMemoryCoordinatorBytesFreedKey;
+
+
+/**
+ *  The `JSQMessagesPurgeableCache` protocol defines the methods a cache implements to be purged
+ *  by a `JSQMessagesMemoryCoordinator`.
+ */
+@protocol JSQMessagesPurgeableCache <NSObject>
+
+@required
+
+/**
+ *  @return A name that identifies the cache in purge reports.
+ */
+- (NSString *)cacheName;
+
+/**
+ *  @return An estimate of the memory used by the cache, in bytes.
+ */
+- (NSUInteger)cacheByteCost;
+
+/**
+ *  @return The cost of rebuilding the contents of the cache once purged.
+ */
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost;
+
+/**
+ *  Removes the contents of the cache. This method is called on the main thread.
+ */
+- (void)purgeCache;
+
+@end
+
+
+/**
+ *  The `JSQMessagesMemoryCoordinator` responds to memory pressure on behalf of all the caches of the library.
+ *
+ *  @discussion Instead of each cache dropping everything on every memory warning, the coordinator evicts caches
+ *  in priority order: the ones that are cheapest to rebuild first and, among them, the largest first.
+ *  It only goes as far as the pressure level requires, so that a single warning does not cause a wave
+ *  of re-measuring and re-rendering.
+ *
+ *  The coordinator listens to memory warnings, to critical memory pressure reported by the system,
+ *  and to the application entering the background. A memory warning that follows the previous one
+ *  within 10 seconds is treated as critical.
+ */
+@interface JSQMessagesMemoryCoordinator : NSObject
+
+/**
+ *  Returns the sum of the byte costs of the registered caches.
+ */
+@property (assign, nonatomic, readonly) NSUInteger totalByteCost;
+
+/**
+ *  Returns the shared memory coordinator object.
+ *
+ *  @return The shared memory coordinator object.
+ */
++ (JSQMessagesMemoryCoordinator *)sharedCoordinator;
+
+/**
+ *  Registers a cache with the coordinator. The cache is not retained.
+ *
+ *  @param cache The cache to register. This value must not be `nil`.
+ *
+ *  @discussion This method can be called from any thread. Off the main thread, the cache is registered asynchronously.
+ */
+- (void)registerCache:(id<JSQMessagesPurgeableCache>)cache;
+
+/**
+ *  Unregisters a cache from the coordinator.
+ *
+ *  @param cache The cache to unregister. This value must not be `nil`.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (void)unregisterCache:(id<JSQMessagesPurgeableCache>)cache;
+
+/**
+ *  Purges the registered caches as required by the given level of memory pressure,
+ *  and posts a `JSQMessagesMemoryCoordinatorDidPurgeCachesNotification`.
+ *
+ *  @param level The level of memory pressure.
+ *
+ *  @return A dictionary mapping the name of each purged cache to the number of bytes it freed, as an `NSNumber`.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (NSDictionary *)purgeCachesForMemoryPressureLevel:(JSQMessagesMemoryPressureLevel)level;
+
+@end
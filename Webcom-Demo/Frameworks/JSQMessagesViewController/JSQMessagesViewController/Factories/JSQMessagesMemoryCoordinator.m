@@ -0,0 +1,226 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesMemoryCoordinator.h"
+
+#import <UIKit/UIKit.h>
+
+
+NSString * const JSQMessagesMemoryCoordinatorDidPurgeCachesNotification = @"JSQMessagesMemoryCoordinatorDidPurgeCachesNotification";
+NSString * const JSQMessagesMemoryCoordinatorPressureLevelKey = @"JSQMessagesMemoryCoordinatorPressureLevelKey";
+NSString * const JSQMessagesMemoryCoordinatorBytesFreedKey = @"JSQMessagesMemoryCoordinatorBytesFreedKey";
+
+static const NSTimeInterval kJSQMessagesMemoryCoordinatorEscalationInterval = 10.0;
+
+
+@interface JSQMessagesMemoryCoordinator ()
+
+@property (strong, nonatomic, readonly) NSHashTable *caches;
+
+@property (strong, nonatomic, readonly) dispatch_source_t memoryPressureSource;
+
+@property (strong, nonatomic) NSDate *lastMemoryWarningDate;
+
+- (NSArray *)jsq_cachesToPurgeForMemoryPressureLevel:(JSQMessagesMemoryPressureLevel)level;
+
+- (void)jsq_didReceiveMemoryWarningNotification:(NSNotification *)notification;
+- (void)jsq_didEnterBackgroundNotification:(NSNotification *)notification;
+
+@end
+
+
+
+@implementation JSQMessagesMemoryCoordinator
+
+#pragma mark - Initialization
+
++ (JSQMessagesMemoryCoordinator *)sharedCoordinator
+{
+    static JSQMessagesMemoryCoordinator *_sharedCoordinator = nil;
+
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedCoordinator = [[JSQMessagesMemoryCoordinator alloc] init];
+    });
+
+    return _sharedCoordinator;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _caches = [NSHashTable weakObjectsHashTable];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(jsq_didReceiveMemoryWarningNotification:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(jsq_didEnterBackgroundNotification:)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+
+        __weak JSQMessagesMemoryCoordinator *weakSelf = self;
+        _memoryPressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+                                                       0,
+                                                       DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                       dispatch_get_main_queue());
+        dispatch_source_set_event_handler(_memoryPressureSource, ^{
+            [weakSelf purgeCachesForMemoryPressureLevel:JSQMessagesMemoryPressureLevelCritical];
+        });
+        dispatch_resume(_memoryPressureSource);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    dispatch_source_cancel(_memoryPressureSource);
+    _memoryPressureSource = nil;
+    _caches = nil;
+    _lastMemoryWarningDate = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: caches=%@, totalByteCost=%@>",
+            [self class], @(self.caches.count), @(self.totalByteCost)];
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalByteCost
+{
+    NSUInteger totalByteCost = 0;
+    for (id<JSQMessagesPurgeableCache> eachCache in self.caches) {
+        totalByteCost += [eachCache cacheByteCost];
+    }
+    return totalByteCost;
+}
+
+#pragma mark - Caches
+
+- (void)registerCache:(id<JSQMessagesPurgeableCache>)cache
+{
+    NSParameterAssert(cache != nil);
+
+    //  shared caches may be created on any thread, the registry itself is only touched on the main thread
+    if (![NSThread isMainThread]) {
+        __weak id<JSQMessagesPurgeableCache> weakCache = cache;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            id<JSQMessagesPurgeableCache> strongCache = weakCache;
+            if (strongCache != nil) {
+                [self registerCache:strongCache];
+            }
+        });
+        return;
+    }
+
+    [self.caches addObject:cache];
+}
+
+- (void)unregisterCache:(id<JSQMessagesPurgeableCache>)cache
+{
+    NSParameterAssert(cache != nil);
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+    [self.caches removeObject:cache];
+}
+
+- (NSDictionary *)purgeCachesForMemoryPressureLevel:(JSQMessagesMemoryPressureLevel)level
+{
+    NSAssert([NSThread isMainThread], @"%s must be called on the main thread", __PRETTY_FUNCTION__);
+
+    NSMutableDictionary *bytesFreed = [NSMutableDictionary new];
+
+    for (id<JSQMessagesPurgeableCache> eachCache in [self jsq_cachesToPurgeForMemoryPressureLevel:level]) {
+        NSUInteger byteCost = [eachCache cacheByteCost];
+        [eachCache purgeCache];
+
+        NSUInteger remainingByteCost = MIN([eachCache cacheByteCost], byteCost);
+        [bytesFreed setObject:@(byteCost - remainingByteCost) forKey:[eachCache cacheName]];
+    }
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:JSQMessagesMemoryCoordinatorDidPurgeCachesNotification
+                                                        object:self
+                                                      userInfo:@{ JSQMessagesMemoryCoordinatorPressureLevelKey : @(level),
+                                                                  JSQMessagesMemoryCoordinatorBytesFreedKey : [bytesFreed copy] }];
+
+    return [bytesFreed copy];
+}
+
+- (NSArray *)jsq_cachesToPurgeForMemoryPressureLevel:(JSQMessagesMemoryPressureLevel)level
+{
+    //  cheapest to rebuild first, then largest first
+    NSArray *caches = [[self.caches allObjects] sortedArrayUsingComparator:^NSComparisonResult(id<JSQMessagesPurgeableCache> cache1, id<JSQMessagesPurgeableCache> cache2) {
+        if ([cache1 cacheRebuildCost] != [cache2 cacheRebuildCost]) {
+            return ([cache1 cacheRebuildCost] < [cache2 cacheRebuildCost]) ? NSOrderedAscending : NSOrderedDescending;
+        }
+
+        if ([cache1 cacheByteCost] != [cache2 cacheByteCost]) {
+            return ([cache1 cacheByteCost] > [cache2 cacheByteCost]) ? NSOrderedAscending : NSOrderedDescending;
+        }
+
+        return NSOrderedSame;
+    }];
+
+    if (level == JSQMessagesMemoryPressureLevelCritical) {
+        return caches;
+    }
+
+    NSMutableArray *cachesToPurge = [NSMutableArray new];
+
+    NSUInteger targetByteCount = (level == JSQMessagesMemoryPressureLevelWarning) ? self.totalByteCost / 2 : NSUIntegerMax;
+    NSUInteger byteCount = 0;
+
+    for (id<JSQMessagesPurgeableCache> eachCache in caches) {
+        if ([eachCache cacheRebuildCost] == JSQMessagesCacheRebuildCostHigh || byteCount >= targetByteCount) {
+            break;
+        }
+
+        [cachesToPurge addObject:eachCache];
+        byteCount += [eachCache cacheByteCost];
+    }
+
+    return cachesToPurge;
+}
+
+#pragma mark - Notifications
+
+- (void)jsq_didReceiveMemoryWarningNotification:(NSNotification *)notification
+{
+    NSDate *now = [NSDate date];
+
+    BOOL isRepeatedWarning = (self.lastMemoryWarningDate != nil
+                              && [now timeIntervalSinceDate:self.lastMemoryWarningDate] < kJSQMessagesMemoryCoordinatorEscalationInterval);
+    self.lastMemoryWarningDate = now;
+
+    [self purgeCachesForMemoryPressureLevel:(isRepeatedWarning ? JSQMessagesMemoryPressureLevelCritical : JSQMessagesMemoryPressureLevelWarning)];
+}
+
+- (void)jsq_didEnterBackgroundNotification:(NSNotification *)notification
+{
+    [self purgeCachesForMemoryPressureLevel:JSQMessagesMemoryPressureLevelBackground];
+}
+
+@end
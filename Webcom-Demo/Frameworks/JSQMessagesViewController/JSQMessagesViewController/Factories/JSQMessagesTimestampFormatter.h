@@ -23,11 +23,17 @@
  *  An instance of `JSQMessagesTimestampFormatter` is a singleton object that provides an efficient means 
  *  for creating attributed and non-attributed string representations of `NSDate` objects. 
  *  It is intended to be used as the method by which you display timestamps in a `JSQMessagesCollectionView`.
+ *
+ *  @discussion Each style has its own date formatter, and relative days and attributed timestamps are cached
+ *  per calendar day and per minute. All methods are thread-safe, so timestamps can be computed in background render pipelines.
  */
 @interface JSQMessagesTimestampFormatter : NSObject
 
 /**
- *  Returns the cached date formatter object used by the `JSQMessagesTimestampFormatter` shared instance.
+ *  Returns the cached date formatter object used by `timestampForDate:`.
+ *  It uses `NSDateFormatterMediumStyle` for the date style and `NSDateFormatterShortStyle` for the time style.
+ *
+ *  @warning Do not change the properties of this formatter, other threads may be using it.
  */
 @property (strong, nonatomic, readonly) NSDateFormatter *dateFormatter;
 
@@ -92,4 +98,10 @@
  */
 - (NSString *)relativeDateForDate:(NSDate *)date;
 
+/**
+ *  Removes the cached relative dates and attributed timestamps.
+ *  They are formatted again on demand.
+ */
+- (void)removeAllCachedStrings;
+
 @end
@@ -22,12 +22,31 @@
 
 @property (strong, nonatomic, readwrite) NSDateFormatter *dateFormatter;
 
+@property (strong, nonatomic, readonly) NSDateFormatter *timeFormatter;
+
+@property (strong, nonatomic, readonly) NSDateFormatter *relativeDateFormatter;
+
+@property (strong, nonatomic, readonly) NSCache *relativeDateCache;
+
+@property (strong, nonatomic, readonly) NSCache *attributedTimestampCache;
+
++ (NSDateFormatter *)jsq_dateFormatterWithDateStyle:(NSDateFormatterStyle)dateStyle timeStyle:(NSDateFormatterStyle)timeStyle;
+
++ (NSString *)jsq_stringFromDate:(NSDate *)date withFormatter:(NSDateFormatter *)formatter;
+
++ (long)jsq_localDayForDate:(NSDate *)date;
+
++ (long)jsq_localMinuteForDate:(NSDate *)date;
+
 @end
 
 
 
 @implementation JSQMessagesTimestampFormatter
 
+@synthesize dateTextAttributes = _dateTextAttributes;
+@synthesize timeTextAttributes = _timeTextAttributes;
+
 #pragma mark - Initialization
 
 + (JSQMessagesTimestampFormatter *)sharedFormatter
@@ -46,9 +65,21 @@
 {
     self = [super init];
     if (self) {
-        _dateFormatter = [[NSDateFormatter alloc] init];
-        [_dateFormatter setLocale:[NSLocale currentLocale]];
-        [_dateFormatter setDoesRelativeDateFormatting:YES];
+        //  one formatter per style, changing the styles of a shared formatter is slow and not thread-safe
+        _dateFormatter = [JSQMessagesTimestampFormatter jsq_dateFormatterWithDateStyle:NSDateFormatterMediumStyle
+                                                                             timeStyle:NSDateFormatterShortStyle];
+        _timeFormatter = [JSQMessagesTimestampFormatter jsq_dateFormatterWithDateStyle:NSDateFormatterNoStyle
+                                                                             timeStyle:NSDateFormatterShortStyle];
+        _relativeDateFormatter = [JSQMessagesTimestampFormatter jsq_dateFormatterWithDateStyle:NSDateFormatterMediumStyle
+                                                                                     timeStyle:NSDateFormatterNoStyle];
+        
+        _relativeDateCache = [NSCache new];
+        _relativeDateCache.name = @"JSQMessagesTimestampFormatter.relativeDateCache";
+        _relativeDateCache.countLimit = 64;
+        
+        _attributedTimestampCache = [NSCache new];
+        _attributedTimestampCache.name = @"JSQMessagesTimestampFormatter.attributedTimestampCache";
+        _attributedTimestampCache.countLimit = 256;
         
         UIColor *color = [UIColor lightGrayColor];
         
@@ -69,10 +100,48 @@
 - (void)dealloc
 {
     _dateFormatter = nil;
+    _timeFormatter = nil;
+    _relativeDateFormatter = nil;
+    _relativeDateCache = nil;
+    _attributedTimestampCache = nil;
     _dateTextAttributes = nil;
     _timeTextAttributes = nil;
 }
 
+#pragma mark - Setters
+
+- (void)setDateTextAttributes:(NSDictionary *)dateTextAttributes
+{
+    @synchronized(self) {
+        _dateTextAttributes = [dateTextAttributes copy];
+        [self.attributedTimestampCache removeAllObjects];
+    }
+}
+
+- (void)setTimeTextAttributes:(NSDictionary *)timeTextAttributes
+{
+    @synchronized(self) {
+        _timeTextAttributes = [timeTextAttributes copy];
+        [self.attributedTimestampCache removeAllObjects];
+    }
+}
+
+#pragma mark - Getters
+
+- (NSDictionary *)dateTextAttributes
+{
+    @synchronized(self) {
+        return _dateTextAttributes;
+    }
+}
+
+- (NSDictionary *)timeTextAttributes
+{
+    @synchronized(self) {
+        return _timeTextAttributes;
+    }
+}
+
 #pragma mark - Formatter
 
 - (NSString *)timestampForDate:(NSDate *)date
@@ -81,9 +150,7 @@
         return nil;
     }
     
-    [self.dateFormatter setDateStyle:NSDateFormatterMediumStyle];
-    [self.dateFormatter setTimeStyle:NSDateFormatterShortStyle];
-    return [self.dateFormatter stringFromDate:date];
+    return [JSQMessagesTimestampFormatter jsq_stringFromDate:date withFormatter:self.dateFormatter];
 }
 
 - (NSAttributedString *)attributedTimestampForDate:(NSDate *)date
@@ -92,18 +159,45 @@
         return nil;
     }
     
+    //  the string only depends on the minute, and on the current day for the relative part
+    NSString *key = [NSString stringWithFormat:@"%ld-%ld",
+                     [JSQMessagesTimestampFormatter jsq_localMinuteForDate:date],
+                     [JSQMessagesTimestampFormatter jsq_localDayForDate:[NSDate date]]];
+    
+    NSAttributedString *cachedTimestamp = [self.attributedTimestampCache objectForKey:key];
+    if (cachedTimestamp != nil) {
+        return cachedTimestamp;
+    }
+    
     NSString *relativeDate = [self relativeDateForDate:date];
     NSString *time = [self timeForDate:date];
     
+    NSDictionary *dateTextAttributes = nil;
+    NSDictionary *timeTextAttributes = nil;
+    
+    @synchronized(self) {
+        dateTextAttributes = _dateTextAttributes;
+        timeTextAttributes = _timeTextAttributes;
+    }
+    
     NSMutableAttributedString *timestamp = [[NSMutableAttributedString alloc] initWithString:relativeDate
-                                                                                  attributes:self.dateTextAttributes];
+                                                                                  attributes:dateTextAttributes];
     
     [timestamp appendAttributedString:[[NSAttributedString alloc] initWithString:@" "]];
     
     [timestamp appendAttributedString:[[NSAttributedString alloc] initWithString:time
-                                                                      attributes:self.timeTextAttributes]];
+                                                                      attributes:timeTextAttributes]];
     
-    return [[NSAttributedString alloc] initWithAttributedString:timestamp];
+    NSAttributedString *attributedTimestamp = [[NSAttributedString alloc] initWithAttributedString:timestamp];
+    
+    @synchronized(self) {
+        //  skip caching if the attributes changed while formatting
+        if (dateTextAttributes == _dateTextAttributes && timeTextAttributes == _timeTextAttributes) {
+            [self.attributedTimestampCache setObject:attributedTimestamp forKey:key];
+        }
+    }
+    
+    return attributedTimestamp;
 }
 
 - (NSString *)timeForDate:(NSDate *)date
@@ -112,9 +206,7 @@
         return nil;
     }
     
-    [self.dateFormatter setDateStyle:NSDateFormatterNoStyle];
-    [self.dateFormatter setTimeStyle:NSDateFormatterShortStyle];
-    return [self.dateFormatter stringFromDate:date];
+    return [JSQMessagesTimestampFormatter jsq_stringFromDate:date withFormatter:self.timeFormatter];
 }
 
 - (NSString *)relativeDateForDate:(NSDate *)date
@@ -123,9 +215,55 @@
         return nil;
     }
     
-    [self.dateFormatter setDateStyle:NSDateFormatterMediumStyle];
-    [self.dateFormatter setTimeStyle:NSDateFormatterNoStyle];
-    return [self.dateFormatter stringFromDate:date];
+    //  "Today" and "Yesterday" depend on the current day as well
+    NSString *key = [NSString stringWithFormat:@"%ld-%ld",
+                     [JSQMessagesTimestampFormatter jsq_localDayForDate:date],
+                     [JSQMessagesTimestampFormatter jsq_localDayForDate:[NSDate date]]];
+    
+    NSString *relativeDate = [self.relativeDateCache objectForKey:key];
+    if (relativeDate == nil) {
+        relativeDate = [JSQMessagesTimestampFormatter jsq_stringFromDate:date withFormatter:self.relativeDateFormatter];
+        [self.relativeDateCache setObject:relativeDate forKey:key];
+    }
+    
+    return relativeDate;
+}
+
+- (void)removeAllCachedStrings
+{
+    [self.relativeDateCache removeAllObjects];
+    [self.attributedTimestampCache removeAllObjects];
+}
+
+#pragma mark - Utilities
+
++ (NSDateFormatter *)jsq_dateFormatterWithDateStyle:(NSDateFormatterStyle)dateStyle timeStyle:(NSDateFormatterStyle)timeStyle
+{
+    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+    [dateFormatter setLocale:[NSLocale currentLocale]];
+    [dateFormatter setDoesRelativeDateFormatting:YES];
+    [dateFormatter setDateStyle:dateStyle];
+    [dateFormatter setTimeStyle:timeStyle];
+    return dateFormatter;
+}
+
++ (NSString *)jsq_stringFromDate:(NSDate *)date withFormatter:(NSDateFormatter *)formatter
+{
+    @synchronized(formatter) {
+        return [formatter stringFromDate:date];
+    }
+}
+
++ (long)jsq_localDayForDate:(NSDate *)date
+{
+    NSTimeInterval localTime = [date timeIntervalSinceReferenceDate] + [[NSTimeZone localTimeZone] secondsFromGMTForDate:date];
+    return (long)floor(localTime / (24.0 * 60.0 * 60.0));
+}
+
++ (long)jsq_localMinuteForDate:(NSDate *)date
+{
+    NSTimeInterval localTime = [date timeIntervalSinceReferenceDate] + [[NSTimeZone localTimeZone] secondsFromGMTForDate:date];
+    return (long)floor(localTime / 60.0);
 }
 
 @end
@@ -0,0 +1,220 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#include "JSQMessagesTintKernel.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define JSQ_TINT_KERNEL_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define JSQ_TINT_KERNEL_SSE2 1
+#endif
+
+
+//  round(value / 255) for value in [0, 255 * 255], without a division
+static inline uint8_t jsq_divideBy255(uint32_t value)
+{
+    value += 128;
+    return (uint8_t)((value + (value >> 8)) >> 8);
+}
+
+static inline void jsq_premultiplyColor(JSQMessagesTintColor color, uint8_t premultiplied[4])
+{
+    premultiplied[0] = jsq_divideBy255((uint32_t)color.red * color.alpha);
+    premultiplied[1] = jsq_divideBy255((uint32_t)color.green * color.alpha);
+    premultiplied[2] = jsq_divideBy255((uint32_t)color.blue * color.alpha);
+    premultiplied[3] = color.alpha;
+}
+
+static inline void jsq_tintPixels(const uint8_t *mask,
+                                  size_t count,
+                                  const uint8_t premultiplied[4],
+                                  uint8_t *destination)
+{
+    for (size_t i = 0; i < count; i++) {
+        uint32_t maskValue = mask[i];
+        destination[4 * i + 0] = jsq_divideBy255(maskValue * premultiplied[0]);
+        destination[4 * i + 1] = jsq_divideBy255(maskValue * premultiplied[1]);
+        destination[4 * i + 2] = jsq_divideBy255(maskValue * premultiplied[2]);
+        destination[4 * i + 3] = jsq_divideBy255(maskValue * premultiplied[3]);
+    }
+}
+
+
+#if JSQ_TINT_KERNEL_NEON
+
+static inline uint8x8_t jsq_divideBy255x8(uint16x8_t value)
+{
+    //  (value + ((value + 128) >> 8) + 128) >> 8, the same rounding as jsq_divideBy255
+    return vrshrn_n_u16(vrsraq_n_u16(value, value, 8), 8);
+}
+
+static inline uint8x16_t jsq_multiplyBy255x16(uint8x16_t mask, uint8x8_t component)
+{
+    uint8x8_t low = jsq_divideBy255x8(vmull_u8(vget_low_u8(mask), component));
+    uint8x8_t high = jsq_divideBy255x8(vmull_u8(vget_high_u8(mask), component));
+    return vcombine_u8(low, high);
+}
+
+//  tints 16 pixels at a time, returns the number of pixels done
+static size_t jsq_tintRowVector(const uint8_t *mask,
+                                size_t width,
+                                const uint8_t color[4],
+                                uint8_t *destination,
+                                const uint8_t highlightedColor[4],
+                                uint8_t *highlightedDestination)
+{
+    uint8x8_t components[4] = { vdup_n_u8(color[0]), vdup_n_u8(color[1]), vdup_n_u8(color[2]), vdup_n_u8(color[3]) };
+    uint8x8_t highlightedComponents[4] = { vdup_n_u8(highlightedColor[0]), vdup_n_u8(highlightedColor[1]),
+                                           vdup_n_u8(highlightedColor[2]), vdup_n_u8(highlightedColor[3]) };
+    size_t x = 0;
+    
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t maskValues = vld1q_u8(mask + x);
+        
+        uint8x16x4_t pixels;
+        for (int k = 0; k < 4; k++) {
+            pixels.val[k] = jsq_multiplyBy255x16(maskValues, components[k]);
+        }
+        vst4q_u8(destination + 4 * x, pixels);
+        
+        if (highlightedDestination != NULL) {
+            for (int k = 0; k < 4; k++) {
+                pixels.val[k] = jsq_multiplyBy255x16(maskValues, highlightedComponents[k]);
+            }
+            vst4q_u8(highlightedDestination + 4 * x, pixels);
+        }
+    }
+    
+    return x;
+}
+
+#elif JSQ_TINT_KERNEL_SSE2
+
+static inline __m128i jsq_divideBy255x8(__m128i value)
+{
+    __m128i rounded = _mm_add_epi16(value, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+}
+
+//  tints 4 pixels whose mask values are in the low four 16-bit lanes of maskValues
+static inline __m128i jsq_tintFourPixels(__m128i maskValues, __m128i color)
+{
+    //  m0 m0 m1 m1 m2 m2 m3 m3, then m0 x4 m1 x4 and m2 x4 m3 x4
+    __m128i pairs = _mm_unpacklo_epi16(maskValues, maskValues);
+    __m128i low = _mm_unpacklo_epi32(pairs, pairs);
+    __m128i high = _mm_unpackhi_epi32(pairs, pairs);
+    
+    low = jsq_divideBy255x8(_mm_mullo_epi16(low, color));
+    high = jsq_divideBy255x8(_mm_mullo_epi16(high, color));
+    
+    return _mm_packus_epi16(low, high);
+}
+
+static inline void jsq_tintSixteenPixels(__m128i maskValues, __m128i color, uint8_t *destination)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_unpacklo_epi8(maskValues, zero);
+    __m128i high = _mm_unpackhi_epi8(maskValues, zero);
+    
+    _mm_storeu_si128((__m128i *)(destination + 0), jsq_tintFourPixels(low, color));
+    _mm_storeu_si128((__m128i *)(destination + 16), jsq_tintFourPixels(_mm_srli_si128(low, 8), color));
+    _mm_storeu_si128((__m128i *)(destination + 32), jsq_tintFourPixels(high, color));
+    _mm_storeu_si128((__m128i *)(destination + 48), jsq_tintFourPixels(_mm_srli_si128(high, 8), color));
+}
+
+//  tints 16 pixels at a time, returns the number of pixels done
+static size_t jsq_tintRowVector(const uint8_t *mask,
+                                size_t width,
+                                const uint8_t color[4],
+                                uint8_t *destination,
+                                const uint8_t highlightedColor[4],
+                                uint8_t *highlightedDestination)
+{
+    __m128i colorValues = _mm_setr_epi16(color[0], color[1], color[2], color[3],
+                                         color[0], color[1], color[2], color[3]);
+    __m128i highlightedColorValues = _mm_setr_epi16(highlightedColor[0], highlightedColor[1], highlightedColor[2], highlightedColor[3],
+                                                    highlightedColor[0], highlightedColor[1], highlightedColor[2], highlightedColor[3]);
+    size_t x = 0;
+    
+    for (; x + 16 <= width; x += 16) {
+        __m128i maskValues = _mm_loadu_si128((const __m128i *)(mask + x));
+        
+        jsq_tintSixteenPixels(maskValues, colorValues, destination + 4 * x);
+        
+        if (highlightedDestination != NULL) {
+            jsq_tintSixteenPixels(maskValues, highlightedColorValues, highlightedDestination + 4 * x);
+        }
+    }
+    
+    return x;
+}
+
+#else
+
+static size_t jsq_tintRowVector(const uint8_t *mask,
+                                size_t width,
+                                const uint8_t color[4],
+                                uint8_t *destination,
+                                const uint8_t highlightedColor[4],
+                                uint8_t *highlightedDestination)
+{
+    (void)mask;
+    (void)width;
+    (void)color;
+    (void)destination;
+    (void)highlightedColor;
+    (void)highlightedDestination;
+    return 0;
+}
+
+#endif
+
+
+void JSQMessagesTintKernelApply(const uint8_t *mask,
+                                size_t maskBytesPerRow,
+                                size_t width,
+                                size_t height,
+                                JSQMessagesTintColor color,
+                                uint8_t *destination,
+                                JSQMessagesTintColor highlightedColor,
+                                uint8_t *highlightedDestination,
+                                size_t destinationBytesPerRow)
+{
+    uint8_t premultipliedColor[4];
+    uint8_t premultipliedHighlightedColor[4];
+    
+    jsq_premultiplyColor(color, premultipliedColor);
+    jsq_premultiplyColor(highlightedColor, premultipliedHighlightedColor);
+    
+    for (size_t y = 0; y < height; y++) {
+        const uint8_t *maskRow = mask + y * maskBytesPerRow;
+        uint8_t *row = destination + y * destinationBytesPerRow;
+        uint8_t *highlightedRow = (highlightedDestination != NULL) ? highlightedDestination + y * destinationBytesPerRow : NULL;
+        
+        size_t x = jsq_tintRowVector(maskRow, width, premultipliedColor, row, premultipliedHighlightedColor, highlightedRow);
+        
+        jsq_tintPixels(maskRow + x, width - x, premultipliedColor, row + 4 * x);
+        
+        if (highlightedRow != NULL) {
+            jsq_tintPixels(maskRow + x, width - x, premultipliedHighlightedColor, highlightedRow + 4 * x);
+        }
+    }
+}
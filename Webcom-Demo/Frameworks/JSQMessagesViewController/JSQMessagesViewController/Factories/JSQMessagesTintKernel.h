@@ -0,0 +1,73 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#ifndef JSQMessagesTintKernel_h
+#define JSQMessagesTintKernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A color with 8-bit, non-premultiplied components.
+ */
+typedef struct JSQMessagesTintColor {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t alpha;
+} JSQMessagesTintColor;
+
+/**
+ *  Tints an 8-bit alpha mask with one or two colors in a single pass.
+ *
+ *  Each destination pixel is the color premultiplied by its own alpha and by the mask value, rounded to nearest.
+ *  This matches filling a rect clipped to the mask with CoreGraphics.
+ *  Destination pixels are stored as premultiplied RGBA, 4 bytes per pixel in `R, G, B, A` order.
+ *
+ *  The kernel is plain C with NEON and SSE2 fast paths. It has no dependency on CoreGraphics and can be called from any thread.
+ *
+ *  @param mask                    The alpha mask, one byte per pixel. This value must not be `NULL`.
+ *  @param maskBytesPerRow         The number of bytes per row of the mask, at least `width`.
+ *  @param width                   The width of the mask and destination buffers, in pixels.
+ *  @param height                  The height of the mask and destination buffers, in pixels.
+ *  @param color                   The tint color of the normal buffer.
+ *  @param destination             The normal destination buffer. This value must not be `NULL`.
+ *  @param highlightedColor        The tint color of the highlighted buffer. Ignored if `highlightedDestination` is `NULL`.
+ *  @param highlightedDestination  The highlighted destination buffer, or `NULL` to only produce the normal buffer.
+ *  @param destinationBytesPerRow  The number of bytes per row of both destination buffers, at least `4 * width`.
+ */
+void JSQMessagesTintKernelApply(const uint8_t *mask,
+                                size_t maskBytesPerRow,
+                                size_t width,
+                                size_t height,
+                                JSQMessagesTintColor color,
+                                uint8_t *destination,
+                                JSQMessagesTintColor highlightedColor,
+                                uint8_t *highlightedDestination,
+                                size_t destinationBytesPerRow);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+#import "JSQMessagesLoadRequest.h"
+
+@class AVAsset;
+
+/**
+ *  A `JSQMessagesVideoPosterGenerator` object produces poster frames for video media views.
+ *  Frames are extracted with `AVAssetImageGenerator` on a background queue, at most `maxConcurrentGenerationCount`
+ *  at a time, and are kept in a memory cache and in a disk cache keyed by file URL and pixel size.
+ */
+@interface JSQMessagesVideoPosterGenerator : NSObject
+
+/**
+ *  The maximum total cost, in bytes, of the decoded poster frames kept in the memory cache.
+ *  The default value is 16 MB.
+ */
+@property (assign, nonatomic) NSUInteger totalCostLimit;
+
+/**
+ *  The maximum number of videos read at the same time. The default value is `2`.
+ */
+@property (assign, nonatomic) NSInteger maxConcurrentGenerationCount;
+
+/**
+ *  The time, in seconds, of the frame to use as a poster. Videos shorter than twice this value use their middle frame.
+ *  The nearest keyframe is accepted, so that only one frame needs to be decoded. The default value is `1.0`.
+ */
+@property (assign, nonatomic) NSTimeInterval posterTimeHint;
+
+/**
+ *  Returns the shared poster generator object.
+ *
+ *  @return The shared poster generator object.
+ */
++ (JSQMessagesVideoPosterGenerator *)sharedGenerator;
+
+/**
+ *  Returns the poster frame held in the memory cache for the given video and size, if any.
+ *
+ *  @param fileURL   The URL of the video. This value must not be `nil`.
+ *  @param pixelSize The size, in pixels, that the poster frame must fill.
+ *
+ *  @return The poster frame, or `nil` if it is not in the memory cache.
+ */
+- (UIImage *)cachedPosterForFileURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize;
+
+/**
+ *  Asynchronously generates the poster frame of the given video.
+ *  Concurrent requests for the same video and size are coalesced into a single generation.
+ *
+ *  @param fileURL    The URL of the video. This value must not be `nil`.
+ *  @param pixelSize  The size, in pixels, that the poster frame must fill.
+ *  @param completion A block called on the main queue with the poster frame, or `nil` if the video could not be read.
+ *  If the poster frame is already in the memory cache, the block is called synchronously. May be `nil`.
+ *
+ *  @return A request identifying this caller, to pass to `cancelPosterRequest:`,
+ *  or `nil` if the completion block was called synchronously.
+ *
+ *  @discussion This method must be called on the main thread.
+ */
+- (JSQMessagesLoadRequest *)generatePosterForFileURL:(NSURL *)fileURL
+                                           pixelSize:(CGSize)pixelSize
+                                          completion:(void (^)(UIImage *poster))completion;
+
+/**
+ *  Cancels the given poster request. Other requests for the same video and size are not affected,
+ *  and the generation is only cancelled when no request is waiting on it anymore and it has not started yet.
+ *
+ *  @param request A request returned by `generatePosterForFileURL:pixelSize:completion:`. May be `nil`.
+ */
+- (void)cancelPosterRequest:(JSQMessagesLoadRequest *)request;
+
+/**
+ *  Empties the memory cache. The disk cache is left untouched.
+ */
+- (void)removeAllCachedPosters;
+
+/**
+ *  Synchronously extracts a poster frame from the given asset.
+ *
+ *  @param asset     The video asset. This value must not be `nil`.
+ *  @param time      The requested time of the frame, in seconds. The nearest keyframe is accepted.
+ *  @param pixelSize The size, in pixels, that the poster frame must fill when displayed with an aspect fill content mode.
+ *  @param scale     The scale of the returned image.
+ *
+ *  @return The poster frame, or `nil` if the asset has no video track or could not be read.
+ */
++ (UIImage *)posterImageForAsset:(AVAsset *)asset
+                          atTime:(NSTimeInterval)time
+                       pixelSize:(CGSize)pixelSize
+                           scale:(CGFloat)scale;
+
+@end
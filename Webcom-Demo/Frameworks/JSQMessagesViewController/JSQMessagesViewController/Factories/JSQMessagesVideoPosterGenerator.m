@@ -0,0 +1,183 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesVideoPosterGenerator.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "JSQMessagesImageLoader.h"
+
+
+@interface JSQMessagesVideoPosterGenerator ()
+
+@property (strong, nonatomic, readonly) JSQMessagesImageLoader *loader;
+
+- (NSString *)jsq_keyForFileURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize;
+
+@end
+
+
+
+@implementation JSQMessagesVideoPosterGenerator
+
+#pragma mark - Initialization
+
++ (JSQMessagesVideoPosterGenerator *)sharedGenerator
+{
+    static JSQMessagesVideoPosterGenerator *_sharedGenerator = nil;
+    
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedGenerator = [[JSQMessagesVideoPosterGenerator alloc] init];
+    });
+    
+    return _sharedGenerator;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _loader = [[JSQMessagesImageLoader alloc] initWithName:@"VideoPosters"];
+        _loader.totalCostLimit = 16 * 1024 * 1024;
+        _loader.maxConcurrentLoadCount = 2;
+        
+        _posterTimeHint = 1.0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _loader = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.loader.totalCostLimit = totalCostLimit;
+}
+
+- (void)setMaxConcurrentGenerationCount:(NSInteger)maxConcurrentGenerationCount
+{
+    self.loader.maxConcurrentLoadCount = maxConcurrentGenerationCount;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)totalCostLimit
+{
+    return self.loader.totalCostLimit;
+}
+
+- (NSInteger)maxConcurrentGenerationCount
+{
+    return self.loader.maxConcurrentLoadCount;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: totalCostLimit=%@, maxConcurrentGenerationCount=%@, posterTimeHint=%@>",
+            [self class], @(self.totalCostLimit), @(self.maxConcurrentGenerationCount), @(self.posterTimeHint)];
+}
+
+#pragma mark - Generating posters
+
+- (UIImage *)cachedPosterForFileURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize
+{
+    return [self.loader cachedImageForKey:[self jsq_keyForFileURL:fileURL pixelSize:pixelSize]];
+}
+
+- (JSQMessagesLoadRequest *)generatePosterForFileURL:(NSURL *)fileURL
+                                           pixelSize:(CGSize)pixelSize
+                                          completion:(void (^)(UIImage *poster))completion
+{
+    NSTimeInterval posterTimeHint = self.posterTimeHint;
+    
+    return [self.loader loadImageForKey:[self jsq_keyForFileURL:fileURL pixelSize:pixelSize] sourceFileURL:fileURL usingBlock:^UIImage *(CGFloat scale) {
+        AVURLAsset *asset = [AVURLAsset URLAssetWithURL:fileURL options:nil];
+        return [JSQMessagesVideoPosterGenerator posterImageForAsset:asset atTime:posterTimeHint pixelSize:pixelSize scale:scale];
+    } completion:completion];
+}
+
+- (void)cancelPosterRequest:(JSQMessagesLoadRequest *)request
+{
+    [self.loader cancelLoadRequest:request];
+}
+
+- (void)removeAllCachedPosters
+{
+    [self.loader removeAllCachedImages];
+}
+
+- (NSString *)jsq_keyForFileURL:(NSURL *)fileURL pixelSize:(CGSize)pixelSize
+{
+    NSParameterAssert(fileURL != nil);
+    return [NSString stringWithFormat:@"%@-%@", fileURL.absoluteString, NSStringFromCGSize(pixelSize)];
+}
+
+#pragma mark - Frame extraction
+
++ (UIImage *)posterImageForAsset:(AVAsset *)asset
+                          atTime:(NSTimeInterval)time
+                       pixelSize:(CGSize)pixelSize
+                           scale:(CGFloat)scale
+{
+    NSParameterAssert(asset != nil);
+    
+    AVAssetTrack *videoTrack = [[asset tracksWithMediaType:AVMediaTypeVideo] firstObject];
+    if (videoTrack == nil) {
+        return nil;
+    }
+    
+    CGRect naturalRect = CGRectApplyAffineTransform((CGRect){ CGPointZero, videoTrack.naturalSize }, videoTrack.preferredTransform);
+    CGSize naturalSize = CGSizeMake(fabs(CGRectGetWidth(naturalRect)), fabs(CGRectGetHeight(naturalRect)));
+    if (naturalSize.width <= 0.0f || naturalSize.height <= 0.0f) {
+        return nil;
+    }
+    
+    //  fill the requested size, the decoder scales the frame down itself
+    CGFloat ratio = MIN(MAX(pixelSize.width / naturalSize.width, pixelSize.height / naturalSize.height), 1.0f);
+    
+    AVAssetImageGenerator *generator = [AVAssetImageGenerator assetImageGeneratorWithAsset:asset];
+    generator.appliesPreferredTrackTransform = YES;
+    generator.maximumSize = CGSizeMake(ceilf(naturalSize.width * ratio), ceilf(naturalSize.height * ratio));
+    generator.requestedTimeToleranceBefore = kCMTimePositiveInfinity;
+    generator.requestedTimeToleranceAfter = kCMTimePositiveInfinity;
+    
+    Float64 duration = CMTimeGetSeconds(asset.duration);
+    Float64 seconds = isfinite(duration) ? MIN(time, duration / 2.0) : time;
+    
+    CGImageRef imageRef = [generator copyCGImageAtTime:CMTimeMakeWithSeconds(MAX(seconds, 0.0), 600)
+                                            actualTime:NULL
+                                                 error:NULL];
+    if (imageRef == NULL) {
+        return nil;
+    }
+    
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    
+    return image;
+}
+
+@end
@@ -20,6 +20,7 @@
 #define JSQMessages_JSQMessages_h
 
 #import "JSQMessagesViewController.h"
+#import "JSQMessagesPrefetcher.h"
 
 //  Views
 #import "JSQMessagesCollectionView.h"
@@ -27,6 +28,8 @@
 #import "JSQMessagesCollectionViewCellOutgoing.h"
 #import "JSQMessagesTypingIndicatorFooterView.h"
 #import "JSQMessagesLoadEarlierHeaderView.h"
+#import "JSQMessagesDayHeaderView.h"
+#import "JSQMessagesMediaImageView.h"
 
 //  Layout
 #import "JSQMessagesBubbleSizeCalculating.h"
@@ -51,6 +54,11 @@
 #import "JSQMessagesBubbleImage.h"
 #import "JSQMessagesAvatarImage.h"
 
+#import "JSQMessagesDaySections.h"
+#import "JSQMessagesColumnStore.h"
+#import "JSQMessagesBinaryArchive.h"
+#import "JSQMessagesSenderTable.h"
+
 //  Protocols
 #import "JSQMessageData.h"
 #import "JSQMessageMediaData.h"
@@ -60,11 +68,25 @@
 #import "JSQMessagesCollectionViewDelegateFlowLayout.h"
 
 //  Factories
+#import "JSQMessagesAssetManager.h"
 #import "JSQMessagesAvatarImageFactory.h"
+#import "JSQMessagesAvatarRenderer.h"
+#import "JSQMessagesBubbleImageAtlas.h"
 #import "JSQMessagesBubbleImageFactory.h"
+#import "JSQMessagesCellRenderDescriptor.h"
+#import "JSQMessagesCellRenderer.h"
+#import "JSQMessagesCostTrackingCache.h"
+#import "JSQMessagesDataDetector.h"
+#import "JSQMessagesImageDiskCache.h"
+#import "JSQMessagesImageLoader.h"
+#import "JSQMessagesLoadRequest.h"
+#import "JSQMessagesMapSnapshotCache.h"
 #import "JSQMessagesMediaViewBubbleImageMasker.h"
+#import "JSQMessagesMemoryCoordinator.h"
 #import "JSQMessagesTimestampFormatter.h"
+#import "JSQMessagesTintKernel.h"
 #import "JSQMessagesToolbarButtonFactory.h"
+#import "JSQMessagesVideoPosterGenerator.h"
 
 //  Categories
 #import "JSQSystemSoundPlayer+JSQMessages.h"
@@ -22,6 +22,7 @@
 #import "JSQMessagesCollectionViewDataSource.h"
 #import "JSQMessagesCollectionViewFlowLayout.h"
 #import "JSQMessageData.h"
+#import "JSQMessagesSenderTable.h"
 
 #import "UIImage+JSQMessages.h"
 
@@ -95,7 +96,7 @@
                               atIndexPath:(NSIndexPath *)indexPath
                                withLayout:(JSQMessagesCollectionViewFlowLayout *)layout
 {
-    NSValue *cachedSize = [self.cache objectForKey:@([messageData messageHash])];
+    NSValue *cachedSize = [self.cache objectForKey:@(JSQMessageDataFingerprint(messageData))];
     if (cachedSize != nil) {
         return [cachedSize CGSizeValue];
     }
@@ -136,7 +137,7 @@
         finalSize = CGSizeMake(finalWidth, stringSize.height + verticalInsets);
     }
 
-    [self.cache setObject:[NSValue valueWithCGSize:finalSize] forKey:@([messageData messageHash])];
+    [self.cache setObject:[NSValue valueWithCGSize:finalSize] forKey:@(JSQMessageDataFingerprint(messageData))];
 
     return finalSize;
 }
@@ -144,9 +145,7 @@
 - (CGSize)jsq_avatarSizeForMessageData:(id<JSQMessageData>)messageData
                             withLayout:(JSQMessagesCollectionViewFlowLayout *)layout
 {
-    NSString *messageSender = [messageData senderId];
-
-    if ([messageSender isEqualToString:[layout.collectionView.dataSource senderId]]) {
+    if ([JSQMessagesSenderTable isOutgoingMessageData:messageData forDataSource:layout.collectionView.dataSource]) {
         return layout.outgoingAvatarViewSize;
     }
 
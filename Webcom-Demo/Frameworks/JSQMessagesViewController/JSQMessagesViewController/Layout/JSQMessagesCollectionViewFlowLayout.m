@@ -23,6 +23,8 @@
 
 #import "JSQMessagesCollectionViewFlowLayout.h"
 
+#import <objc/runtime.h>
+
 #import "JSQMessageData.h"
 
 #import "JSQMessagesCollectionView.h"
@@ -31,6 +33,8 @@
 #import "JSQMessagesCollectionViewLayoutAttributes.h"
 #import "JSQMessagesCollectionViewFlowLayoutInvalidationContext.h"
 #import "JSQMessagesBubblesSizeCalculator.h"
+#import "JSQMessagesMemoryCoordinator.h"
+#import "JSQMessagesSenderTable.h"
 
 #import "UIImage+JSQMessages.h"
 
@@ -38,23 +42,40 @@
 const CGFloat kJSQMessagesCollectionViewCellLabelHeightDefault = 20.0f;
 const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
 
+static const CGFloat kJSQMessagesCollectionViewCellAvatarSpacing = 2.0f;
+
+/**
+ *  The number of pooled layout attributes above which attributes outside of the laid out rect are dropped.
+ */
+static const NSUInteger kJSQMessagesCollectionViewPooledLayoutAttributesLimit = 512;
 
-@interface JSQMessagesCollectionViewFlowLayout ()
+
+@interface JSQMessagesCollectionViewFlowLayout () <JSQMessagesPurgeableCache>
 
 @property (strong, nonatomic) UIDynamicAnimator *dynamicAnimator;
 @property (strong, nonatomic) NSMutableSet *visibleIndexPaths;
 
 @property (assign, nonatomic) CGFloat latestDelta;
 
+@property (assign, nonatomic) NSUInteger contentVersion;
+@property (strong, nonatomic) NSMutableDictionary *pooledLayoutAttributes;
+
 - (void)jsq_configureFlowLayout;
 
-- (void)jsq_didReceiveApplicationMemoryWarningNotification:(NSNotification *)notification;
 - (void)jsq_didReceiveDeviceOrientationDidChangeNotification:(NSNotification *)notification;
 
 - (void)jsq_resetLayout;
 - (void)jsq_resetDynamicAnimator;
+- (void)jsq_resetPooledLayoutAttributes;
+- (void)jsq_trimPooledLayoutAttributesKeepingLayoutAttributes:(NSArray *)layoutAttributes;
 
+- (JSQMessagesCollectionViewLayoutAttributes *)jsq_pooledLayoutAttributesForLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes;
+- (void)jsq_removePooledLayoutAttributesForIndexPaths:(NSArray *)indexPaths;
+
+- (id<JSQMessageData>)jsq_layoutMessageDataForItemAtIndexPath:(NSIndexPath *)indexPath;
 - (void)jsq_configureMessageCellLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes;
+- (void)jsq_configureSubviewFramesForLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes
+                                           isOutgoing:(BOOL)isOutgoing;
 
 - (UIAttachmentBehavior *)jsq_springBehaviorWithLayoutAttributesItem:(UICollectionViewLayoutAttributes *)item;
 - (void)jsq_addNewlyVisibleBehaviorsFromVisibleItems:(NSArray *)visibleItems;
@@ -98,10 +119,12 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     _springinessEnabled = NO;
     _springResistanceFactor = 1000;
     
-    [[NSNotificationCenter defaultCenter] addObserver:self
-                                             selector:@selector(jsq_didReceiveApplicationMemoryWarningNotification:)
-                                                 name:UIApplicationDidReceiveMemoryWarningNotification
-                                               object:nil];
+    //  attributes start at version 0, so the first pass always configures them
+    _contentVersion = 1;
+    _pooledLayoutAttributes = [NSMutableDictionary new];
+    
+    //  throwing away the measured sizes makes every message measured again, so only critical memory pressure does it
+    [[JSQMessagesMemoryCoordinator sharedCoordinator] registerCache:self];
     
     [[NSNotificationCenter defaultCenter] addObserver:self
                                              selector:@selector(jsq_didReceiveDeviceOrientationDidChangeNotification:)
@@ -146,6 +169,9 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     
     [_visibleIndexPaths removeAllObjects];
     _visibleIndexPaths = nil;
+    
+    [_pooledLayoutAttributes removeAllObjects];
+    _pooledLayoutAttributes = nil;
 }
 
 #pragma mark - Setters
@@ -189,6 +215,16 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     [self invalidateLayoutWithContext:[JSQMessagesCollectionViewFlowLayoutInvalidationContext context]];
 }
 
+- (void)setMessageBubbleTextViewFrameInsets:(UIEdgeInsets)messageBubbleTextViewFrameInsets
+{
+    if (UIEdgeInsetsEqualToEdgeInsets(_messageBubbleTextViewFrameInsets, messageBubbleTextViewFrameInsets)) {
+        return;
+    }
+    
+    _messageBubbleTextViewFrameInsets = messageBubbleTextViewFrameInsets;
+    [self invalidateLayoutWithContext:[JSQMessagesCollectionViewFlowLayoutInvalidationContext context]];
+}
+
 - (void)setMessageBubbleTextViewTextContainerInsets:(UIEdgeInsets)messageBubbleTextContainerInsets
 {
     if (UIEdgeInsetsEqualToEdgeInsets(_messageBubbleTextViewTextContainerInsets, messageBubbleTextContainerInsets)) {
@@ -251,13 +287,30 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     return _bubbleSizeCalculator;
 }
 
-#pragma mark - Notifications
+#pragma mark - Purgeable cache
 
-- (void)jsq_didReceiveApplicationMemoryWarningNotification:(NSNotification *)notification
+- (NSString *)cacheName
+{
+    return [NSString stringWithFormat:@"%@.%p", [self class], self];
+}
+
+- (NSUInteger)cacheByteCost
+{
+    return self.pooledLayoutAttributes.count * class_getInstanceSize([JSQMessagesCollectionViewLayoutAttributes class]);
+}
+
+- (JSQMessagesCacheRebuildCost)cacheRebuildCost
+{
+    return JSQMessagesCacheRebuildCostHigh;
+}
+
+- (void)purgeCache
 {
     [self jsq_resetLayout];
 }
 
+#pragma mark - Notifications
+
 - (void)jsq_didReceiveDeviceOrientationDidChangeNotification:(NSNotification *)notification
 {
     [self jsq_resetLayout];
@@ -282,6 +335,21 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
         [self jsq_resetLayout];
     }
     
+    //  any of these may change the content of a message cell, so previously configured attributes become stale
+    if (context.invalidateEverything
+        || context.invalidateFlowLayoutAttributes
+        || context.invalidateFlowLayoutDelegateMetrics
+        || context.invalidateFlowLayoutMessagesCache) {
+        self.contentVersion++;
+    }
+    
+    if (context.invalidateEverything || context.invalidateDataSourceCounts) {
+        [self jsq_resetPooledLayoutAttributes];
+    }
+    else if ([context respondsToSelector:@selector(invalidatedItemIndexPaths)]) {
+        [self jsq_removePooledLayoutAttributesForIndexPaths:context.invalidatedItemIndexPaths];
+    }
+    
     [super invalidateLayoutWithContext:context];
 }
 
@@ -329,16 +397,28 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
         attributesInRect = attributesInRectCopy;
     }
     
+    NSMutableArray *layoutAttributesInRect = [NSMutableArray arrayWithCapacity:attributesInRect.count];
+    
     [attributesInRect enumerateObjectsUsingBlock:^(JSQMessagesCollectionViewLayoutAttributes *attributesItem, NSUInteger idx, BOOL *stop) {
         if (attributesItem.representedElementCategory == UICollectionElementCategoryCell) {
-            [self jsq_configureMessageCellLayoutAttributes:attributesItem];
+            if (self.springinessEnabled) {
+                //  dynamic items are owned by the animator, configure them in place
+                [self jsq_configureMessageCellLayoutAttributes:attributesItem];
+            }
+            else {
+                attributesItem = [self jsq_pooledLayoutAttributesForLayoutAttributes:attributesItem];
+            }
         }
         else {
             attributesItem.zIndex = -1;
         }
+        
+        [layoutAttributesInRect addObject:attributesItem];
     }];
     
-    return attributesInRect;
+    [self jsq_trimPooledLayoutAttributesKeepingLayoutAttributes:layoutAttributesInRect];
+    
+    return layoutAttributesInRect;
 }
 
 - (UICollectionViewLayoutAttributes *)layoutAttributesForItemAtIndexPath:(NSIndexPath *)indexPath
@@ -346,7 +426,12 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     JSQMessagesCollectionViewLayoutAttributes *customAttributes = (JSQMessagesCollectionViewLayoutAttributes *)[super layoutAttributesForItemAtIndexPath:indexPath];
     
     if (customAttributes.representedElementCategory == UICollectionElementCategoryCell) {
-        [self jsq_configureMessageCellLayoutAttributes:customAttributes];
+        if (self.springinessEnabled) {
+            [self jsq_configureMessageCellLayoutAttributes:customAttributes];
+        }
+        else {
+            customAttributes = [self jsq_pooledLayoutAttributesForLayoutAttributes:customAttributes];
+        }
     }
     
     return customAttributes;
@@ -380,6 +465,25 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
 {
     [super prepareForCollectionViewUpdates:updateItems];
     
+    //  the content of a reloaded item changed, but the content version did not
+    for (UICollectionViewUpdateItem *updateItem in updateItems) {
+        if (updateItem.updateAction != UICollectionUpdateActionReload) {
+            continue;
+        }
+        
+        NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:2];
+        
+        if (updateItem.indexPathBeforeUpdate != nil) {
+            [indexPaths addObject:updateItem.indexPathBeforeUpdate];
+        }
+        
+        if (updateItem.indexPathAfterUpdate != nil) {
+            [indexPaths addObject:updateItem.indexPathAfterUpdate];
+        }
+        
+        [self jsq_removePooledLayoutAttributesForIndexPaths:indexPaths];
+    }
+    
     [updateItems enumerateObjectsUsingBlock:^(UICollectionViewUpdateItem *updateItem, NSUInteger index, BOOL *stop) {
         if (updateItem.updateAction == UICollectionUpdateActionInsert) {
             
@@ -414,6 +518,7 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
 {
     [self.bubbleSizeCalculator prepareForResettingLayout:self];
     [self jsq_resetDynamicAnimator];
+    [self jsq_resetPooledLayoutAttributes];
 }
 
 - (void)jsq_resetDynamicAnimator
@@ -424,12 +529,86 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     }
 }
 
+- (void)jsq_resetPooledLayoutAttributes
+{
+    [self.pooledLayoutAttributes removeAllObjects];
+}
+
+- (void)jsq_trimPooledLayoutAttributesKeepingLayoutAttributes:(NSArray *)layoutAttributes
+{
+    if (self.pooledLayoutAttributes.count <= kJSQMessagesCollectionViewPooledLayoutAttributesLimit) {
+        return;
+    }
+    
+    //  keep what was just laid out, items scrolled far away are configured again if they come back
+    NSMutableDictionary *keptAttributes = [NSMutableDictionary dictionaryWithCapacity:layoutAttributes.count];
+    
+    for (UICollectionViewLayoutAttributes *attributes in layoutAttributes) {
+        if (attributes.representedElementCategory != UICollectionElementCategoryCell) {
+            continue;
+        }
+        
+        id pooledAttributes = [self.pooledLayoutAttributes objectForKey:attributes.indexPath];
+        if (pooledAttributes != nil) {
+            [keptAttributes setObject:pooledAttributes forKey:attributes.indexPath];
+        }
+    }
+    
+    self.pooledLayoutAttributes = keptAttributes;
+}
+
+#pragma mark - Layout attributes pool
+
+- (JSQMessagesCollectionViewLayoutAttributes *)jsq_pooledLayoutAttributesForLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes
+{
+    NSIndexPath *indexPath = layoutAttributes.indexPath;
+    JSQMessagesCollectionViewLayoutAttributes *pooledAttributes = [self.pooledLayoutAttributes objectForKey:indexPath];
+    
+    if (pooledAttributes == nil) {
+        pooledAttributes = [layoutAttributes copy];
+        pooledAttributes.contentVersion = 0;
+        [self.pooledLayoutAttributes setObject:pooledAttributes forKey:indexPath];
+    }
+    else if (!CGRectEqualToRect(pooledAttributes.frame, layoutAttributes.frame)) {
+        //  subview frames depend on the cell size, but not on its origin
+        if (!CGSizeEqualToSize(pooledAttributes.size, layoutAttributes.size)) {
+            pooledAttributes.contentVersion = 0;
+        }
+        pooledAttributes.frame = layoutAttributes.frame;
+    }
+    
+    if (pooledAttributes.contentVersion != self.contentVersion) {
+        [self jsq_configureMessageCellLayoutAttributes:pooledAttributes];
+    }
+    
+    //  fill the attributes of super instead of returning a copy, the pooled ones are never handed to UIKit
+    [layoutAttributes setMessageCellValuesFromLayoutAttributes:pooledAttributes];
+    return layoutAttributes;
+}
+
+- (void)jsq_removePooledLayoutAttributesForIndexPaths:(NSArray *)indexPaths
+{
+    if (indexPaths.count > 0) {
+        [self.pooledLayoutAttributes removeObjectsForKeys:indexPaths];
+    }
+}
+
 #pragma mark - Message cell layout utilities
 
+- (id<JSQMessageData>)jsq_layoutMessageDataForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    id<JSQMessagesCollectionViewDataSource> dataSource = self.collectionView.dataSource;
+    
+    if ([dataSource respondsToSelector:@selector(collectionView:layoutMessageDataForItemAtIndexPath:)]) {
+        return [dataSource collectionView:self.collectionView layoutMessageDataForItemAtIndexPath:indexPath];
+    }
+    
+    return [dataSource collectionView:self.collectionView messageDataForItemAtIndexPath:indexPath];
+}
+
 - (CGSize)messageBubbleSizeForItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    id<JSQMessageData> messageItem = [self.collectionView.dataSource collectionView:self.collectionView
-                                                      messageDataForItemAtIndexPath:indexPath];
+    id<JSQMessageData> messageItem = [self jsq_layoutMessageDataForItemAtIndexPath:indexPath];
 
     return [self.bubbleSizeCalculator messageBubbleSizeForMessageData:messageItem
                                                           atIndexPath:indexPath
@@ -453,7 +632,11 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
 {
     NSIndexPath *indexPath = layoutAttributes.indexPath;
     
-    CGSize messageBubbleSize = [self messageBubbleSizeForItemAtIndexPath:indexPath];
+    id<JSQMessageData> messageItem = [self jsq_layoutMessageDataForItemAtIndexPath:indexPath];
+    
+    CGSize messageBubbleSize = [self.bubbleSizeCalculator messageBubbleSizeForMessageData:messageItem
+                                                                              atIndexPath:indexPath
+                                                                               withLayout:self];
     
     layoutAttributes.messageBubbleContainerViewWidth = messageBubbleSize.width;
     
@@ -478,6 +661,61 @@ const CGFloat kJSQMessagesCollectionViewAvatarSizeDefault = 30.0f;
     layoutAttributes.cellBottomLabelHeight = [self.collectionView.delegate collectionView:self.collectionView
                                                                                    layout:self
                                                       heightForCellBottomLabelAtIndexPath:indexPath];
+    
+    BOOL isOutgoing = [JSQMessagesSenderTable isOutgoingMessageData:messageItem forDataSource:self.collectionView.dataSource];
+    [self jsq_configureSubviewFramesForLayoutAttributes:layoutAttributes isOutgoing:isOutgoing];
+    
+    layoutAttributes.contentVersion = self.contentVersion;
+}
+
+- (void)jsq_configureSubviewFramesForLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes
+                                           isOutgoing:(BOOL)isOutgoing
+{
+    CGFloat width = CGRectGetWidth(layoutAttributes.frame);
+    CGFloat height = CGRectGetHeight(layoutAttributes.frame);
+    
+    CGFloat cellTopLabelHeight = layoutAttributes.cellTopLabelHeight;
+    CGFloat messageBubbleTopLabelHeight = layoutAttributes.messageBubbleTopLabelHeight;
+    CGFloat cellBottomLabelHeight = layoutAttributes.cellBottomLabelHeight;
+    
+    layoutAttributes.cellTopLabelFrame = CGRectMake(0.0f, 0.0f, width, cellTopLabelHeight);
+    layoutAttributes.messageBubbleTopLabelFrame = CGRectMake(0.0f, cellTopLabelHeight, width, messageBubbleTopLabelHeight);
+    layoutAttributes.cellBottomLabelFrame = CGRectMake(0.0f, height - cellBottomLabelHeight, width, cellBottomLabelHeight);
+    
+    //  the bubble sits between the labels, the avatar is aligned with its bottom edge
+    CGFloat messageBubbleMinY = cellTopLabelHeight + messageBubbleTopLabelHeight;
+    CGFloat messageBubbleMaxY = height - cellBottomLabelHeight;
+    CGFloat messageBubbleWidth = layoutAttributes.messageBubbleContainerViewWidth;
+    
+    CGSize avatarViewSize = isOutgoing ? layoutAttributes.outgoingAvatarViewSize : layoutAttributes.incomingAvatarViewSize;
+    CGFloat avatarMinX = isOutgoing ? width - avatarViewSize.width : 0.0f;
+    
+    layoutAttributes.avatarContainerViewFrame = CGRectMake(avatarMinX,
+                                                           messageBubbleMaxY - avatarViewSize.height,
+                                                           avatarViewSize.width,
+                                                           avatarViewSize.height);
+    
+    CGFloat messageBubbleMinX = isOutgoing
+                                ? avatarMinX - kJSQMessagesCollectionViewCellAvatarSpacing - messageBubbleWidth
+                                : avatarViewSize.width + kJSQMessagesCollectionViewCellAvatarSpacing;
+    
+    CGRect messageBubbleContainerViewFrame = CGRectMake(messageBubbleMinX,
+                                                        messageBubbleMinY,
+                                                        messageBubbleWidth,
+                                                        MAX(messageBubbleMaxY - messageBubbleMinY, 0.0f));
+    layoutAttributes.messageBubbleContainerViewFrame = messageBubbleContainerViewFrame;
+    
+    //  the right inset is adjacent to the avatar, so it is mirrored for incoming messages
+    UIEdgeInsets textViewFrameInsets = layoutAttributes.textViewFrameInsets;
+    if (!isOutgoing) {
+        textViewFrameInsets = UIEdgeInsetsMake(textViewFrameInsets.top,
+                                               textViewFrameInsets.right,
+                                               textViewFrameInsets.bottom,
+                                               textViewFrameInsets.left);
+    }
+    
+    CGRect messageBubbleBounds = (CGRect){ CGPointZero, messageBubbleContainerViewFrame.size };
+    layoutAttributes.textViewFrame = UIEdgeInsetsInsetRect(messageBubbleBounds, textViewFrameInsets);
 }
 
 #pragma mark - Spring behavior utilities
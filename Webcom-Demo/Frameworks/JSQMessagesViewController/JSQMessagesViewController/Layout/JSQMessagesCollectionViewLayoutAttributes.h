@@ -103,4 +103,57 @@
  */
 @property (assign, nonatomic) CGFloat cellBottomLabelHeight;
 
+/**
+ *  The frame of the `cellTopLabel` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its content view.
+ *
+ *  @discussion This value and the other subview frames are precomputed by the layout from the values above.
+ *  Cells that build their subviews in code assign them in `layoutSubviews` instead of solving constraints.
+ */
+@property (assign, nonatomic) CGRect cellTopLabelFrame;
+
+/**
+ *  The frame of the `messageBubbleTopLabel` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its content view.
+ */
+@property (assign, nonatomic) CGRect messageBubbleTopLabelFrame;
+
+/**
+ *  The frame of the `cellBottomLabel` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its content view.
+ */
+@property (assign, nonatomic) CGRect cellBottomLabelFrame;
+
+/**
+ *  The frame of the `messageBubbleContainerView` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its content view.
+ */
+@property (assign, nonatomic) CGRect messageBubbleContainerViewFrame;
+
+/**
+ *  The frame of the `textView` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its `messageBubbleContainerView`.
+ *  This is the container bounds inset by `textViewFrameInsets`, mirrored for incoming messages.
+ */
+@property (assign, nonatomic) CGRect textViewFrame;
+
+/**
+ *  The frame of the `avatarContainerView` of a `JSQMessagesCollectionViewCell`, in the coordinate space of its content view.
+ */
+@property (assign, nonatomic) CGRect avatarContainerViewFrame;
+
+/**
+ *  A stamp identifying the layout state from which the values above were computed.
+ *
+ *  @discussion `JSQMessagesCollectionViewFlowLayout` assigns its current content version each time it configures
+ *  the attributes of a message cell, and moves to a new version whenever an invalidation can change that content.
+ *  Two cell attributes with the same `contentVersion` therefore carry the same message content for their index path,
+ *  and `isEqual:` compares this value instead of comparing each of the values above.
+ *  The default value is `0`, which never matches a version assigned by the layout.
+ */
+@property (assign, nonatomic) NSUInteger contentVersion;
+
+/**
+ *  Sets the message cell values of the receiver, from `messageBubbleFont` to `contentVersion`, to those of the given attributes.
+ *  The frame, index path and other values inherited from `UICollectionViewLayoutAttributes` are not changed.
+ *
+ *  @param layoutAttributes The attributes of a message cell to copy the values from. This value must not be `nil`.
+ */
+- (void)setMessageCellValuesFromLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes;
+
 @end
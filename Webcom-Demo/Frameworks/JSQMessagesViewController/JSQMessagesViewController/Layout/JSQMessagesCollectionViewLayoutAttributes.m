@@ -108,15 +108,8 @@
     if (self.representedElementCategory == UICollectionElementCategoryCell) {
         JSQMessagesCollectionViewLayoutAttributes *layoutAttributes = (JSQMessagesCollectionViewLayoutAttributes *)object;
         
-        if (![layoutAttributes.messageBubbleFont isEqual:self.messageBubbleFont]
-            || !UIEdgeInsetsEqualToEdgeInsets(layoutAttributes.textViewFrameInsets, self.textViewFrameInsets)
-            || !UIEdgeInsetsEqualToEdgeInsets(layoutAttributes.textViewTextContainerInsets, self.textViewTextContainerInsets)
-            || !CGSizeEqualToSize(layoutAttributes.incomingAvatarViewSize, self.incomingAvatarViewSize)
-            || !CGSizeEqualToSize(layoutAttributes.outgoingAvatarViewSize, self.outgoingAvatarViewSize)
-            || (int)layoutAttributes.messageBubbleContainerViewWidth != (int)self.messageBubbleContainerViewWidth
-            || (int)layoutAttributes.cellTopLabelHeight != (int)self.cellTopLabelHeight
-            || (int)layoutAttributes.messageBubbleTopLabelHeight != (int)self.messageBubbleTopLabelHeight
-            || (int)layoutAttributes.cellBottomLabelHeight != (int)self.cellBottomLabelHeight) {
+        //  the frame and index path are compared by super, everything else is covered by the version
+        if (layoutAttributes.contentVersion != self.contentVersion) {
             return NO;
         }
     }
@@ -126,7 +119,7 @@
 
 - (NSUInteger)hash
 {
-    return [self.indexPath hash];
+    return [self.indexPath hash] ^ self.contentVersion;
 }
 
 #pragma mark - NSCopying
@@ -139,17 +132,33 @@
         return copy;
     }
     
-    copy.messageBubbleFont = self.messageBubbleFont;
-    copy.messageBubbleContainerViewWidth = self.messageBubbleContainerViewWidth;
-    copy.textViewFrameInsets = self.textViewFrameInsets;
-    copy.textViewTextContainerInsets = self.textViewTextContainerInsets;
-    copy.incomingAvatarViewSize = self.incomingAvatarViewSize;
-    copy.outgoingAvatarViewSize = self.outgoingAvatarViewSize;
-    copy.cellTopLabelHeight = self.cellTopLabelHeight;
-    copy.messageBubbleTopLabelHeight = self.messageBubbleTopLabelHeight;
-    copy.cellBottomLabelHeight = self.cellBottomLabelHeight;
-    
+    [copy setMessageCellValuesFromLayoutAttributes:self];
     return copy;
 }
 
+#pragma mark - Message cell values
+
+- (void)setMessageCellValuesFromLayoutAttributes:(JSQMessagesCollectionViewLayoutAttributes *)layoutAttributes
+{
+    NSParameterAssert(layoutAttributes != nil);
+    
+    //  copy the ivars directly, the values were already validated by the setters of layoutAttributes
+    _messageBubbleFont = layoutAttributes->_messageBubbleFont;
+    _messageBubbleContainerViewWidth = layoutAttributes->_messageBubbleContainerViewWidth;
+    _textViewFrameInsets = layoutAttributes->_textViewFrameInsets;
+    _textViewTextContainerInsets = layoutAttributes->_textViewTextContainerInsets;
+    _incomingAvatarViewSize = layoutAttributes->_incomingAvatarViewSize;
+    _outgoingAvatarViewSize = layoutAttributes->_outgoingAvatarViewSize;
+    _cellTopLabelHeight = layoutAttributes->_cellTopLabelHeight;
+    _messageBubbleTopLabelHeight = layoutAttributes->_messageBubbleTopLabelHeight;
+    _cellBottomLabelHeight = layoutAttributes->_cellBottomLabelHeight;
+    _cellTopLabelFrame = layoutAttributes->_cellTopLabelFrame;
+    _messageBubbleTopLabelFrame = layoutAttributes->_messageBubbleTopLabelFrame;
+    _cellBottomLabelFrame = layoutAttributes->_cellBottomLabelFrame;
+    _messageBubbleContainerViewFrame = layoutAttributes->_messageBubbleContainerViewFrame;
+    _textViewFrame = layoutAttributes->_textViewFrame;
+    _avatarContainerViewFrame = layoutAttributes->_avatarContainerViewFrame;
+    _contentVersion = layoutAttributes->_contentVersion;
+}
+
 @end
@@ -66,6 +66,9 @@ typedef void (^JSQLocationMediaItemCompletionBlock)(void);
  *
  *  The specified block is executed upon completion of creating the snapshot image and is executed on the app’s main thread.
  *
+ *  @discussion Snapshots are created and cached by the shared `JSQMessagesMapSnapshotCache`, so items with nearby
+ *  locations share the same snapshot and the block may be called without creating a new one.
+ *
  *  @param location   The location for the media item.
  *  @param completion The block to call after the map view snapshot for the given location has been created.
  */
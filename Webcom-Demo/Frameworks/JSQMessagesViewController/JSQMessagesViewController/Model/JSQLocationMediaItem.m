@@ -20,18 +20,30 @@
 
 #import "JSQMessagesMediaPlaceholderView.h"
 #import "JSQMessagesMediaViewBubbleImageMasker.h"
+#import "JSQMessagesMediaImageView.h"
+#import "JSQMessagesMapSnapshotCache.h"
+
+#import "UIColor+JSQMessages.h"
 
 
 @interface JSQLocationMediaItem ()
 
-@property (strong, nonatomic) UIImage *cachedMapSnapshotImage;
+@property (assign, nonatomic) MKCoordinateRegion snapshotRegion;
+
+@property (assign, nonatomic) BOOL hasMapSnapshot;
+
+@property (strong, nonatomic) JSQMessagesMediaImageView *cachedMapImageView;
 
-@property (strong, nonatomic) UIImageView *cachedMapImageView;
+@property (strong, nonatomic) JSQMessagesLoadRequest *snapshotRequest;
 
 - (void)createMapViewSnapshotForLocation:(CLLocation *)location
                         coordinateRegion:(MKCoordinateRegion)region
                    withCompletionHandler:(JSQLocationMediaItemCompletionBlock)completion;
 
+- (void)jsq_loadSnapshotIntoImageView:(JSQMessagesMediaImageView *)imageView;
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView;
+
 @end
 
 
@@ -51,13 +63,16 @@
 - (void)dealloc
 {
     _location = nil;
-    _cachedMapSnapshotImage = nil;
+    _cachedMapImageView.windowHandler = nil;
     _cachedMapImageView = nil;
 }
 
 - (void)clearCachedMediaViews
 {
     [super clearCachedMediaViews];
+    [[JSQMessagesMapSnapshotCache sharedCache] cancelSnapshotRequest:_snapshotRequest];
+    _snapshotRequest = nil;
+    _cachedMapImageView.windowHandler = nil;
     _cachedMapImageView = nil;
 }
 
@@ -71,7 +86,7 @@
 - (void)setAppliesMediaViewMaskAsOutgoing:(BOOL)appliesMediaViewMaskAsOutgoing
 {
     [super setAppliesMediaViewMaskAsOutgoing:appliesMediaViewMaskAsOutgoing];
-    _cachedMapSnapshotImage = nil;
+    _cachedMapImageView.windowHandler = nil;
     _cachedMapImageView = nil;
 }
 
@@ -85,7 +100,9 @@
 - (void)setLocation:(CLLocation *)location region:(MKCoordinateRegion)region withCompletionHandler:(JSQLocationMediaItemCompletionBlock)completion
 {
     _location = [location copy];
-    _cachedMapSnapshotImage = nil;
+    _snapshotRegion = region;
+    _hasMapSnapshot = NO;
+    _cachedMapImageView.windowHandler = nil;
     _cachedMapImageView = nil;
     
     if (_location == nil) {
@@ -103,39 +120,62 @@
 {
     NSParameterAssert(location != nil);
     
-    MKMapSnapshotOptions *options = [[MKMapSnapshotOptions alloc] init];
-    options.region = region;
-    options.size = [self mediaViewDisplaySize];
-    options.scale = [UIScreen mainScreen].scale;
+    __weak JSQLocationMediaItem *weakSelf = self;
+    
+    //  the shared cache coalesces identical requests and keeps the snapshot, the item only keeps its view
+    [[JSQMessagesMapSnapshotCache sharedCache] snapshotForCoordinate:location.coordinate
+                                                              region:region
+                                                                size:[self mediaViewDisplaySize]
+                                                          completion:^(UIImage *snapshot) {
+                                                              if (snapshot == nil || ![weakSelf.location isEqual:location]) {
+                                                                  return;
+                                                              }
+                                                              
+                                                              weakSelf.hasMapSnapshot = YES;
+                                                              
+                                                              if (completion) {
+                                                                  dispatch_async(dispatch_get_main_queue(), completion);
+                                                              }
+                                                          }];
+}
+
+- (void)jsq_loadSnapshotIntoImageView:(JSQMessagesMediaImageView *)imageView
+{
+    __weak JSQLocationMediaItem *weakSelf = self;
+    __weak JSQMessagesMediaImageView *weakImageView = imageView;
+    
+    JSQMessagesMapSnapshotCache *snapshotCache = [JSQMessagesMapSnapshotCache sharedCache];
+    [snapshotCache cancelSnapshotRequest:self.snapshotRequest];
     
-    MKMapSnapshotter *snapShotter = [[MKMapSnapshotter alloc] initWithOptions:options];
+    self.snapshotRequest = [snapshotCache snapshotForCoordinate:self.location.coordinate
+                                                         region:self.snapshotRegion
+                                                           size:[self mediaViewDisplaySize]
+                                                     completion:^(UIImage *snapshot) {
+                                                         weakSelf.snapshotRequest = nil;
+                                                         
+                                                         if (weakSelf.cachedMapImageView == weakImageView) {
+                                                             weakImageView.image = snapshot;
+                                                         }
+                                                     }];
+}
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView
+{
+    if (imageView != self.cachedMapImageView) {
+        return;
+    }
+    
+    if (imageView.window != nil) {
+        if (imageView.image == nil) {
+            [self jsq_loadSnapshotIntoImageView:imageView];
+        }
+        return;
+    }
     
-    [snapShotter startWithQueue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)
-              completionHandler:^(MKMapSnapshot *snapshot, NSError *error) {
-                  if (error) {
-                      NSLog(@"%s Error creating map snapshot: %@", __PRETTY_FUNCTION__, error);
-                      return;
-                  }
-                  
-                  MKAnnotationView *pin = [[MKPinAnnotationView alloc] initWithAnnotation:nil reuseIdentifier:nil];
-                  CGPoint coordinatePoint = [snapshot pointForCoordinate:location.coordinate];
-                  UIImage *image = snapshot.image;
-                  
-                  coordinatePoint.x += pin.centerOffset.x - (CGRectGetWidth(pin.bounds) / 2.0);
-                  coordinatePoint.y += pin.centerOffset.y - (CGRectGetHeight(pin.bounds) / 2.0);
-                  
-                  UIGraphicsBeginImageContextWithOptions(image.size, YES, image.scale);
-                  {
-                      [image drawAtPoint:CGPointZero];
-                      [pin.image drawAtPoint:coordinatePoint];
-                      self.cachedMapSnapshotImage = UIGraphicsGetImageFromCurrentImageContext();
-                  }
-                  UIGraphicsEndImageContext();
-                  
-                  if (completion) {
-                      dispatch_async(dispatch_get_main_queue(), completion);
-                  }
-              }];
+    //  only this view stops waiting, nearby locations quantize to the same snapshot
+    [[JSQMessagesMapSnapshotCache sharedCache] cancelSnapshotRequest:self.snapshotRequest];
+    self.snapshotRequest = nil;
+    imageView.image = nil;
 }
 
 #pragma mark - MKAnnotation
@@ -149,16 +189,28 @@
 
 - (UIView *)mediaView
 {
-    if (self.location == nil || self.cachedMapSnapshotImage == nil) {
+    if (self.location == nil || !self.hasMapSnapshot) {
         return nil;
     }
     
     if (self.cachedMapImageView == nil) {
-        UIImageView *imageView = [[UIImageView alloc] initWithImage:self.cachedMapSnapshotImage];
+        CGSize size = [self mediaViewDisplaySize];
+        
+        JSQMessagesMediaImageView *imageView = [[JSQMessagesMediaImageView alloc] initWithFrame:CGRectMake(0.0f, 0.0f, size.width, size.height)];
+        imageView.backgroundColor = [UIColor jsq_messageBubbleLightGrayColor];
         imageView.contentMode = UIViewContentModeScaleAspectFill;
         imageView.clipsToBounds = YES;
         [JSQMessagesMediaViewBubbleImageMasker applyBubbleImageMaskToMediaView:imageView isOutgoing:self.appliesMediaViewMaskAsOutgoing];
+        
+        __weak JSQLocationMediaItem *weakSelf = self;
+        imageView.windowHandler = ^(JSQMessagesMediaImageView *view) {
+            [weakSelf jsq_imageViewDidMoveToWindow:view];
+        };
+        
         self.cachedMapImageView = imageView;
+        
+        //  usually served synchronously from the memory cache, otherwise from the disk cache
+        [self jsq_loadSnapshotIntoImageView:imageView];
     }
     
     return self.cachedMapImageView;
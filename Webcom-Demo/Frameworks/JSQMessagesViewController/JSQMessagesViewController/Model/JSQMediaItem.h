@@ -52,6 +52,8 @@
 
 /**
  *  Clears any media view or media placeholder view that the item has cached.
+ *
+ *  @discussion This method is called whenever the `JSQMessagesMemoryCoordinator` purges caches.
  */
 - (void)clearCachedMediaViews;
 
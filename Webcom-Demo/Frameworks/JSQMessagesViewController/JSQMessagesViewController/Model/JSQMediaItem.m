@@ -20,6 +20,7 @@
 
 #import "JSQMessagesMediaPlaceholderView.h"
 #import "JSQMessagesMediaViewBubbleImageMasker.h"
+#import "JSQMessagesMemoryCoordinator.h"
 
 
 @interface JSQMediaItem ()
@@ -45,8 +46,8 @@
         _appliesMediaViewMaskAsOutgoing = maskAsOutgoing;
         _cachedPlaceholderView = nil;
         [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(didReceiveMemoryWarningNotification:)
-                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                 selector:@selector(didPurgeCachesNotification:)
+                                                     name:JSQMessagesMemoryCoordinatorDidPurgeCachesNotification
                                                    object:nil];
     }
     return self;
@@ -71,8 +72,15 @@
 
 #pragma mark - Notifications
 
-- (void)didReceiveMemoryWarningNotification:(NSNotification *)notification
+- (void)didPurgeCachesNotification:(NSNotification *)notification
 {
+    //  media items are not caches of their own: their views only hold on to images of the caches
+    //  the coordinator purged, so they let go of them when a purge actually freed something
+    NSDictionary *bytesFreed = [notification.userInfo objectForKey:JSQMessagesMemoryCoordinatorBytesFreedKey];
+    if (bytesFreed.count == 0) {
+        return;
+    }
+    
     [self clearCachedMediaViews];
 }
 
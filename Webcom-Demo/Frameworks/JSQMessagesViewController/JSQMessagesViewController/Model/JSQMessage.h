@@ -39,6 +39,14 @@
  */
 @property (copy, nonatomic, readonly) NSString *senderDisplayName;
 
+/**
+ *  Returns the ordinal of `senderId` in the shared `JSQMessagesSenderTable`.
+ *
+ *  @discussion The sender identifier and display name are interned in the shared sender table,
+ *  so messages from the same sender share a single copy of these strings.
+ */
+@property (assign, nonatomic, readonly) NSUInteger senderOrdinal;
+
 /**
  *  Returns the date that the message was sent.
  */
@@ -63,6 +71,16 @@
  */
 @property (copy, nonatomic, readonly) id<JSQMessageMediaData> media;
 
+/**
+ *  Returns the 64-bit fingerprint of the sender, date and contents of the message.
+ *
+ *  @discussion The fingerprint is computed once at initialization and is also the value of `hash` and `messageHash`.
+ *  It is derived from the sender identifier and display name, the date, and either the text or the class of the media,
+ *  so it is the same across launches and does not change when a media item is updated. It is not archived,
+ *  an unarchived message computes it again.
+ */
+@property (assign, nonatomic, readonly) uint64_t messageFingerprint;
+
 
 #pragma mark - Initialization
 
@@ -131,4 +149,21 @@
                             date:(NSDate *)date
                            media:(id<JSQMessageMediaData>)media;
 
+/**
+ *  Returns the `messageFingerprint` that a text message with the given values has, without creating the message.
+ *
+ *  @param senderId          The unique identifier for the user who sent the message. This value must not be `nil`.
+ *  @param senderDisplayName The display name for the user who sent the message. This value must not be `nil`.
+ *  @param timeInterval      The date that the message was sent, as a time interval since the reference date.
+ *  @param text              The body text of the message. This value must not be `nil`.
+ *
+ *  @return The fingerprint of the text message.
+ *
+ *  @see JSQMessagesColumnStore.
+ */
++ (uint64_t)fingerprintForTextMessageWithSenderId:(NSString *)senderId
+                                senderDisplayName:(NSString *)senderDisplayName
+                   timeIntervalSinceReferenceDate:(NSTimeInterval)timeInterval
+                                             text:(NSString *)text;
+
 @end
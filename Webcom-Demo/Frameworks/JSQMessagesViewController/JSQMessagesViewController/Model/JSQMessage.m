@@ -18,6 +18,58 @@
 
 #import "JSQMessage.h"
 
+#import "JSQMessagesSenderTable.h"
+
+
+static const uint64_t kJSQMessageFingerprintOffsetBasis = 14695981039346656037ULL;
+static const uint64_t kJSQMessageFingerprintPrime = 1099511628211ULL;
+static const CFIndex kJSQMessageFingerprintBufferLength = 256;
+
+static inline uint64_t JSQMessageFingerprintAvalanche(uint64_t value)
+{
+    //  MurmurHash3 finalizer, every input bit affects every output bit
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static inline uint64_t JSQMessageFingerprintAppendValue(uint64_t fingerprint, uint64_t value)
+{
+    return (fingerprint ^ JSQMessageFingerprintAvalanche(value)) * kJSQMessageFingerprintPrime;
+}
+
+static uint64_t JSQMessageFingerprintAppendString(uint64_t fingerprint, NSString *string)
+{
+    if (string == nil) {
+        return JSQMessageFingerprintAppendValue(fingerprint, UINT64_MAX);
+    }
+
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    const UniChar *characters = CFStringGetCharactersPtr(cfString);
+    UniChar buffer[kJSQMessageFingerprintBufferLength];
+
+    //  FNV-1a over the UTF-16 code units, copied in chunks when the storage is not UTF-16
+    for (CFIndex location = 0; location < length; location += kJSQMessageFingerprintBufferLength) {
+        CFIndex chunkLength = MIN(length - location, kJSQMessageFingerprintBufferLength);
+        const UniChar *chunk = characters ? characters + location : buffer;
+
+        if (characters == NULL) {
+            CFStringGetCharacters(cfString, CFRangeMake(location, chunkLength), buffer);
+        }
+
+        for (CFIndex i = 0; i < chunkLength; i++) {
+            fingerprint = (fingerprint ^ chunk[i]) * kJSQMessageFingerprintPrime;
+        }
+    }
+
+    //  the length separates consecutive strings
+    return JSQMessageFingerprintAppendValue(fingerprint, (uint64_t)length);
+}
+
 
 @interface JSQMessage ()
 
@@ -26,6 +78,17 @@
                             date:(NSDate *)date
                          isMedia:(BOOL)isMedia;
 
+- (void)jsq_internSenderId:(NSString *)senderId senderDisplayName:(NSString *)senderDisplayName;
+
+- (uint64_t)jsq_computeMessageFingerprint;
+
++ (uint64_t)jsq_fingerprintWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+                           timeInterval:(NSTimeInterval)timeInterval
+                                isMedia:(BOOL)isMedia
+                             mediaClass:(Class)mediaClass
+                                   text:(NSString *)text;
+
 @end
 
 
@@ -54,6 +117,7 @@
     self = [self initWithSenderId:senderId senderDisplayName:senderDisplayName date:date isMedia:NO];
     if (self) {
         _text = [text copy];
+        _messageFingerprint = [self jsq_computeMessageFingerprint];
     }
     return self;
 }
@@ -78,6 +142,7 @@
     self = [self initWithSenderId:senderId senderDisplayName:senderDisplayName date:date isMedia:YES];
     if (self) {
         _media = media;
+        _messageFingerprint = [self jsq_computeMessageFingerprint];
     }
     return self;
 }
@@ -93,8 +158,7 @@
 
     self = [super init];
     if (self) {
-        _senderId = [senderId copy];
-        _senderDisplayName = [senderDisplayName copy];
+        [self jsq_internSenderId:senderId senderDisplayName:senderDisplayName];
         _date = [date copy];
         _isMediaMessage = isMedia;
     }
@@ -116,6 +180,70 @@
     _media = nil;
 }
 
+- (void)jsq_internSenderId:(NSString *)senderId senderDisplayName:(NSString *)senderDisplayName
+{
+    JSQMessagesSenderTable *senderTable = [JSQMessagesSenderTable sharedTable];
+
+    //  archives written before senders were interned may have no sender identifier
+    _senderOrdinal = (senderId != nil) ? [senderTable ordinalForSenderId:senderId] : JSQMessagesSenderOrdinalNone;
+    _senderId = [senderTable senderIdForOrdinal:_senderOrdinal];
+    _senderDisplayName = [senderTable internedString:senderDisplayName];
+}
+
+- (uint64_t)jsq_computeMessageFingerprint
+{
+    return [JSQMessage jsq_fingerprintWithSenderId:self.senderId
+                                 senderDisplayName:self.senderDisplayName
+                                      timeInterval:[self.date timeIntervalSinceReferenceDate]
+                                           isMedia:self.isMediaMessage
+                                        mediaClass:[self.media class]
+                                              text:self.text];
+}
+
++ (uint64_t)fingerprintForTextMessageWithSenderId:(NSString *)senderId
+                                senderDisplayName:(NSString *)senderDisplayName
+                   timeIntervalSinceReferenceDate:(NSTimeInterval)timeInterval
+                                             text:(NSString *)text
+{
+    NSParameterAssert(senderId != nil);
+    NSParameterAssert(senderDisplayName != nil);
+    NSParameterAssert(text != nil);
+
+    return [JSQMessage jsq_fingerprintWithSenderId:senderId
+                                 senderDisplayName:senderDisplayName
+                                      timeInterval:timeInterval
+                                           isMedia:NO
+                                        mediaClass:Nil
+                                              text:text];
+}
+
++ (uint64_t)jsq_fingerprintWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+                           timeInterval:(NSTimeInterval)timeInterval
+                                isMedia:(BOOL)isMedia
+                             mediaClass:(Class)mediaClass
+                                   text:(NSString *)text
+{
+    uint64_t timeIntervalBits = 0;
+    memcpy(&timeIntervalBits, &timeInterval, sizeof(timeIntervalBits));
+
+    uint64_t fingerprint = kJSQMessageFingerprintOffsetBasis;
+    fingerprint = JSQMessageFingerprintAppendString(fingerprint, senderId);
+    fingerprint = JSQMessageFingerprintAppendString(fingerprint, senderDisplayName);
+    fingerprint = JSQMessageFingerprintAppendValue(fingerprint, timeIntervalBits);
+    fingerprint = JSQMessageFingerprintAppendValue(fingerprint, isMedia);
+
+    if (isMedia) {
+        //  media items change after creation and their hashes differ across launches, only their class is stable
+        fingerprint = JSQMessageFingerprintAppendString(fingerprint, NSStringFromClass(mediaClass));
+    }
+    else {
+        fingerprint = JSQMessageFingerprintAppendString(fingerprint, text);
+    }
+
+    return JSQMessageFingerprintAvalanche(fingerprint);
+}
+
 - (NSUInteger)messageHash
 {
     return self.hash;
@@ -135,13 +263,13 @@
 
     JSQMessage *aMessage = (JSQMessage *)object;
 
-    if (self.isMediaMessage != aMessage.isMediaMessage) {
+    if (self.messageFingerprint != aMessage.messageFingerprint || self.isMediaMessage != aMessage.isMediaMessage) {
         return NO;
     }
 
     BOOL hasEqualContent = self.isMediaMessage ? [self.media isEqual:aMessage.media] : [self.text isEqualToString:aMessage.text];
 
-    return [self.senderId isEqualToString:aMessage.senderId]
+    return self.senderOrdinal == aMessage.senderOrdinal
     && [self.senderDisplayName isEqualToString:aMessage.senderDisplayName]
     && ([self.date compare:aMessage.date] == NSOrderedSame)
     && hasEqualContent;
@@ -149,14 +277,13 @@
 
 - (NSUInteger)hash
 {
-    NSUInteger contentHash = self.isMediaMessage ? [self.media mediaHash] : self.text.hash;
-    return self.senderId.hash ^ self.date.hash ^ contentHash;
+    return (NSUInteger)self.messageFingerprint;
 }
 
 - (NSString *)description
 {
-    return [NSString stringWithFormat:@"<%@: senderId=%@, senderDisplayName=%@, date=%@, isMediaMessage=%@, text=%@, media=%@>",
-            [self class], self.senderId, self.senderDisplayName, self.date, @(self.isMediaMessage), self.text, self.media];
+    return [NSString stringWithFormat:@"<%@: senderId=%@, senderOrdinal=%@, senderDisplayName=%@, date=%@, isMediaMessage=%@, text=%@, media=%@, messageFingerprint=%016llx>",
+            [self class], self.senderId, @(self.senderOrdinal), self.senderDisplayName, self.date, @(self.isMediaMessage), self.text, self.media, self.messageFingerprint];
 }
 
 - (id)debugQuickLookObject
@@ -170,12 +297,13 @@
 {
     self = [super init];
     if (self) {
-        _senderId = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(senderId))];
-        _senderDisplayName = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(senderDisplayName))];
+        [self jsq_internSenderId:[aDecoder decodeObjectForKey:NSStringFromSelector(@selector(senderId))]
+               senderDisplayName:[aDecoder decodeObjectForKey:NSStringFromSelector(@selector(senderDisplayName))]];
         _date = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(date))];
         _isMediaMessage = [aDecoder decodeBoolForKey:NSStringFromSelector(@selector(isMediaMessage))];
         _text = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(text))];
         _media = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(media))];
+        _messageFingerprint = [self jsq_computeMessageFingerprint];
     }
     return self;
 }
@@ -197,17 +325,22 @@
 
 - (instancetype)copyWithZone:(NSZone *)zone
 {
+    JSQMessage *copy = nil;
+
     if (self.isMediaMessage) {
-        return [[[self class] allocWithZone:zone] initWithSenderId:self.senderId
+        copy = [[[self class] allocWithZone:zone] initWithSenderId:self.senderId
                                                  senderDisplayName:self.senderDisplayName
                                                               date:self.date
                                                              media:self.media];
     }
+    else {
+        copy = [[[self class] allocWithZone:zone] initWithSenderId:self.senderId
+                                                 senderDisplayName:self.senderDisplayName
+                                                              date:self.date
+                                                              text:self.text];
+    }
 
-    return [[[self class] allocWithZone:zone] initWithSenderId:self.senderId
-                                             senderDisplayName:self.senderDisplayName
-                                                          date:self.date
-                                                          text:self.text];
+    return copy;
 }
 
 @end
@@ -77,7 +77,8 @@
  *  @return An integer that can be used as a table address in a hash table structure.
  *
  *  @discussion This value must be unique for each message with distinct contents. 
- *  This value is used to cache layout information in the collection view.
+ *  This value is used to cache layout information in the collection view,
+ *  unless the message data implements `messageFingerprint`.
  */
 - (NSUInteger)messageHash;
 
@@ -97,4 +98,43 @@
  */
 - (id<JSQMessageMediaData>)media;
 
+/**
+ *  @return The ordinal of `senderId` in the shared `JSQMessagesSenderTable`.
+ *
+ *  @discussion When this method and `senderOrdinal` of the collection view data source are implemented,
+ *  outgoing messages are found by comparing ordinals instead of sender identifiers.
+ *  The value must be equal to `[[JSQMessagesSenderTable sharedTable] ordinalForSenderId:[self senderId]]`.
+ *
+ *  @see JSQMessagesSenderTable.
+ */
+- (NSUInteger)senderOrdinal;
+
+/**
+ *  @return A 64-bit fingerprint of the sender, date and contents of the message.
+ *
+ *  @discussion The fingerprint should be computed once, when the message is created, and must not change afterwards.
+ *  Messages with distinct contents should have distinct fingerprints. When implemented, this value is used
+ *  instead of `messageHash` as the key of the layout and link caches.
+ *
+ *  @see JSQMessageDataFingerprint.
+ */
+- (uint64_t)messageFingerprint;
+
 @end
+
+
+/**
+ *  Returns the key used to cache information about the given message data.
+ *
+ *  @param messageData The message data.
+ *
+ *  @return The `messageFingerprint` of messageData if it implements it, its `messageHash` otherwise.
+ */
+NS_INLINE uint64_t JSQMessageDataFingerprint(id<JSQMessageData> messageData)
+{
+    if ([messageData respondsToSelector:@selector(messageFingerprint)]) {
+        return [messageData messageFingerprint];
+    }
+
+    return [messageData messageHash];
+}
@@ -0,0 +1,122 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+#import "JSQMessageData.h"
+
+@class JSQMessage;
+@class JSQMessagesColumnStore;
+
+/**
+ *  The version of the binary format written by `JSQMessagesBinaryArchive`.
+ */
+FOUNDATION_EXPORT const uint8_t JSQMessagesBinaryArchiveVersion;
+
+/**
+ *  A `JSQMessagesBinaryArchive` object reads and writes messages in a compact, versioned binary format,
+ *  as an alternative to keyed archiving of `JSQMessage` objects for large histories.
+ *
+ *  @discussion An archive starts with a magic number and a version byte, followed by a table of the distinct
+ *  senders, each written once as a sender identifier and a display name, and by the messages.
+ *  Each message is written as the index of its sender in the table, its date as a varint, a type tag,
+ *  and its payload. Strings are written as a varint byte length followed by UTF-8 bytes.
+ *  Dates are written as the zigzag varint difference between the IEEE 754 bit patterns of consecutive
+ *  time intervals, so they round-trip exactly and messages sent close together take a few bytes.
+ *  Text, photo, location and video messages are supported. Other media items are read back as an empty `JSQMediaItem`.
+ *
+ *  Reading an archive does not copy its data, which can be memory-mapped with `initWithContentsOfFile:`.
+ *  The initializer validates the archive and indexes the messages in one pass without creating any object,
+ *  and each message is decoded on demand by `messageAtIndex:`.
+ *
+ *  Text messages round-trip exactly: the sender, date, text and `messageFingerprint` of a decoded
+ *  message are equal to those of the original. Media items are recreated, and the fingerprint
+ *  of a decoded media message is equal to that of the original when the media item has the same class.
+ *
+ *  The binary format itself is read and written by the plain C functions of `JSQMessagesBinaryArchiveCodec.h`,
+ *  an internal header that is not part of `JSQMessages.h`.
+ */
+@interface JSQMessagesBinaryArchive : NSObject
+
+/**
+ *  The data of the archive.
+ */
+@property (strong, nonatomic, readonly) NSData *data;
+
+/**
+ *  The number of messages in the archive.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  Returns the binary archive data of the given messages.
+ *
+ *  @param messages An array of objects conforming to the `JSQMessageData` protocol. This value must not be `nil`.
+ *
+ *  @return The archive data, or `nil` if it could not be allocated.
+ */
++ (NSData *)dataWithMessages:(NSArray *)messages;
+
+/**
+ *  Returns the binary archive data of the messages in the given column store.
+ *  The text of text messages is copied from the store without creating any string.
+ *
+ *  @param columnStore A column store. This value must not be `nil`.
+ *
+ *  @return The archive data, or `nil` if it could not be allocated.
+ */
++ (NSData *)dataWithColumnStore:(JSQMessagesColumnStore *)columnStore;
+
+/**
+ *  Initializes and returns an archive reading the given data.
+ *
+ *  @param data The archive data. This value must not be `nil`. It is retained, not copied.
+ *
+ *  @return An initialized `JSQMessagesBinaryArchive` object, or `nil` if the data is not a valid archive,
+ *  contains a string that is not well-formed UTF-8, or was written with an unsupported version.
+ */
+- (instancetype)initWithData:(NSData *)data NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Initializes and returns an archive reading the file at the given path, memory-mapped when possible.
+ *
+ *  @param path The path of the archive file. This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesBinaryArchive` object, or `nil` if the file cannot be read or is not a valid archive.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path;
+
+/**
+ *  Decodes and returns the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return A new `JSQMessage` object.
+ */
+- (JSQMessage *)messageAtIndex:(NSUInteger)index;
+
+/**
+ *  Appends all messages of the archive to the given column store. The text of text messages is copied
+ *  from the archive into the store without creating any string or message object.
+ *
+ *  @param columnStore A column store. This value must not be `nil`.
+ */
+- (void)appendMessagesToColumnStore:(JSQMessagesColumnStore *)columnStore;
+
+@end
@@ -0,0 +1,498 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesBinaryArchive.h"
+
+#import <UIKit/UIKit.h>
+#import <CoreLocation/CoreLocation.h>
+
+#import "JSQMessage.h"
+#import "JSQMessagesBinaryArchiveCodec.h"
+#import "JSQMessagesColumnStore.h"
+#import "JSQPhotoMediaItem.h"
+#import "JSQLocationMediaItem.h"
+#import "JSQVideoMediaItem.h"
+
+
+const uint8_t JSQMessagesBinaryArchiveVersion = 1;
+
+
+static void JSQMessagesBinaryWriteString(JSQMessagesBinaryWriter *writer, NSString *string)
+{
+    NSUInteger length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    JSQMessagesBinaryWriteVarint(writer, length);
+
+    //  encode directly into the archive
+    uint8_t *bytes = JSQMessagesBinaryWriterReserve(writer, length);
+    if (bytes == NULL) {
+        return;
+    }
+
+    [string getBytes:bytes
+           maxLength:length
+          usedLength:NULL
+            encoding:NSUTF8StringEncoding
+             options:0
+               range:NSMakeRange(0, string.length)
+      remainingRange:NULL];
+}
+
+static NSString * JSQMessagesBinaryStringWithBytes(const uint8_t *bytes, NSUInteger length)
+{
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+}
+
+
+@interface JSQMessagesBinaryArchive ()
+
+@property (assign, nonatomic, readwrite) NSUInteger count;
+
+@property (strong, nonatomic, readonly) NSMutableArray *senderIds;
+
+@property (strong, nonatomic, readonly) NSMutableArray *senderDisplayNames;
+
+@property (strong, nonatomic, readonly) NSMutableData *recordOffsets;
+
+@property (strong, nonatomic, readonly) NSMutableData *timeIntervals;
+
++ (NSData *)jsq_dataWithCount:(NSUInteger)count
+               senderForIndex:(void (^)(NSUInteger index, NSString **senderId, NSString **senderDisplayName))senderForIndex
+                  writeRecord:(void (^)(NSUInteger index, JSQMessagesBinaryRecord *record, JSQMessagesBinaryWriter *writer))writeRecord
+                 dateForIndex:(NSTimeInterval (^)(NSUInteger index))dateForIndex;
+
++ (void)jsq_writeMessage:(id<JSQMessageData>)message record:(JSQMessagesBinaryRecord *)record toWriter:(JSQMessagesBinaryWriter *)writer;
+
+- (BOOL)jsq_readArchive;
+
+- (JSQMessagesBinaryRecord)jsq_recordAtIndex:(NSUInteger)index;
+
+- (id<JSQMessageMediaData>)jsq_mediaForRecord:(JSQMessagesBinaryRecord)record;
+
+@end
+
+
+
+@implementation JSQMessagesBinaryArchive
+
+#pragma mark - Initialization
+
+- (instancetype)initWithData:(NSData *)data
+{
+    NSParameterAssert(data != nil);
+
+    self = [super init];
+    if (self) {
+        _data = data;
+        _senderIds = [NSMutableArray new];
+        _senderDisplayNames = [NSMutableArray new];
+        _recordOffsets = [NSMutableData new];
+        _timeIntervals = [NSMutableData new];
+
+        if (![self jsq_readArchive]) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path
+{
+    NSParameterAssert(path != nil);
+
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (data == nil) {
+        return nil;
+    }
+
+    return [self initWithData:data];
+}
+
+- (id)init
+{
+    NSAssert(NO, @"%s is not a valid initializer for %@.", __PRETTY_FUNCTION__, [self class]);
+    return nil;
+}
+
+- (void)dealloc
+{
+    _data = nil;
+    _senderIds = nil;
+    _senderDisplayNames = nil;
+    _recordOffsets = nil;
+    _timeIntervals = nil;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: count=%@, senders=%@, length=%@>",
+            [self class], @(self.count), @(self.senderIds.count), @(self.data.length)];
+}
+
+#pragma mark - Writing
+
++ (NSData *)dataWithMessages:(NSArray *)messages
+{
+    NSParameterAssert(messages != nil);
+
+    return [self jsq_dataWithCount:messages.count
+                    senderForIndex:^(NSUInteger index, NSString **senderId, NSString **senderDisplayName) {
+                        id<JSQMessageData> message = [messages objectAtIndex:index];
+                        *senderId = [message senderId];
+                        *senderDisplayName = [message senderDisplayName];
+                    }
+                       writeRecord:^(NSUInteger index, JSQMessagesBinaryRecord *record, JSQMessagesBinaryWriter *writer) {
+                           [JSQMessagesBinaryArchive jsq_writeMessage:[messages objectAtIndex:index] record:record toWriter:writer];
+                       }
+                      dateForIndex:^NSTimeInterval(NSUInteger index) {
+                          return [[[messages objectAtIndex:index] date] timeIntervalSinceReferenceDate];
+                      }];
+}
+
++ (NSData *)dataWithColumnStore:(JSQMessagesColumnStore *)columnStore
+{
+    NSParameterAssert(columnStore != nil);
+
+    return [self jsq_dataWithCount:columnStore.count
+                    senderForIndex:^(NSUInteger index, NSString **senderId, NSString **senderDisplayName) {
+                        *senderId = [columnStore senderIdAtIndex:index];
+                        *senderDisplayName = [columnStore senderDisplayNameAtIndex:index];
+                    }
+                       writeRecord:^(NSUInteger index, JSQMessagesBinaryRecord *record, JSQMessagesBinaryWriter *writer) {
+                           if ([columnStore isMediaMessageAtIndex:index]) {
+                               [JSQMessagesBinaryArchive jsq_writeMessage:[columnStore messageAtIndex:index] record:record toWriter:writer];
+                               return;
+                           }
+
+                           NSUInteger length = 0;
+                           record->type = JSQMessagesBinaryArchiveTypeText;
+                           record->string = [columnStore UTF8BytesAtIndex:index length:&length];
+                           record->stringLength = length;
+
+                           JSQMessagesBinaryWriteRecord(writer, record);
+                       }
+                      dateForIndex:^NSTimeInterval(NSUInteger index) {
+                          return [columnStore timeIntervalSinceReferenceDateAtIndex:index];
+                      }];
+}
+
++ (NSData *)jsq_dataWithCount:(NSUInteger)count
+               senderForIndex:(void (^)(NSUInteger index, NSString **senderId, NSString **senderDisplayName))senderForIndex
+                  writeRecord:(void (^)(NSUInteger index, JSQMessagesBinaryRecord *record, JSQMessagesBinaryWriter *writer))writeRecord
+                 dateForIndex:(NSTimeInterval (^)(NSUInteger index))dateForIndex
+{
+    //  the sender table precedes the records, so the records are written first into a separate buffer
+    JSQMessagesBinaryWriter senders;
+    JSQMessagesBinaryWriter records;
+    JSQMessagesBinaryWriterInit(&senders, 0);
+    JSQMessagesBinaryWriterInit(&records, 16 * count);
+
+    NSMutableDictionary *senderIndexes = [NSMutableDictionary new];
+    NSUInteger senderCount = 0;
+    uint64_t previousDateBits = 0;
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *senderId = nil;
+        NSString *senderDisplayName = nil;
+        senderForIndex(i, &senderId, &senderDisplayName);
+
+        NSParameterAssert(senderId != nil);
+        NSParameterAssert(senderDisplayName != nil);
+
+        NSMutableDictionary *indexesForDisplayNames = [senderIndexes objectForKey:senderId];
+        if (indexesForDisplayNames == nil) {
+            indexesForDisplayNames = [NSMutableDictionary new];
+            [senderIndexes setObject:indexesForDisplayNames forKey:senderId];
+        }
+
+        NSNumber *senderIndex = [indexesForDisplayNames objectForKey:senderDisplayName];
+        if (senderIndex == nil) {
+            senderIndex = @(senderCount++);
+            [indexesForDisplayNames setObject:senderIndex forKey:senderDisplayName];
+
+            JSQMessagesBinaryWriteString(&senders, senderId);
+            JSQMessagesBinaryWriteString(&senders, senderDisplayName);
+        }
+
+        uint64_t dateBits = JSQMessagesBinaryBitsOfDouble(dateForIndex(i));
+
+        JSQMessagesBinaryRecord record;
+        memset(&record, 0, sizeof(record));
+        record.senderIndex = senderIndex.unsignedLongLongValue;
+        record.encodedDateDelta = JSQMessagesBinaryZigzagEncode((int64_t)(dateBits - previousDateBits));
+        writeRecord(i, &record, &records);
+
+        previousDateBits = dateBits;
+    }
+
+    //  magic number, version and two varints
+    JSQMessagesBinaryWriter archive;
+    JSQMessagesBinaryWriterInit(&archive, 4 + 1 + 20 + senders.length + records.length);
+    JSQMessagesBinaryWriteHeader(&archive, JSQMessagesBinaryArchiveVersion);
+    JSQMessagesBinaryWriteVarint(&archive, senderCount);
+    JSQMessagesBinaryWriteRaw(&archive, senders.bytes, senders.length);
+    JSQMessagesBinaryWriteVarint(&archive, count);
+    JSQMessagesBinaryWriteRaw(&archive, records.bytes, records.length);
+
+    BOOL failed = (senders.failed || records.failed || archive.failed);
+    free(senders.bytes);
+    free(records.bytes);
+
+    if (failed) {
+        free(archive.bytes);
+        return nil;
+    }
+
+    return [NSData dataWithBytesNoCopy:archive.bytes length:archive.length freeWhenDone:YES];
+}
+
++ (void)jsq_writeMessage:(id<JSQMessageData>)message record:(JSQMessagesBinaryRecord *)record toWriter:(JSQMessagesBinaryWriter *)writer
+{
+    if (![message isMediaMessage]) {
+        NSData *textData = [[message text] dataUsingEncoding:NSUTF8StringEncoding];
+
+        record->type = JSQMessagesBinaryArchiveTypeText;
+        record->string = textData.bytes;
+        record->stringLength = textData.length;
+
+        JSQMessagesBinaryWriteRecord(writer, record);
+        return;
+    }
+
+    id<JSQMessageMediaData> media = [message media];
+    JSQMessagesBinaryArchiveMediaFlags flags = JSQMessagesBinaryArchiveMediaFlagsNone;
+
+    if ([media isKindOfClass:[JSQMediaItem class]] && ((JSQMediaItem *)media).appliesMediaViewMaskAsOutgoing) {
+        flags |= JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing;
+    }
+
+    NSData *stringData = nil;
+    NSData *payloadData = nil;
+
+    if ([media isKindOfClass:[JSQPhotoMediaItem class]]) {
+        JSQPhotoMediaItem *photoItem = (JSQPhotoMediaItem *)media;
+
+        //  a remote image is loaded again from its URL, only local images are written
+        record->type = JSQMessagesBinaryArchiveTypePhoto;
+        stringData = [(photoItem.imageURL.absoluteString ?: @"") dataUsingEncoding:NSUTF8StringEncoding];
+        payloadData = (photoItem.imageURL == nil && photoItem.image != nil) ? UIImagePNGRepresentation(photoItem.image) : nil;
+    }
+    else if ([media isKindOfClass:[JSQLocationMediaItem class]]) {
+        CLLocation *location = ((JSQLocationMediaItem *)media).location;
+
+        if (location != nil) {
+            flags |= JSQMessagesBinaryArchiveMediaFlagsHasContent;
+        }
+
+        record->type = JSQMessagesBinaryArchiveTypeLocation;
+        record->latitudeBits = JSQMessagesBinaryBitsOfDouble(location.coordinate.latitude);
+        record->longitudeBits = JSQMessagesBinaryBitsOfDouble(location.coordinate.longitude);
+    }
+    else if ([media isKindOfClass:[JSQVideoMediaItem class]]) {
+        JSQVideoMediaItem *videoItem = (JSQVideoMediaItem *)media;
+
+        if (videoItem.isReadyToPlay) {
+            flags |= JSQMessagesBinaryArchiveMediaFlagsReadyToPlay;
+        }
+
+        record->type = JSQMessagesBinaryArchiveTypeVideo;
+        stringData = [(videoItem.fileURL.absoluteString ?: @"") dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    else {
+        record->type = JSQMessagesBinaryArchiveTypeOtherMedia;
+    }
+
+    record->mediaFlags = flags;
+    record->string = stringData.bytes;
+    record->stringLength = stringData.length;
+    record->payload = payloadData.bytes;
+    record->payloadLength = payloadData.length;
+
+    JSQMessagesBinaryWriteRecord(writer, record);
+}
+
+#pragma mark - Reading
+
+- (BOOL)jsq_readArchive
+{
+    JSQMessagesBinaryReader reader = { self.data.bytes, self.data.length, 0 };
+
+    if (!JSQMessagesBinaryReadHeader(&reader, JSQMessagesBinaryArchiveVersion)) {
+        return NO;
+    }
+
+    uint64_t senderCount = 0;
+    if (!JSQMessagesBinaryReadVarint(&reader, &senderCount)) {
+        return NO;
+    }
+
+    for (uint64_t i = 0; i < senderCount; i++) {
+        const uint8_t *senderIdBytes = NULL;
+        const uint8_t *displayNameBytes = NULL;
+        size_t senderIdLength = 0;
+        size_t displayNameLength = 0;
+
+        if (!JSQMessagesBinaryReadBytes(&reader, &senderIdBytes, &senderIdLength)
+            || !JSQMessagesBinaryReadBytes(&reader, &displayNameBytes, &displayNameLength)) {
+            return NO;
+        }
+
+        NSString *senderId = JSQMessagesBinaryStringWithBytes(senderIdBytes, senderIdLength);
+        NSString *displayName = JSQMessagesBinaryStringWithBytes(displayNameBytes, displayNameLength);
+
+        if (senderId == nil || displayName == nil) {
+            return NO;
+        }
+
+        [self.senderIds addObject:senderId];
+        [self.senderDisplayNames addObject:displayName];
+    }
+
+    uint64_t messageCount = 0;
+    if (!JSQMessagesBinaryReadVarint(&reader, &messageCount)) {
+        return NO;
+    }
+
+    //  index the records and resolve the date deltas, nothing else is decoded until a message is requested
+    uint64_t dateBits = 0;
+
+    for (uint64_t i = 0; i < messageCount; i++) {
+        uint64_t recordOffset = reader.offset;
+        JSQMessagesBinaryRecord record;
+
+        if (!JSQMessagesBinaryReadRecord(&reader, &record) || record.senderIndex >= senderCount) {
+            return NO;
+        }
+
+        //  text is later read from the bytes as is, so a record that does not decode to a string is rejected here
+        if (!JSQMessagesBinaryIsValidUTF8(record.string, record.stringLength)) {
+            return NO;
+        }
+
+        dateBits += (uint64_t)JSQMessagesBinaryZigzagDecode(record.encodedDateDelta);
+        NSTimeInterval timeInterval = JSQMessagesBinaryDoubleWithBits(dateBits);
+
+        [self.recordOffsets appendBytes:&recordOffset length:sizeof(recordOffset)];
+        [self.timeIntervals appendBytes:&timeInterval length:sizeof(timeInterval)];
+    }
+
+    self.count = (NSUInteger)messageCount;
+    return YES;
+}
+
+- (JSQMessagesBinaryRecord)jsq_recordAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+
+    uint64_t recordOffset = ((const uint64_t *)self.recordOffsets.bytes)[index];
+    JSQMessagesBinaryReader reader = { self.data.bytes, self.data.length, (NSUInteger)recordOffset };
+
+    //  the record was validated when the archive was read
+    JSQMessagesBinaryRecord record;
+    JSQMessagesBinaryReadRecord(&reader, &record);
+
+    return record;
+}
+
+- (JSQMessage *)messageAtIndex:(NSUInteger)index
+{
+    JSQMessagesBinaryRecord record = [self jsq_recordAtIndex:index];
+
+    NSString *senderId = [self.senderIds objectAtIndex:(NSUInteger)record.senderIndex];
+    NSString *senderDisplayName = [self.senderDisplayNames objectAtIndex:(NSUInteger)record.senderIndex];
+    NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:((const NSTimeInterval *)self.timeIntervals.bytes)[index]];
+
+    if (record.type == JSQMessagesBinaryArchiveTypeText) {
+        return [[JSQMessage alloc] initWithSenderId:senderId
+                                  senderDisplayName:senderDisplayName
+                                               date:date
+                                               text:JSQMessagesBinaryStringWithBytes(record.string, record.stringLength) ?: @""];
+    }
+
+    return [[JSQMessage alloc] initWithSenderId:senderId
+                              senderDisplayName:senderDisplayName
+                                           date:date
+                                          media:[self jsq_mediaForRecord:record]];
+}
+
+- (id<JSQMessageMediaData>)jsq_mediaForRecord:(JSQMessagesBinaryRecord)record
+{
+    JSQMediaItem *mediaItem = nil;
+    NSString *string = (record.stringLength > 0) ? JSQMessagesBinaryStringWithBytes(record.string, record.stringLength) : nil;
+
+    switch (record.type) {
+        case JSQMessagesBinaryArchiveTypePhoto:
+            if (string != nil) {
+                mediaItem = [[JSQPhotoMediaItem alloc] initWithImageURL:[NSURL URLWithString:string]];
+            }
+            else {
+                //  the image decoder keeps its own copy of the bytes, the archive may be unmapped later
+                NSData *imageData = [NSData dataWithBytes:record.payload length:record.payloadLength];
+                mediaItem = [[JSQPhotoMediaItem alloc] initWithImage:(imageData.length > 0) ? [UIImage imageWithData:imageData] : nil];
+            }
+            break;
+
+        case JSQMessagesBinaryArchiveTypeLocation: {
+            CLLocation *location = nil;
+            if ((record.mediaFlags & JSQMessagesBinaryArchiveMediaFlagsHasContent) != 0) {
+                location = [[CLLocation alloc] initWithLatitude:JSQMessagesBinaryDoubleWithBits(record.latitudeBits)
+                                                      longitude:JSQMessagesBinaryDoubleWithBits(record.longitudeBits)];
+            }
+            mediaItem = [[JSQLocationMediaItem alloc] initWithLocation:location];
+            break;
+        }
+
+        case JSQMessagesBinaryArchiveTypeVideo:
+            mediaItem = [[JSQVideoMediaItem alloc] initWithFileURL:(string != nil) ? [NSURL URLWithString:string] : nil
+                                                     isReadyToPlay:(record.mediaFlags & JSQMessagesBinaryArchiveMediaFlagsReadyToPlay) != 0];
+            break;
+
+        default:
+            mediaItem = [[JSQMediaItem alloc] init];
+            break;
+    }
+
+    mediaItem.appliesMediaViewMaskAsOutgoing = (record.mediaFlags & JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing) != 0;
+    return mediaItem;
+}
+
+- (void)appendMessagesToColumnStore:(JSQMessagesColumnStore *)columnStore
+{
+    NSParameterAssert(columnStore != nil);
+
+    const NSTimeInterval *timeIntervals = self.timeIntervals.bytes;
+
+    for (NSUInteger i = 0; i < self.count; i++) {
+        JSQMessagesBinaryRecord record = [self jsq_recordAtIndex:i];
+
+        if (record.type != JSQMessagesBinaryArchiveTypeText) {
+            [columnStore appendMessage:[self messageAtIndex:i]];
+            continue;
+        }
+
+        [columnStore appendMessageWithSenderId:[self.senderIds objectAtIndex:(NSUInteger)record.senderIndex]
+                             senderDisplayName:[self.senderDisplayNames objectAtIndex:(NSUInteger)record.senderIndex]
+                timeIntervalSinceReferenceDate:timeIntervals[i]
+                                     UTF8Bytes:record.string
+                                        length:record.stringLength];
+    }
+}
+
+@end
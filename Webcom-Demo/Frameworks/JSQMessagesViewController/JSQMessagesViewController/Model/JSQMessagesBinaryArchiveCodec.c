@@ -0,0 +1,350 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#include "JSQMessagesBinaryArchiveCodec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+static const uint8_t kJSQMessagesBinaryArchiveMagic[4] = { 'J', 'S', 'Q', 'M' };
+
+
+//  MARK: - Values
+
+uint64_t JSQMessagesBinaryBitsOfDouble(double value)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double JSQMessagesBinaryDoubleWithBits(uint64_t bits)
+{
+    double value = 0.0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint64_t JSQMessagesBinaryZigzagEncode(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+int64_t JSQMessagesBinaryZigzagDecode(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+
+//  MARK: - Writing
+
+void JSQMessagesBinaryWriterInit(JSQMessagesBinaryWriter *writer, size_t capacity)
+{
+    writer->bytes = (capacity > 0) ? malloc(capacity) : NULL;
+    writer->length = 0;
+    writer->capacity = (writer->bytes != NULL) ? capacity : 0;
+    writer->failed = (capacity > 0 && writer->bytes == NULL);
+}
+
+uint8_t *JSQMessagesBinaryWriterReserve(JSQMessagesBinaryWriter *writer, size_t length)
+{
+    if (writer->failed || length > SIZE_MAX - writer->length) {
+        writer->failed = true;
+        return NULL;
+    }
+
+    size_t requiredCapacity = writer->length + length;
+
+    if (requiredCapacity > writer->capacity) {
+        //  grow geometrically, so that appending n bytes one at a time costs O(n)
+        size_t capacity = (writer->capacity > 0) ? writer->capacity : 64;
+        while (capacity < requiredCapacity) {
+            capacity = (capacity > SIZE_MAX / 2) ? requiredCapacity : capacity * 2;
+        }
+
+        uint8_t *bytes = realloc(writer->bytes, capacity);
+        if (bytes == NULL) {
+            writer->failed = true;
+            return NULL;
+        }
+
+        writer->bytes = bytes;
+        writer->capacity = capacity;
+    }
+
+    uint8_t *reservedBytes = writer->bytes + writer->length;
+    writer->length = requiredCapacity;
+    return reservedBytes;
+}
+
+void JSQMessagesBinaryWriteRaw(JSQMessagesBinaryWriter *writer, const void *bytes, size_t length)
+{
+    uint8_t *destination = JSQMessagesBinaryWriterReserve(writer, length);
+    if (destination != NULL && length > 0) {
+        memcpy(destination, bytes, length);
+    }
+}
+
+void JSQMessagesBinaryWriteByte(JSQMessagesBinaryWriter *writer, uint8_t value)
+{
+    uint8_t *bytes = JSQMessagesBinaryWriterReserve(writer, 1);
+    if (bytes != NULL) {
+        bytes[0] = value;
+    }
+}
+
+void JSQMessagesBinaryWriteVarint(JSQMessagesBinaryWriter *writer, uint64_t value)
+{
+    uint8_t buffer[10];
+    size_t length = 0;
+
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        buffer[length++] = byte | (value != 0 ? 0x80 : 0x00);
+    } while (value != 0);
+
+    uint8_t *bytes = JSQMessagesBinaryWriterReserve(writer, length);
+    if (bytes != NULL) {
+        memcpy(bytes, buffer, length);
+    }
+}
+
+void JSQMessagesBinaryWriteFixed64(JSQMessagesBinaryWriter *writer, uint64_t value)
+{
+    uint8_t *bytes = JSQMessagesBinaryWriterReserve(writer, 8);
+    if (bytes == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+void JSQMessagesBinaryWriteBytes(JSQMessagesBinaryWriter *writer, const void *bytes, size_t length)
+{
+    JSQMessagesBinaryWriteVarint(writer, length);
+    JSQMessagesBinaryWriteRaw(writer, bytes, length);
+}
+
+void JSQMessagesBinaryWriteHeader(JSQMessagesBinaryWriter *writer, uint8_t version)
+{
+    JSQMessagesBinaryWriteRaw(writer, kJSQMessagesBinaryArchiveMagic, sizeof(kJSQMessagesBinaryArchiveMagic));
+    JSQMessagesBinaryWriteByte(writer, version);
+}
+
+void JSQMessagesBinaryWriteRecord(JSQMessagesBinaryWriter *writer, const JSQMessagesBinaryRecord *record)
+{
+    JSQMessagesBinaryWriteVarint(writer, record->senderIndex);
+    JSQMessagesBinaryWriteVarint(writer, record->encodedDateDelta);
+    JSQMessagesBinaryWriteByte(writer, record->type);
+
+    if (record->type == JSQMessagesBinaryArchiveTypeText) {
+        JSQMessagesBinaryWriteBytes(writer, record->string, record->stringLength);
+        return;
+    }
+
+    JSQMessagesBinaryWriteByte(writer, record->mediaFlags);
+
+    switch (record->type) {
+        case JSQMessagesBinaryArchiveTypePhoto:
+            JSQMessagesBinaryWriteBytes(writer, record->string, record->stringLength);
+            JSQMessagesBinaryWriteBytes(writer, record->payload, record->payloadLength);
+            break;
+
+        case JSQMessagesBinaryArchiveTypeLocation:
+            JSQMessagesBinaryWriteFixed64(writer, record->latitudeBits);
+            JSQMessagesBinaryWriteFixed64(writer, record->longitudeBits);
+            break;
+
+        case JSQMessagesBinaryArchiveTypeVideo:
+            JSQMessagesBinaryWriteBytes(writer, record->string, record->stringLength);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+//  MARK: - Reading
+
+bool JSQMessagesBinaryReadByte(JSQMessagesBinaryReader *reader, uint8_t *value)
+{
+    if (reader->offset >= reader->length) {
+        return false;
+    }
+
+    *value = reader->bytes[reader->offset++];
+    return true;
+}
+
+bool JSQMessagesBinaryReadVarint(JSQMessagesBinaryReader *reader, uint64_t *value)
+{
+    uint64_t result = 0;
+
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (reader->offset >= reader->length) {
+            return false;
+        }
+
+        uint8_t byte = reader->bytes[reader->offset++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JSQMessagesBinaryReadFixed64(JSQMessagesBinaryReader *reader, uint64_t *value)
+{
+    if (reader->length - reader->offset < 8) {
+        return false;
+    }
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < 8; i++) {
+        result |= (uint64_t)reader->bytes[reader->offset + i] << (8 * i);
+    }
+
+    reader->offset += 8;
+    *value = result;
+    return true;
+}
+
+bool JSQMessagesBinaryReadBytes(JSQMessagesBinaryReader *reader, const uint8_t **bytes, size_t *length)
+{
+    uint64_t byteLength = 0;
+    if (!JSQMessagesBinaryReadVarint(reader, &byteLength) || byteLength > reader->length - reader->offset) {
+        return false;
+    }
+
+    *bytes = reader->bytes + reader->offset;
+    *length = (size_t)byteLength;
+    reader->offset += (size_t)byteLength;
+    return true;
+}
+
+bool JSQMessagesBinaryReadHeader(JSQMessagesBinaryReader *reader, uint8_t version)
+{
+    if (reader->length - reader->offset < sizeof(kJSQMessagesBinaryArchiveMagic)
+        || memcmp(reader->bytes + reader->offset, kJSQMessagesBinaryArchiveMagic, sizeof(kJSQMessagesBinaryArchiveMagic)) != 0) {
+        return false;
+    }
+
+    reader->offset += sizeof(kJSQMessagesBinaryArchiveMagic);
+
+    uint8_t archiveVersion = 0;
+    return JSQMessagesBinaryReadByte(reader, &archiveVersion) && archiveVersion == version;
+}
+
+bool JSQMessagesBinaryReadRecord(JSQMessagesBinaryReader *reader, JSQMessagesBinaryRecord *record)
+{
+    memset(record, 0, sizeof(*record));
+
+    if (!JSQMessagesBinaryReadVarint(reader, &record->senderIndex)
+        || !JSQMessagesBinaryReadVarint(reader, &record->encodedDateDelta)
+        || !JSQMessagesBinaryReadByte(reader, &record->type)) {
+        return false;
+    }
+
+    if (record->type == JSQMessagesBinaryArchiveTypeText) {
+        return JSQMessagesBinaryReadBytes(reader, &record->string, &record->stringLength);
+    }
+
+    if (!JSQMessagesBinaryReadByte(reader, &record->mediaFlags)) {
+        return false;
+    }
+
+    switch (record->type) {
+        case JSQMessagesBinaryArchiveTypePhoto:
+            return JSQMessagesBinaryReadBytes(reader, &record->string, &record->stringLength)
+                && JSQMessagesBinaryReadBytes(reader, &record->payload, &record->payloadLength);
+
+        case JSQMessagesBinaryArchiveTypeLocation:
+            return JSQMessagesBinaryReadFixed64(reader, &record->latitudeBits)
+                && JSQMessagesBinaryReadFixed64(reader, &record->longitudeBits);
+
+        case JSQMessagesBinaryArchiveTypeVideo:
+            return JSQMessagesBinaryReadBytes(reader, &record->string, &record->stringLength);
+
+        case JSQMessagesBinaryArchiveTypeOtherMedia:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool JSQMessagesBinaryIsValidUTF8(const uint8_t *bytes, size_t length)
+{
+    size_t i = 0;
+
+    while (i < length) {
+        uint8_t byte = bytes[i];
+
+        //  ASCII runs are the common case
+        if (byte < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t sequenceLength = 0;
+        uint8_t min = 0x80;
+        uint8_t max = 0xbf;
+
+        //  the bounds of the second byte exclude overlong encodings, surrogates and code points above U+10FFFF
+        if (byte >= 0xc2 && byte <= 0xdf) {
+            sequenceLength = 2;
+        }
+        else if (byte >= 0xe0 && byte <= 0xef) {
+            sequenceLength = 3;
+            min = (byte == 0xe0) ? 0xa0 : 0x80;
+            max = (byte == 0xed) ? 0x9f : 0xbf;
+        }
+        else if (byte >= 0xf0 && byte <= 0xf4) {
+            sequenceLength = 4;
+            min = (byte == 0xf0) ? 0x90 : 0x80;
+            max = (byte == 0xf4) ? 0x8f : 0xbf;
+        }
+        else {
+            return false;
+        }
+
+        if (length - i < sequenceLength || bytes[i + 1] < min || bytes[i + 1] > max) {
+            return false;
+        }
+
+        for (size_t j = 2; j < sequenceLength; j++) {
+            if ((bytes[i + j] & 0xc0) != 0x80) {
+                return false;
+            }
+        }
+
+        i += sequenceLength;
+    }
+
+    return true;
+}
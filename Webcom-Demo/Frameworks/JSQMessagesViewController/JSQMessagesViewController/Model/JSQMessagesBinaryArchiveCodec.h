@@ -0,0 +1,216 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#ifndef JSQMessagesBinaryArchiveCodec_h
+#define JSQMessagesBinaryArchiveCodec_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The type of a message record.
+ */
+typedef uint8_t JSQMessagesBinaryArchiveType;
+
+enum {
+    JSQMessagesBinaryArchiveTypeText = 0,
+    JSQMessagesBinaryArchiveTypePhoto = 1,
+    JSQMessagesBinaryArchiveTypeLocation = 2,
+    JSQMessagesBinaryArchiveTypeVideo = 3,
+    JSQMessagesBinaryArchiveTypeOtherMedia = 255
+};
+
+/**
+ *  The flags of a media message record.
+ */
+typedef uint8_t JSQMessagesBinaryArchiveMediaFlags;
+
+enum {
+    JSQMessagesBinaryArchiveMediaFlagsNone = 0,
+    JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing = 1 << 0,
+    JSQMessagesBinaryArchiveMediaFlagsHasContent = 1 << 1,
+    JSQMessagesBinaryArchiveMediaFlagsReadyToPlay = 1 << 2
+};
+
+/**
+ *  The fields of one message record. When a record is read, its byte ranges point into the archive.
+ *
+ *  Text records use `string`. Photo records use `string` for the image URL and `payload` for the image data,
+ *  location records use `latitudeBits` and `longitudeBits`, and video records use `string` for the file URL.
+ */
+typedef struct JSQMessagesBinaryRecord {
+    uint64_t senderIndex;
+    uint64_t encodedDateDelta;
+    JSQMessagesBinaryArchiveType type;
+    JSQMessagesBinaryArchiveMediaFlags mediaFlags;
+    const uint8_t *string;
+    size_t stringLength;
+    const uint8_t *payload;
+    size_t payloadLength;
+    uint64_t latitudeBits;
+    uint64_t longitudeBits;
+} JSQMessagesBinaryRecord;
+
+/**
+ *  A growing buffer that archive bytes are appended to.
+ *
+ *  @discussion Once an allocation failed, `failed` is set and nothing more is appended.
+ *  The owner of the writer frees `bytes`, or takes them over, when it is done with the writer.
+ */
+typedef struct JSQMessagesBinaryWriter {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} JSQMessagesBinaryWriter;
+
+/**
+ *  A bounds-checked cursor over the bytes of an archive. Byte ranges returned by the read functions
+ *  point into the archive, nothing is copied.
+ */
+typedef struct JSQMessagesBinaryReader {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+} JSQMessagesBinaryReader;
+
+
+//  MARK: - Values
+
+/**
+ *  @return The IEEE 754 bit pattern of value.
+ */
+uint64_t JSQMessagesBinaryBitsOfDouble(double value);
+
+/**
+ *  @return The double whose IEEE 754 bit pattern is bits.
+ */
+double JSQMessagesBinaryDoubleWithBits(uint64_t bits);
+
+/**
+ *  @return The zigzag encoding of value, which maps small negative and positive values to small unsigned values.
+ */
+uint64_t JSQMessagesBinaryZigzagEncode(int64_t value);
+
+/**
+ *  @return The value whose zigzag encoding is value.
+ */
+int64_t JSQMessagesBinaryZigzagDecode(uint64_t value);
+
+
+//  MARK: - Writing
+
+/**
+ *  Initializes a writer with an empty buffer of the given capacity.
+ */
+void JSQMessagesBinaryWriterInit(JSQMessagesBinaryWriter *writer, size_t capacity);
+
+/**
+ *  Appends length bytes to the writer, left for the caller to fill.
+ *
+ *  @return A pointer to the appended bytes, or `NULL` if the buffer could not grow.
+ *  The pointer is only valid until the next append.
+ */
+uint8_t *JSQMessagesBinaryWriterReserve(JSQMessagesBinaryWriter *writer, size_t length);
+
+/**
+ *  Appends the bytes as is.
+ */
+void JSQMessagesBinaryWriteRaw(JSQMessagesBinaryWriter *writer, const void *bytes, size_t length);
+
+/**
+ *  Appends a single byte.
+ */
+void JSQMessagesBinaryWriteByte(JSQMessagesBinaryWriter *writer, uint8_t value);
+
+/**
+ *  Appends value as a little-endian base 128 varint, 1 to 10 bytes.
+ */
+void JSQMessagesBinaryWriteVarint(JSQMessagesBinaryWriter *writer, uint64_t value);
+
+/**
+ *  Appends value as 8 little-endian bytes.
+ */
+void JSQMessagesBinaryWriteFixed64(JSQMessagesBinaryWriter *writer, uint64_t value);
+
+/**
+ *  Appends a varint byte length followed by the bytes.
+ */
+void JSQMessagesBinaryWriteBytes(JSQMessagesBinaryWriter *writer, const void *bytes, size_t length);
+
+/**
+ *  Appends the magic number of archives followed by the version byte.
+ */
+void JSQMessagesBinaryWriteHeader(JSQMessagesBinaryWriter *writer, uint8_t version);
+
+/**
+ *  Appends a message record: the sender index and date delta as varints, the type, and the fields of the type.
+ */
+void JSQMessagesBinaryWriteRecord(JSQMessagesBinaryWriter *writer, const JSQMessagesBinaryRecord *record);
+
+
+//  MARK: - Reading
+
+/**
+ *  Reads a single byte. Fails at the end of the archive.
+ */
+bool JSQMessagesBinaryReadByte(JSQMessagesBinaryReader *reader, uint8_t *value);
+
+/**
+ *  Reads a varint. Fails on a truncated varint or on one longer than 10 bytes.
+ */
+bool JSQMessagesBinaryReadVarint(JSQMessagesBinaryReader *reader, uint64_t *value);
+
+/**
+ *  Reads 8 little-endian bytes. Fails if fewer bytes are left.
+ */
+bool JSQMessagesBinaryReadFixed64(JSQMessagesBinaryReader *reader, uint64_t *value);
+
+/**
+ *  Reads a varint byte length and returns the range of the bytes that follow. Fails if they overrun the archive.
+ */
+bool JSQMessagesBinaryReadBytes(JSQMessagesBinaryReader *reader, const uint8_t **bytes, size_t *length);
+
+/**
+ *  Reads the magic number and the version byte. Fails if the bytes are not an archive or if the version differs.
+ */
+bool JSQMessagesBinaryReadHeader(JSQMessagesBinaryReader *reader, uint8_t version);
+
+/**
+ *  Reads a message record. Fails on truncated input and on unknown record types,
+ *  in which case the contents of record and the offset of reader are undefined.
+ */
+bool JSQMessagesBinaryReadRecord(JSQMessagesBinaryReader *reader, JSQMessagesBinaryRecord *record);
+
+/**
+ *  Returns whether the given bytes are well-formed UTF-8: no overlong encodings, surrogates,
+ *  code points above U+10FFFF or truncated sequences.
+ */
+bool JSQMessagesBinaryIsValidUTF8(const uint8_t *bytes, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
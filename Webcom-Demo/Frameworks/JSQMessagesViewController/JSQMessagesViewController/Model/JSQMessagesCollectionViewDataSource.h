@@ -152,4 +152,44 @@
  */
 - (NSAttributedString *)collectionView:(JSQMessagesCollectionView *)collectionView attributedTextForCellBottomLabelAtIndexPath:(NSIndexPath *)indexPath;
 
+/**
+ *  Asks the data source for the text to display in the day header of the specified section in the collectionView.
+ *
+ *  @param collectionView The collection view requesting this information.
+ *  @param section        The index of the section.
+ *
+ *  @return A configured attributed string or `nil` if you do not want a header displayed for the section.
+ *
+ *  @see JSQMessagesDaySections.
+ *  @see JSQMessagesDayHeaderView.
+ */
+- (NSAttributedString *)collectionView:(JSQMessagesCollectionView *)collectionView attributedTextForDayHeaderInSection:(NSInteger)section;
+
+/**
+ *  Asks the data source for the message data used to size and lay out the item at indexPath in the collectionView.
+ *
+ *  @param collectionView The collection view requesting this information.
+ *  @param indexPath      The index path that specifies the location of the item.
+ *
+ *  @return An object that conforms to the `JSQMessageData` protocol. You must not return `nil` from this method.
+ *
+ *  @discussion The layout sizes every item, not only the visible ones. Implement this method when creating the object
+ *  returned by `collectionView:messageDataForItemAtIndexPath:` is expensive, and return a lightweight object instead.
+ *  It should implement `messageFingerprint`, so that cached sizes are found without reading the text.
+ *  The object is only used for the duration of the layout call. If this method is not implemented,
+ *  `collectionView:messageDataForItemAtIndexPath:` is used.
+ *
+ *  @see `JSQMessagesColumnStore layoutMessageDataAtIndex:`.
+ */
+- (id<JSQMessageData>)collectionView:(JSQMessagesCollectionView *)collectionView layoutMessageDataForItemAtIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  Asks the data source for the ordinal of the current sender's identifier in the shared `JSQMessagesSenderTable`.
+ *
+ *  @return The ordinal of `senderId`, or `JSQMessagesSenderOrdinalNone` if it is not known yet.
+ *
+ *  @see `JSQMessageData senderOrdinal`.
+ */
+- (NSUInteger)senderOrdinal;
+
 @end
@@ -0,0 +1,231 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+#import "JSQMessageData.h"
+
+/**
+ *  A `JSQMessagesColumnStore` object stores an ordered list of messages in columns instead of one object per message.
+ *
+ *  @discussion Dates, sender ordinals, display names and flags are kept in parallel arrays of scalars, and the text
+ *  of all messages is kept as UTF-8 in a single growing buffer. Sender identifiers and display names are interned
+ *  in the shared `JSQMessagesSenderTable`. Appending a text message does not allocate an object for it.
+ *  Media messages keep their media item, which is stored as is.
+ *
+ *  `messageAtIndex:` creates `JSQMessage` objects on demand and keeps a bounded number of them,
+ *  so only the rows that are displayed have an object. Layout should use `layoutMessageDataAtIndex:`, which reads
+ *  the columns and the stored fingerprint instead. Scans such as grouping by sender or searching text should use
+ *  the column accessors, which do not create any object.
+ *
+ *  This class is not thread-safe, it must be used from a single thread.
+ *
+ *  @see JSQMessagesSenderTable.
+ */
+@interface JSQMessagesColumnStore : NSObject
+
+/**
+ *  The number of messages in the store.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The number of bytes of UTF-8 text held by the store.
+ */
+@property (assign, nonatomic, readonly) NSUInteger textByteCount;
+
+/**
+ *  The maximum number of message objects created by `messageAtIndex:` that the store keeps.
+ *  The default value is `256`.
+ */
+@property (assign, nonatomic) NSUInteger messageCacheCountLimit;
+
+/**
+ *  Appends a text message after the last one.
+ *
+ *  @param senderId          The unique identifier for the user who sent the message. This value must not be `nil`.
+ *  @param senderDisplayName The display name for the user who sent the message. This value must not be `nil`.
+ *  @param date              The date that the message was sent. This value must not be `nil`.
+ *  @param text              The body text of the message. This value must not be `nil`.
+ *
+ *  @return The index of the appended message.
+ */
+- (NSUInteger)appendMessageWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+                                   date:(NSDate *)date
+                                   text:(NSString *)text;
+
+/**
+ *  Appends a text message whose text is already encoded as UTF-8, without creating a string or a date.
+ *
+ *  @param senderId          The unique identifier for the user who sent the message. This value must not be `nil`.
+ *  @param senderDisplayName The display name for the user who sent the message. This value must not be `nil`.
+ *  @param timeInterval      The date that the message was sent, as a time interval since the reference date.
+ *  @param bytes             The UTF-8 bytes of the body text of the message. They are copied into the store.
+ *  @param length            The number of bytes.
+ *
+ *  @return The index of the appended message.
+ *
+ *  @see JSQMessagesBinaryArchive.
+ */
+- (NSUInteger)appendMessageWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+         timeIntervalSinceReferenceDate:(NSTimeInterval)timeInterval
+                              UTF8Bytes:(const void *)bytes
+                                 length:(NSUInteger)length;
+
+/**
+ *  Appends a message after the last one. The text of a text message is copied into the store,
+ *  a media message is kept as is.
+ *
+ *  @param message The message to append. This value must not be `nil`.
+ *
+ *  @return The index of the appended message.
+ */
+- (NSUInteger)appendMessage:(id<JSQMessageData>)message;
+
+/**
+ *  Removes all messages and releases the storage of the columns.
+ */
+- (void)removeAllMessages;
+
+/**
+ *  Returns a message object for the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return A `JSQMessage` for a text message, or the appended object for a media message.
+ */
+- (id<JSQMessageData>)messageAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns a lightweight message data object for the message at the given index, to size and lay out its cell.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return An object that reads the columns of the store for a text message, or the appended object for a media message.
+ *
+ *  @discussion Unlike `messageAtIndex:`, this method neither creates a `JSQMessage` nor evicts one from the store.
+ *  The returned object only copies the text out of the store when `text` is called, which the bubble size calculator
+ *  only does when the size of the message is not cached yet. It is meant to be returned from
+ *  `collectionView:layoutMessageDataForItemAtIndexPath:` and should not be kept.
+ *
+ *  @see JSQMessagesCollectionViewDataSource.
+ */
+- (id<JSQMessageData>)layoutMessageDataAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the fingerprint of the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return The `messageFingerprint` of the object returned by `messageAtIndex:`.
+ *
+ *  @discussion The fingerprint of a text message is computed the first time it is requested,
+ *  then kept in a column of the store.
+ */
+- (uint64_t)messageFingerprintAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the date of the message at the given index, as a time interval since the reference date.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return The date of the message.
+ */
+- (NSTimeInterval)timeIntervalSinceReferenceDateAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the ordinal of the sender of the message at the given index in the shared `JSQMessagesSenderTable`.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return The sender ordinal of the message.
+ */
+- (NSUInteger)senderOrdinalAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the sender identifier of the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return The interned sender identifier of the message.
+ */
+- (NSString *)senderIdAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the sender display name of the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return The interned sender display name of the message.
+ */
+- (NSString *)senderDisplayNameAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns whether the message at the given index is a media message.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return `YES` if the message is a media message, `NO` if it is a text message.
+ */
+- (BOOL)isMediaMessageAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the text of the message at the given index.
+ *
+ *  @param index The index of the message. This value must be less than `count`.
+ *
+ *  @return A new string with the text of the message, or `nil` if it is a media message.
+ */
+- (NSString *)textAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the UTF-8 bytes of the text of the message at the given index, without creating a string.
+ *
+ *  @param index  The index of the message. This value must be less than `count`.
+ *  @param length On return, the number of bytes. This value must not be `NULL`.
+ *
+ *  @return A pointer to the bytes, or `NULL` if it is a media message. The pointer is only valid
+ *  until the next message is appended or all messages are removed.
+ */
+- (const void *)UTF8BytesAtIndex:(NSUInteger)index length:(NSUInteger *)length;
+
+/**
+ *  Returns the indexes of the messages sent by the sender with the given ordinal.
+ *
+ *  @param senderOrdinal A sender ordinal of the shared `JSQMessagesSenderTable`.
+ *
+ *  @return The indexes of the matching messages.
+ */
+- (NSIndexSet *)indexesOfMessagesFromSenderWithOrdinal:(NSUInteger)senderOrdinal;
+
+/**
+ *  Returns the indexes of the text messages that contain the given text.
+ *
+ *  @param text The text to search for. This value must not be `nil`.
+ *
+ *  @return The indexes of the matching messages.
+ *
+ *  @discussion The search compares UTF-8 bytes, so it is case and diacritic sensitive
+ *  and it does not create a string for each message.
+ */
+- (NSIndexSet *)indexesOfMessagesContainingText:(NSString *)text;
+
+@end
@@ -0,0 +1,527 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesColumnStore.h"
+
+#import <string.h>
+
+#import "JSQMessage.h"
+#import "JSQMessagesSenderTable.h"
+
+
+typedef NS_OPTIONS(uint8_t, JSQMessagesColumnStoreFlags) {
+    JSQMessagesColumnStoreFlagsNone = 0,
+    JSQMessagesColumnStoreFlagsMedia = 1 << 0
+};
+
+
+@interface JSQMessagesColumnStoreRow : NSObject <JSQMessageData>
+
+@property (strong, nonatomic, readonly) JSQMessagesColumnStore *store;
+
+@property (assign, nonatomic, readonly) NSUInteger index;
+
+- (instancetype)initWithStore:(JSQMessagesColumnStore *)store index:(NSUInteger)index;
+
+@end
+
+
+
+@interface JSQMessagesColumnStore ()
+
+@property (assign, nonatomic, readwrite) NSUInteger count;
+
+@property (strong, nonatomic, readonly) NSMutableData *timeIntervals;
+
+@property (strong, nonatomic, readonly) NSMutableData *senderOrdinals;
+
+@property (strong, nonatomic, readonly) NSMutableData *displayNameIndexes;
+
+@property (strong, nonatomic, readonly) NSMutableData *flags;
+
+@property (strong, nonatomic, readonly) NSMutableData *textOffsets;
+
+@property (strong, nonatomic, readonly) NSMutableData *textLengths;
+
+@property (strong, nonatomic, readonly) NSMutableData *fingerprints;
+
+@property (strong, nonatomic, readonly) NSMutableData *textArena;
+
+@property (strong, nonatomic, readonly) NSMutableArray *displayNames;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *displayNameIndexesForNames;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *mediaMessages;
+
+@property (strong, nonatomic, readonly) NSCache *messageCache;
+
+- (NSUInteger)jsq_appendSenderId:(NSString *)senderId
+               senderDisplayName:(NSString *)senderDisplayName
+                    timeInterval:(NSTimeInterval)timeInterval
+                           flags:(JSQMessagesColumnStoreFlags)flags
+                      textOffset:(uint64_t)textOffset;
+
+- (uint32_t)jsq_displayNameIndexForName:(NSString *)displayName;
+
+@end
+
+
+
+@implementation JSQMessagesColumnStore
+
+#pragma mark - Initialization
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _timeIntervals = [NSMutableData new];
+        _senderOrdinals = [NSMutableData new];
+        _displayNameIndexes = [NSMutableData new];
+        _flags = [NSMutableData new];
+        _textOffsets = [NSMutableData new];
+        _textLengths = [NSMutableData new];
+        _fingerprints = [NSMutableData new];
+        _textArena = [NSMutableData new];
+
+        _displayNames = [NSMutableArray new];
+        _displayNameIndexesForNames = [NSMutableDictionary new];
+        _mediaMessages = [NSMutableDictionary new];
+
+        _messageCache = [NSCache new];
+        _messageCache.name = @"JSQMessagesColumnStore.messageCache";
+        _messageCache.countLimit = 256;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _timeIntervals = nil;
+    _senderOrdinals = nil;
+    _displayNameIndexes = nil;
+    _flags = nil;
+    _textOffsets = nil;
+    _textLengths = nil;
+    _fingerprints = nil;
+    _textArena = nil;
+    _displayNames = nil;
+    _displayNameIndexesForNames = nil;
+    _mediaMessages = nil;
+    _messageCache = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setMessageCacheCountLimit:(NSUInteger)messageCacheCountLimit
+{
+    self.messageCache.countLimit = messageCacheCountLimit;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)messageCacheCountLimit
+{
+    return self.messageCache.countLimit;
+}
+
+- (NSUInteger)textByteCount
+{
+    return self.textArena.length;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: count=%@, textByteCount=%@, displayNames=%@, mediaMessages=%@>",
+            [self class], @(self.count), @(self.textByteCount), @(self.displayNames.count), @(self.mediaMessages.count)];
+}
+
+#pragma mark - Appending messages
+
+- (NSUInteger)appendMessageWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+                                   date:(NSDate *)date
+                                   text:(NSString *)text
+{
+    NSParameterAssert(date != nil);
+    NSParameterAssert(text != nil);
+
+    uint64_t textOffset = self.textArena.length;
+    NSUInteger maximumLength = [text lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+
+    //  encode directly into the arena
+    self.textArena.length = textOffset + maximumLength;
+
+    NSUInteger usedLength = 0;
+    [text getBytes:(uint8_t *)self.textArena.mutableBytes + textOffset
+         maxLength:maximumLength
+        usedLength:&usedLength
+          encoding:NSUTF8StringEncoding
+           options:0
+             range:NSMakeRange(0, text.length)
+    remainingRange:NULL];
+
+    self.textArena.length = textOffset + usedLength;
+
+    return [self jsq_appendSenderId:senderId
+                  senderDisplayName:senderDisplayName
+                       timeInterval:[date timeIntervalSinceReferenceDate]
+                              flags:JSQMessagesColumnStoreFlagsNone
+                         textOffset:textOffset];
+}
+
+- (NSUInteger)appendMessageWithSenderId:(NSString *)senderId
+                      senderDisplayName:(NSString *)senderDisplayName
+         timeIntervalSinceReferenceDate:(NSTimeInterval)timeInterval
+                              UTF8Bytes:(const void *)bytes
+                                 length:(NSUInteger)length
+{
+    NSParameterAssert(bytes != NULL || length == 0);
+
+    uint64_t textOffset = self.textArena.length;
+    [self.textArena appendBytes:bytes length:length];
+
+    return [self jsq_appendSenderId:senderId
+                  senderDisplayName:senderDisplayName
+                       timeInterval:timeInterval
+                              flags:JSQMessagesColumnStoreFlagsNone
+                         textOffset:textOffset];
+}
+
+- (NSUInteger)appendMessage:(id<JSQMessageData>)message
+{
+    NSParameterAssert(message != nil);
+
+    if (![message isMediaMessage]) {
+        return [self appendMessageWithSenderId:[message senderId]
+                             senderDisplayName:[message senderDisplayName]
+                                          date:[message date]
+                                          text:[message text]];
+    }
+
+    NSParameterAssert([message date] != nil);
+
+    NSUInteger index = [self jsq_appendSenderId:[message senderId]
+                              senderDisplayName:[message senderDisplayName]
+                                   timeInterval:[[message date] timeIntervalSinceReferenceDate]
+                                          flags:JSQMessagesColumnStoreFlagsMedia
+                                     textOffset:self.textArena.length];
+
+    [self.mediaMessages setObject:message forKey:@(index)];
+    return index;
+}
+
+- (NSUInteger)jsq_appendSenderId:(NSString *)senderId
+               senderDisplayName:(NSString *)senderDisplayName
+                    timeInterval:(NSTimeInterval)timeInterval
+                           flags:(JSQMessagesColumnStoreFlags)flags
+                      textOffset:(uint64_t)textOffset
+{
+    NSParameterAssert(senderId != nil);
+    NSParameterAssert(senderDisplayName != nil);
+
+    NSUInteger senderOrdinal = [[JSQMessagesSenderTable sharedTable] ordinalForSenderId:senderId];
+    NSAssert(senderOrdinal <= UINT32_MAX, @"Sender ordinal %@ does not fit the sender ordinal column", @(senderOrdinal));
+
+    //  the caller appended the text to the arena, starting at textOffset
+    uint64_t length = self.textArena.length - textOffset;
+    NSAssert(length <= UINT32_MAX, @"Text of %@ bytes does not fit the text length column", @(length));
+
+    uint32_t senderOrdinalValue = (uint32_t)senderOrdinal;
+    uint32_t displayNameIndex = [self jsq_displayNameIndexForName:senderDisplayName];
+    uint32_t textLength = (uint32_t)length;
+    uint64_t fingerprint = 0;
+
+    [self.timeIntervals appendBytes:&timeInterval length:sizeof(timeInterval)];
+    [self.senderOrdinals appendBytes:&senderOrdinalValue length:sizeof(senderOrdinalValue)];
+    [self.displayNameIndexes appendBytes:&displayNameIndex length:sizeof(displayNameIndex)];
+    [self.flags appendBytes:&flags length:sizeof(flags)];
+    [self.textOffsets appendBytes:&textOffset length:sizeof(textOffset)];
+    [self.textLengths appendBytes:&textLength length:sizeof(textLength)];
+    [self.fingerprints appendBytes:&fingerprint length:sizeof(fingerprint)];
+
+    return self.count++;
+}
+
+- (uint32_t)jsq_displayNameIndexForName:(NSString *)displayName
+{
+    NSNumber *index = [self.displayNameIndexesForNames objectForKey:displayName];
+    if (index != nil) {
+        return (uint32_t)index.unsignedIntValue;
+    }
+
+    NSString *internedName = [[JSQMessagesSenderTable sharedTable] internedString:displayName];
+    uint32_t newIndex = (uint32_t)self.displayNames.count;
+
+    [self.displayNames addObject:internedName];
+    [self.displayNameIndexesForNames setObject:@(newIndex) forKey:internedName];
+
+    return newIndex;
+}
+
+- (void)removeAllMessages
+{
+    self.count = 0;
+
+    //  replace the buffers instead of truncating them, so their memory is released
+    _timeIntervals = [NSMutableData new];
+    _senderOrdinals = [NSMutableData new];
+    _displayNameIndexes = [NSMutableData new];
+    _flags = [NSMutableData new];
+    _textOffsets = [NSMutableData new];
+    _textLengths = [NSMutableData new];
+    _fingerprints = [NSMutableData new];
+    _textArena = [NSMutableData new];
+
+    [self.displayNames removeAllObjects];
+    [self.displayNameIndexesForNames removeAllObjects];
+    [self.mediaMessages removeAllObjects];
+    [self.messageCache removeAllObjects];
+}
+
+#pragma mark - Messages
+
+- (id<JSQMessageData>)messageAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+
+    if ([self isMediaMessageAtIndex:index]) {
+        return [self.mediaMessages objectForKey:@(index)];
+    }
+
+    NSNumber *key = @(index);
+    JSQMessage *message = [self.messageCache objectForKey:key];
+
+    if (message == nil) {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:[self timeIntervalSinceReferenceDateAtIndex:index]];
+
+        message = [[JSQMessage alloc] initWithSenderId:[self senderIdAtIndex:index]
+                                     senderDisplayName:[self senderDisplayNameAtIndex:index]
+                                                  date:date
+                                                  text:[self textAtIndex:index]];
+
+        ((uint64_t *)self.fingerprints.mutableBytes)[index] = message.messageFingerprint;
+        [self.messageCache setObject:message forKey:key];
+    }
+
+    return message;
+}
+
+- (id<JSQMessageData>)layoutMessageDataAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+
+    if ([self isMediaMessageAtIndex:index]) {
+        return [self.mediaMessages objectForKey:@(index)];
+    }
+
+    return [[JSQMessagesColumnStoreRow alloc] initWithStore:self index:index];
+}
+
+- (uint64_t)messageFingerprintAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+
+    if ([self isMediaMessageAtIndex:index]) {
+        return JSQMessageDataFingerprint([self.mediaMessages objectForKey:@(index)]);
+    }
+
+    //  zero marks a fingerprint that is not computed yet, a genuine zero is just computed again
+    uint64_t *fingerprints = self.fingerprints.mutableBytes;
+    if (fingerprints[index] == 0) {
+        fingerprints[index] = [JSQMessage fingerprintForTextMessageWithSenderId:[self senderIdAtIndex:index]
+                                                              senderDisplayName:[self senderDisplayNameAtIndex:index]
+                                                 timeIntervalSinceReferenceDate:[self timeIntervalSinceReferenceDateAtIndex:index]
+                                                                           text:[self textAtIndex:index]];
+    }
+
+    return fingerprints[index];
+}
+
+#pragma mark - Columns
+
+- (NSTimeInterval)timeIntervalSinceReferenceDateAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+    return ((const NSTimeInterval *)self.timeIntervals.bytes)[index];
+}
+
+- (NSUInteger)senderOrdinalAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+    return ((const uint32_t *)self.senderOrdinals.bytes)[index];
+}
+
+- (NSString *)senderIdAtIndex:(NSUInteger)index
+{
+    return [[JSQMessagesSenderTable sharedTable] senderIdForOrdinal:[self senderOrdinalAtIndex:index]];
+}
+
+- (NSString *)senderDisplayNameAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+    uint32_t displayNameIndex = ((const uint32_t *)self.displayNameIndexes.bytes)[index];
+    return [self.displayNames objectAtIndex:displayNameIndex];
+}
+
+- (BOOL)isMediaMessageAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < self.count);
+    JSQMessagesColumnStoreFlags flags = ((const uint8_t *)self.flags.bytes)[index];
+    return (flags & JSQMessagesColumnStoreFlagsMedia) != 0;
+}
+
+- (NSString *)textAtIndex:(NSUInteger)index
+{
+    if ([self isMediaMessageAtIndex:index]) {
+        return nil;
+    }
+
+    uint64_t textOffset = ((const uint64_t *)self.textOffsets.bytes)[index];
+    uint32_t textLength = ((const uint32_t *)self.textLengths.bytes)[index];
+
+    return [[NSString alloc] initWithBytes:(const uint8_t *)self.textArena.bytes + textOffset
+                                    length:textLength
+                                  encoding:NSUTF8StringEncoding];
+}
+
+- (const void *)UTF8BytesAtIndex:(NSUInteger)index length:(NSUInteger *)length
+{
+    NSParameterAssert(length != NULL);
+
+    if ([self isMediaMessageAtIndex:index]) {
+        *length = 0;
+        return NULL;
+    }
+
+    uint64_t textOffset = ((const uint64_t *)self.textOffsets.bytes)[index];
+    *length = ((const uint32_t *)self.textLengths.bytes)[index];
+
+    return (const uint8_t *)self.textArena.bytes + textOffset;
+}
+
+#pragma mark - Scanning
+
+- (NSIndexSet *)indexesOfMessagesFromSenderWithOrdinal:(NSUInteger)senderOrdinal
+{
+    NSMutableIndexSet *indexes = [NSMutableIndexSet new];
+    const uint32_t *senderOrdinals = self.senderOrdinals.bytes;
+
+    for (NSUInteger i = 0; i < self.count; i++) {
+        if (senderOrdinals[i] == senderOrdinal) {
+            [indexes addIndex:i];
+        }
+    }
+
+    return indexes;
+}
+
+- (NSIndexSet *)indexesOfMessagesContainingText:(NSString *)text
+{
+    NSParameterAssert(text != nil);
+
+    NSMutableIndexSet *indexes = [NSMutableIndexSet new];
+
+    const char *needle = [text UTF8String];
+    size_t needleLength = strlen(needle);
+
+    const uint8_t *arena = self.textArena.bytes;
+    const uint64_t *textOffsets = self.textOffsets.bytes;
+    const uint32_t *textLengths = self.textLengths.bytes;
+    const uint8_t *flags = self.flags.bytes;
+
+    for (NSUInteger i = 0; i < self.count; i++) {
+        if ((flags[i] & JSQMessagesColumnStoreFlagsMedia) != 0) {
+            continue;
+        }
+
+        if (needleLength == 0 || memmem(arena + textOffsets[i], textLengths[i], needle, needleLength) != NULL) {
+            [indexes addIndex:i];
+        }
+    }
+
+    return indexes;
+}
+
+@end
+
+
+
+@implementation JSQMessagesColumnStoreRow
+
+- (instancetype)initWithStore:(JSQMessagesColumnStore *)store index:(NSUInteger)index
+{
+    self = [super init];
+    if (self) {
+        _store = store;
+        _index = index;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _store = nil;
+}
+
+#pragma mark - JSQMessageData protocol
+
+- (NSString *)senderId
+{
+    return [self.store senderIdAtIndex:self.index];
+}
+
+- (NSString *)senderDisplayName
+{
+    return [self.store senderDisplayNameAtIndex:self.index];
+}
+
+- (NSDate *)date
+{
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:[self.store timeIntervalSinceReferenceDateAtIndex:self.index]];
+}
+
+- (BOOL)isMediaMessage
+{
+    return NO;
+}
+
+- (NSUInteger)messageHash
+{
+    return (NSUInteger)[self messageFingerprint];
+}
+
+- (NSString *)text
+{
+    return [self.store textAtIndex:self.index];
+}
+
+- (NSUInteger)senderOrdinal
+{
+    return [self.store senderOrdinalAtIndex:self.index];
+}
+
+- (uint64_t)messageFingerprint
+{
+    return [self.store messageFingerprintAtIndex:self.index];
+}
+
+@end
@@ -0,0 +1,136 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+#import "JSQMessageData.h"
+
+@class JSQMessagesTimestampFormatter;
+
+/**
+ *  A `JSQMessagesDaySections` object groups an ordered list of messages into one section per calendar day,
+ *  and maps between message indexes and index paths of a `JSQMessagesCollectionView`.
+ *
+ *  @discussion It only stores the section boundaries, not the messages themselves. Messages must be given
+ *  in chronological order. Index path lookups and `sectionForDate:` are binary searches over the sections,
+ *  and the header text of each section is formatted once.
+ *
+ *  The flow layout needs no section lookups of its own: `UICollectionViewFlowLayout` already lays out and queries
+ *  its items section by section, and the bubble size path only maps an index path to a message, which
+ *  `messageIndexForIndexPath:` does in constant time from the start index of the section.
+ *
+ *  @see `JSQMessagesViewController daySections`.
+ */
+@interface JSQMessagesDaySections : NSObject
+
+/**
+ *  The timestamp formatter used for the section headers. The default value is the shared timestamp formatter.
+ */
+@property (strong, nonatomic) JSQMessagesTimestampFormatter *timestampFormatter;
+
+/**
+ *  The total number of messages in all sections.
+ */
+@property (assign, nonatomic, readonly) NSUInteger numberOfMessages;
+
+/**
+ *  The number of sections, one per calendar day.
+ */
+@property (assign, nonatomic, readonly) NSInteger numberOfSections;
+
+/**
+ *  Initializes and returns day sections for the given messages.
+ *
+ *  @param messages An array of objects conforming to the `JSQMessageData` protocol, in chronological order.
+ *  This value must not be `nil`.
+ *
+ *  @return An initialized `JSQMessagesDaySections` object.
+ */
+- (instancetype)initWithMessages:(NSArray *)messages NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Appends a message after the last one, starting a new section if it was sent on another day.
+ *
+ *  @param message The message to append. This value must not be `nil`.
+ *
+ *  @return The index path of the appended message.
+ */
+- (NSIndexPath *)appendMessage:(id<JSQMessageData>)message;
+
+/**
+ *  Removes all sections.
+ */
+- (void)removeAllMessages;
+
+/**
+ *  Returns the number of messages in the given section.
+ *
+ *  @param section A section index.
+ *
+ *  @return The number of messages in section, or `0` if there is no such section.
+ */
+- (NSInteger)numberOfItemsInSection:(NSInteger)section;
+
+/**
+ *  Returns the index of the message at the given index path in the list of all messages.
+ *
+ *  @param indexPath An index path. This value must not be `nil`.
+ *
+ *  @return The index of the message.
+ */
+- (NSUInteger)messageIndexForIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  Returns the index path of the message at the given index in the list of all messages.
+ *
+ *  @param messageIndex The index of the message. This value must be less than `numberOfMessages`.
+ *
+ *  @return The index path of the message.
+ */
+- (NSIndexPath *)indexPathForMessageAtIndex:(NSUInteger)messageIndex;
+
+/**
+ *  Returns the date of the first message in the given section.
+ *
+ *  @param section A section index.
+ *
+ *  @return The date of the first message of the section, or `nil` if there is no such section.
+ */
+- (NSDate *)dateForSection:(NSInteger)section;
+
+/**
+ *  Returns the section of the calendar day of the given date or, if there is no message that day, the first section after it.
+ *
+ *  @param date A date. This value must not be `nil`.
+ *
+ *  @return A section index, or `NSNotFound` if all the messages are older than date.
+ */
+- (NSInteger)sectionForDate:(NSDate *)date;
+
+/**
+ *  Returns the header text of the given section, the relative date of its first message formatted by `timestampFormatter`
+ *  with its `dateTextAttributes`.
+ *
+ *  @param section A section index.
+ *
+ *  @return The header text, or `nil` if there is no such section.
+ */
+- (NSAttributedString *)attributedHeaderTextForSection:(NSInteger)section;
+
+@end
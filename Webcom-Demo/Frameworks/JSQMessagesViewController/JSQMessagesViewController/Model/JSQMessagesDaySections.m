@@ -0,0 +1,233 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesDaySections.h"
+
+#import "JSQMessagesTimestampFormatter.h"
+
+
+@interface JSQMessagesDaySections ()
+
+@property (assign, nonatomic, readwrite) NSUInteger numberOfMessages;
+
+@property (strong, nonatomic, readonly) NSMutableArray *sectionStartIndexes;
+
+@property (strong, nonatomic, readonly) NSMutableArray *sectionDays;
+
+@property (strong, nonatomic, readonly) NSMutableArray *sectionDates;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *headerTexts;
+
+@property (assign, nonatomic) long headerTextsDay;
+
++ (long)jsq_localDayForDate:(NSDate *)date;
+
+@end
+
+
+
+@implementation JSQMessagesDaySections
+
+#pragma mark - Initialization
+
+- (instancetype)initWithMessages:(NSArray *)messages
+{
+    NSParameterAssert(messages != nil);
+    
+    self = [super init];
+    if (self) {
+        _timestampFormatter = [JSQMessagesTimestampFormatter sharedFormatter];
+        _sectionStartIndexes = [NSMutableArray new];
+        _sectionDays = [NSMutableArray new];
+        _sectionDates = [NSMutableArray new];
+        _headerTexts = [NSMutableDictionary new];
+        
+        for (id<JSQMessageData> eachMessage in messages) {
+            [self appendMessage:eachMessage];
+        }
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithMessages:@[]];
+}
+
+- (void)dealloc
+{
+    _timestampFormatter = nil;
+    _sectionStartIndexes = nil;
+    _sectionDays = nil;
+    _sectionDates = nil;
+    _headerTexts = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setTimestampFormatter:(JSQMessagesTimestampFormatter *)timestampFormatter
+{
+    NSParameterAssert(timestampFormatter != nil);
+    _timestampFormatter = timestampFormatter;
+    [self.headerTexts removeAllObjects];
+}
+
+#pragma mark - Getters
+
+- (NSInteger)numberOfSections
+{
+    return self.sectionStartIndexes.count;
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: numberOfMessages=%@, numberOfSections=%@>",
+            [self class], @(self.numberOfMessages), @(self.numberOfSections)];
+}
+
+#pragma mark - Sections
+
+- (NSIndexPath *)appendMessage:(id<JSQMessageData>)message
+{
+    NSParameterAssert(message != nil);
+    
+    NSDate *date = [message date];
+    NSParameterAssert(date != nil);
+    
+    NSNumber *day = @([JSQMessagesDaySections jsq_localDayForDate:date]);
+    
+    if (![[self.sectionDays lastObject] isEqualToNumber:day]) {
+        [self.sectionStartIndexes addObject:@(self.numberOfMessages)];
+        [self.sectionDays addObject:day];
+        [self.sectionDates addObject:date];
+    }
+    
+    NSInteger section = self.numberOfSections - 1;
+    NSInteger item = self.numberOfMessages - [[self.sectionStartIndexes lastObject] unsignedIntegerValue];
+    
+    self.numberOfMessages++;
+    
+    return [NSIndexPath indexPathForItem:item inSection:section];
+}
+
+- (void)removeAllMessages
+{
+    [self.sectionStartIndexes removeAllObjects];
+    [self.sectionDays removeAllObjects];
+    [self.sectionDates removeAllObjects];
+    [self.headerTexts removeAllObjects];
+    self.numberOfMessages = 0;
+}
+
+- (NSInteger)numberOfItemsInSection:(NSInteger)section
+{
+    if (section < 0 || section >= self.numberOfSections) {
+        return 0;
+    }
+    
+    NSUInteger start = [self.sectionStartIndexes[section] unsignedIntegerValue];
+    NSUInteger end = (section + 1 < self.numberOfSections) ? [self.sectionStartIndexes[section + 1] unsignedIntegerValue] : self.numberOfMessages;
+    return end - start;
+}
+
+- (NSUInteger)messageIndexForIndexPath:(NSIndexPath *)indexPath
+{
+    NSParameterAssert(indexPath != nil);
+    NSParameterAssert(indexPath.section < self.numberOfSections);
+    
+    return [self.sectionStartIndexes[indexPath.section] unsignedIntegerValue] + indexPath.item;
+}
+
+- (NSIndexPath *)indexPathForMessageAtIndex:(NSUInteger)messageIndex
+{
+    NSParameterAssert(messageIndex < self.numberOfMessages);
+    
+    //  the section is the last one starting at or before the message
+    NSUInteger insertionIndex = [self.sectionStartIndexes indexOfObject:@(messageIndex)
+                                                          inSortedRange:NSMakeRange(0, self.sectionStartIndexes.count)
+                                                                options:(NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual)
+                                                        usingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+                                                            return [lhs compare:rhs];
+                                                        }];
+    NSInteger section = insertionIndex - 1;
+    NSInteger item = messageIndex - [self.sectionStartIndexes[section] unsignedIntegerValue];
+    
+    return [NSIndexPath indexPathForItem:item inSection:section];
+}
+
+- (NSDate *)dateForSection:(NSInteger)section
+{
+    if (section < 0 || section >= self.numberOfSections) {
+        return nil;
+    }
+    
+    return self.sectionDates[section];
+}
+
+- (NSInteger)sectionForDate:(NSDate *)date
+{
+    NSParameterAssert(date != nil);
+    
+    NSNumber *day = @([JSQMessagesDaySections jsq_localDayForDate:date]);
+    
+    NSUInteger section = [self.sectionDays indexOfObject:day
+                                           inSortedRange:NSMakeRange(0, self.sectionDays.count)
+                                                 options:(NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual)
+                                         usingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+                                             return [lhs compare:rhs];
+                                         }];
+    
+    return (section < self.sectionDays.count) ? (NSInteger)section : NSNotFound;
+}
+
+- (NSAttributedString *)attributedHeaderTextForSection:(NSInteger)section
+{
+    NSDate *date = [self dateForSection:section];
+    if (date == nil) {
+        return nil;
+    }
+    
+    //  relative days such as "Today" change at midnight
+    long today = [JSQMessagesDaySections jsq_localDayForDate:[NSDate date]];
+    if (today != self.headerTextsDay) {
+        [self.headerTexts removeAllObjects];
+        self.headerTextsDay = today;
+    }
+    
+    NSAttributedString *headerText = self.headerTexts[@(section)];
+    if (headerText == nil) {
+        headerText = [[NSAttributedString alloc] initWithString:[self.timestampFormatter relativeDateForDate:date]
+                                                     attributes:self.timestampFormatter.dateTextAttributes];
+        self.headerTexts[@(section)] = headerText;
+    }
+    
+    return headerText;
+}
+
+#pragma mark - Utilities
+
++ (long)jsq_localDayForDate:(NSDate *)date
+{
+    NSTimeInterval localTime = [date timeIntervalSinceReferenceDate] + [[NSTimeZone localTimeZone] secondsFromGMTForDate:date];
+    return (long)floor(localTime / (24.0 * 60.0 * 60.0));
+}
+
+@end
@@ -0,0 +1,100 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <Foundation/Foundation.h>
+
+#import "JSQMessageData.h"
+
+@protocol JSQMessagesCollectionViewDataSource;
+
+/**
+ *  The sender ordinal that is never assigned to a sender. Its value is `0`.
+ */
+FOUNDATION_EXPORT const NSUInteger JSQMessagesSenderOrdinalNone;
+
+/**
+ *  A `JSQMessagesSenderTable` interns sender identifiers and display names, and assigns each distinct
+ *  sender identifier a small integer ordinal.
+ *
+ *  @discussion A conversation has many messages but few senders. Message records that keep the ordinal
+ *  and the interned strings hold one copy of each string per sender instead of one per message,
+ *  and deciding whether a message is outgoing is an integer comparison instead of a string comparison.
+ *  Ordinals start at `1`, are never reused, and are only valid for the lifetime of the process,
+ *  so they must not be persisted. All methods are thread-safe.
+ *
+ *  @see `JSQMessage senderOrdinal`.
+ */
+@interface JSQMessagesSenderTable : NSObject
+
+/**
+ *  The number of distinct sender identifiers in the table.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  Returns the shared sender table.
+ *
+ *  @return The shared `JSQMessagesSenderTable` object.
+ */
++ (JSQMessagesSenderTable *)sharedTable;
+
+/**
+ *  Returns the ordinal of the given sender identifier, assigning the next ordinal if it was not seen before.
+ *
+ *  @param senderId A sender identifier. This value must not be `nil`.
+ *
+ *  @return The ordinal of senderId, never `JSQMessagesSenderOrdinalNone`.
+ */
+- (NSUInteger)ordinalForSenderId:(NSString *)senderId;
+
+/**
+ *  Returns the interned sender identifier for the given ordinal.
+ *
+ *  @param ordinal A sender ordinal returned by `ordinalForSenderId:`.
+ *
+ *  @return The interned sender identifier, or `nil` if no sender has this ordinal.
+ */
+- (NSString *)senderIdForOrdinal:(NSUInteger)ordinal;
+
+/**
+ *  Returns the canonical instance of a string equal to the given one, adding it to the table if needed.
+ *  Sender identifiers and display names share the same pool, so a display name equal to its
+ *  sender identifier is stored once.
+ *
+ *  @param string A string.
+ *
+ *  @return An immutable string equal to string, or `nil` if string is `nil`.
+ */
+- (NSString *)internedString:(NSString *)string;
+
+/**
+ *  Returns whether the given message was sent by the current sender of the given data source.
+ *
+ *  @param messageData The message data. This value must not be `nil`.
+ *  @param dataSource  The data source of the collection view displaying the message. This value must not be `nil`.
+ *
+ *  @return `YES` if the message is outgoing, `NO` otherwise.
+ *
+ *  @discussion When both the message data and the data source provide a `senderOrdinal`, the ordinals are compared.
+ *  Otherwise this falls back to comparing the sender identifiers.
+ */
++ (BOOL)isOutgoingMessageData:(id<JSQMessageData>)messageData
+                forDataSource:(id<JSQMessagesCollectionViewDataSource>)dataSource;
+
+@end
@@ -0,0 +1,173 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesSenderTable.h"
+
+#import "JSQMessagesCollectionViewDataSource.h"
+
+
+const NSUInteger JSQMessagesSenderOrdinalNone = 0;
+
+
+@interface JSQMessagesSenderTable ()
+
+@property (strong, nonatomic, readonly) NSMutableSet *strings;
+
+@property (strong, nonatomic, readonly) NSMutableDictionary *ordinalsForSenderIds;
+
+@property (strong, nonatomic, readonly) NSMutableArray *senderIds;
+
+- (NSString *)jsq_internedString:(NSString *)string;
+
+@end
+
+
+
+@implementation JSQMessagesSenderTable
+
+#pragma mark - Initialization
+
++ (JSQMessagesSenderTable *)sharedTable
+{
+    static JSQMessagesSenderTable *_sharedTable = nil;
+
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _sharedTable = [[JSQMessagesSenderTable alloc] init];
+    });
+
+    return _sharedTable;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _strings = [NSMutableSet new];
+        _ordinalsForSenderIds = [NSMutableDictionary new];
+
+        //  index 0 is JSQMessagesSenderOrdinalNone
+        _senderIds = [NSMutableArray arrayWithObject:[NSNull null]];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _strings = nil;
+    _ordinalsForSenderIds = nil;
+    _senderIds = nil;
+}
+
+#pragma mark - Getters
+
+- (NSUInteger)count
+{
+    @synchronized (self) {
+        return self.senderIds.count - 1;
+    }
+}
+
+#pragma mark - Interning
+
+- (NSUInteger)ordinalForSenderId:(NSString *)senderId
+{
+    NSParameterAssert(senderId != nil);
+
+    @synchronized (self) {
+        NSNumber *ordinal = [self.ordinalsForSenderIds objectForKey:senderId];
+        if (ordinal != nil) {
+            return ordinal.unsignedIntegerValue;
+        }
+
+        NSString *internedSenderId = [self jsq_internedString:senderId];
+        NSUInteger newOrdinal = self.senderIds.count;
+
+        [self.senderIds addObject:internedSenderId];
+        [self.ordinalsForSenderIds setObject:@(newOrdinal) forKey:internedSenderId];
+
+        return newOrdinal;
+    }
+}
+
+- (NSString *)senderIdForOrdinal:(NSUInteger)ordinal
+{
+    @synchronized (self) {
+        if (ordinal == JSQMessagesSenderOrdinalNone || ordinal >= self.senderIds.count) {
+            return nil;
+        }
+
+        return [self.senderIds objectAtIndex:ordinal];
+    }
+}
+
+- (NSString *)internedString:(NSString *)string
+{
+    if (string == nil) {
+        return nil;
+    }
+
+    @synchronized (self) {
+        return [self jsq_internedString:string];
+    }
+}
+
+- (NSString *)jsq_internedString:(NSString *)string
+{
+    if (string == nil) {
+        return nil;
+    }
+
+    NSString *internedString = [self.strings member:string];
+    if (internedString == nil) {
+        internedString = [string copy];
+        [self.strings addObject:internedString];
+    }
+
+    return internedString;
+}
+
+#pragma mark - Comparing senders
+
++ (BOOL)isOutgoingMessageData:(id<JSQMessageData>)messageData
+                forDataSource:(id<JSQMessagesCollectionViewDataSource>)dataSource
+{
+    NSParameterAssert(messageData != nil);
+    NSParameterAssert(dataSource != nil);
+
+    if ([messageData respondsToSelector:@selector(senderOrdinal)]
+        && [dataSource respondsToSelector:@selector(senderOrdinal)]) {
+        NSUInteger senderOrdinal = [dataSource senderOrdinal];
+
+        if (senderOrdinal != JSQMessagesSenderOrdinalNone) {
+            return [messageData senderOrdinal] == senderOrdinal;
+        }
+    }
+
+    return [[messageData senderId] isEqualToString:[dataSource senderId]];
+}
+
+#pragma mark - NSObject
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: count=%@, strings=%@>", [self class], @(self.count), @(self.strings.count)];
+}
+
+@end
@@ -28,8 +28,20 @@
 
 /**
  *  The image for the photo media item. The default value is `nil`.
+ *
+ *  @discussion The media view never displays this image directly. A thumbnail matching `mediaViewDisplaySize`
+ *  is created on a background queue by the shared `JSQMessagesImageLoader` and displayed once ready.
+ */
+@property (strong, nonatomic) UIImage *image;
+
+/**
+ *  The file URL of the image for the photo media item. The default value is `nil`.
+ *
+ *  @discussion When this value is set, it is used instead of `image`. The thumbnail is then created with ImageIO
+ *  without decoding the full size image, and is also kept in the disk cache of the shared `JSQMessagesImageLoader`.
+ *  Prefer this property for camera photos and other large images.
  */
-@property (copy, nonatomic) UIImage *image;
+@property (copy, nonatomic) NSURL *imageURL;
 
 /**
  *  Initializes and returns a photo media item object having the given image.
@@ -44,4 +56,13 @@
  */
 - (instancetype)initWithImage:(UIImage *)image;
 
+/**
+ *  Initializes and returns a photo media item object having the given image file URL.
+ *
+ *  @param imageURL The file URL of the image for the photo media item. This value may be `nil`.
+ *
+ *  @return An initialized `JSQPhotoMediaItem` if successful, `nil` otherwise.
+ */
+- (instancetype)initWithImageURL:(NSURL *)imageURL;
+
 @end
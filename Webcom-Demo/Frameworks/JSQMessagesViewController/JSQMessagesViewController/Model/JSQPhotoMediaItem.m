@@ -20,11 +20,25 @@
 
 #import "JSQMessagesMediaPlaceholderView.h"
 #import "JSQMessagesMediaViewBubbleImageMasker.h"
+#import "JSQMessagesImageLoader.h"
+#import "JSQMessagesMediaImageView.h"
+
+#import "UIColor+JSQMessages.h"
 
 
 @interface JSQPhotoMediaItem ()
 
-@property (strong, nonatomic) UIImageView *cachedImageView;
+@property (strong, nonatomic) JSQMessagesMediaImageView *cachedImageView;
+
+@property (copy, nonatomic) NSString *imageIdentifier;
+
+@property (strong, nonatomic) JSQMessagesLoadRequest *thumbnailRequest;
+
+- (NSString *)jsq_thumbnailKey;
+
+- (void)jsq_loadThumbnailIntoImageView:(JSQMessagesMediaImageView *)imageView;
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView;
 
 @end
 
@@ -37,21 +51,37 @@
 {
     self = [super init];
     if (self) {
-        _image = [image copy];
+        _image = image;
+        _imageIdentifier = [[NSUUID UUID] UUIDString];
         _cachedImageView = nil;
     }
     return self;
 }
 
+- (instancetype)initWithImageURL:(NSURL *)imageURL
+{
+    self = [self initWithImage:nil];
+    if (self) {
+        _imageURL = [imageURL copy];
+    }
+    return self;
+}
+
 - (void)dealloc
 {
     _image = nil;
+    _imageURL = nil;
+    _imageIdentifier = nil;
+    _cachedImageView.windowHandler = nil;
     _cachedImageView = nil;
 }
 
 - (void)clearCachedMediaViews
 {
     [super clearCachedMediaViews];
+    [[JSQMessagesImageLoader sharedLoader] cancelLoadRequest:_thumbnailRequest];
+    _thumbnailRequest = nil;
+    _cachedImageView.windowHandler = nil;
     _cachedImageView = nil;
 }
 
@@ -59,32 +89,111 @@
 
 - (void)setImage:(UIImage *)image
 {
-    _image = [image copy];
-    _cachedImageView = nil;
+    _image = image;
+    _imageIdentifier = [[NSUUID UUID] UUIDString];
+    [self clearCachedMediaViews];
+}
+
+- (void)setImageURL:(NSURL *)imageURL
+{
+    _imageURL = [imageURL copy];
+    [self clearCachedMediaViews];
 }
 
 - (void)setAppliesMediaViewMaskAsOutgoing:(BOOL)appliesMediaViewMaskAsOutgoing
 {
     [super setAppliesMediaViewMaskAsOutgoing:appliesMediaViewMaskAsOutgoing];
+    _cachedImageView.windowHandler = nil;
     _cachedImageView = nil;
 }
 
+#pragma mark - Thumbnails
+
+- (NSString *)jsq_thumbnailKey
+{
+    CGSize size = [self mediaViewDisplaySize];
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGSize pixelSize = CGSizeMake(size.width * scale, size.height * scale);
+    
+    NSString *source = self.imageURL.absoluteString ?: self.imageIdentifier;
+    return [NSString stringWithFormat:@"%@-%@", source, NSStringFromCGSize(pixelSize)];
+}
+
+- (void)jsq_loadThumbnailIntoImageView:(JSQMessagesMediaImageView *)imageView
+{
+    CGSize size = [self mediaViewDisplaySize];
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGSize pixelSize = CGSizeMake(size.width * scale, size.height * scale);
+    
+    __weak JSQPhotoMediaItem *weakSelf = self;
+    __weak JSQMessagesMediaImageView *weakImageView = imageView;
+    
+    void (^completion)(UIImage *) = ^(UIImage *image) {
+        weakSelf.thumbnailRequest = nil;
+        
+        //  the source may have changed in the meantime, which discards the view
+        if (weakSelf.cachedImageView == weakImageView) {
+            weakImageView.image = image;
+        }
+    };
+    
+    JSQMessagesImageLoader *loader = [JSQMessagesImageLoader sharedLoader];
+    [loader cancelLoadRequest:self.thumbnailRequest];
+    self.thumbnailRequest = nil;
+    
+    if (self.imageURL != nil) {
+        self.thumbnailRequest = [loader loadImageForKey:[self jsq_thumbnailKey] contentsOfURL:self.imageURL pixelSize:pixelSize completion:completion];
+    }
+    else if (self.image != nil) {
+        self.thumbnailRequest = [loader loadImageForKey:[self jsq_thumbnailKey] image:self.image pixelSize:pixelSize completion:completion];
+    }
+}
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView
+{
+    if (imageView != self.cachedImageView) {
+        return;
+    }
+    
+    if (imageView.window != nil) {
+        if (imageView.image == nil) {
+            [self jsq_loadThumbnailIntoImageView:imageView];
+        }
+        return;
+    }
+    
+    //  the cell was reused or went away, the loader keeps the thumbnail within its memory budget
+    //  only this view stops waiting, other items may share the same thumbnail
+    [[JSQMessagesImageLoader sharedLoader] cancelLoadRequest:self.thumbnailRequest];
+    self.thumbnailRequest = nil;
+    imageView.image = nil;
+}
+
 #pragma mark - JSQMessageMediaData protocol
 
 - (UIView *)mediaView
 {
-    if (self.image == nil) {
+    if (self.image == nil && self.imageURL == nil) {
         return nil;
     }
     
     if (self.cachedImageView == nil) {
         CGSize size = [self mediaViewDisplaySize];
-        UIImageView *imageView = [[UIImageView alloc] initWithImage:self.image];
-        imageView.frame = CGRectMake(0.0f, 0.0f, size.width, size.height);
+        JSQMessagesMediaImageView *imageView = [[JSQMessagesMediaImageView alloc] initWithFrame:CGRectMake(0.0f, 0.0f, size.width, size.height)];
+        imageView.backgroundColor = [UIColor jsq_messageBubbleLightGrayColor];
         imageView.contentMode = UIViewContentModeScaleAspectFill;
         imageView.clipsToBounds = YES;
         [JSQMessagesMediaViewBubbleImageMasker applyBubbleImageMaskToMediaView:imageView isOutgoing:self.appliesMediaViewMaskAsOutgoing];
+        
+        __weak JSQPhotoMediaItem *weakSelf = self;
+        imageView.windowHandler = ^(JSQMessagesMediaImageView *view) {
+            [weakSelf jsq_imageViewDidMoveToWindow:view];
+        };
+        
         self.cachedImageView = imageView;
+        
+        //  start loading right away, the view may be requested ahead of display by the prefetcher
+        [self jsq_loadThumbnailIntoImageView:imageView];
     }
     
     return self.cachedImageView;
@@ -99,13 +208,13 @@
 
 - (NSUInteger)hash
 {
-    return super.hash ^ self.image.hash;
+    return super.hash ^ self.image.hash ^ self.imageURL.hash;
 }
 
 - (NSString *)description
 {
-    return [NSString stringWithFormat:@"<%@: image=%@, appliesMediaViewMaskAsOutgoing=%@>",
-            [self class], self.image, @(self.appliesMediaViewMaskAsOutgoing)];
+    return [NSString stringWithFormat:@"<%@: image=%@, imageURL=%@, appliesMediaViewMaskAsOutgoing=%@>",
+            [self class], self.image, self.imageURL, @(self.appliesMediaViewMaskAsOutgoing)];
 }
 
 #pragma mark - NSCoding
@@ -115,6 +224,8 @@
     self = [super initWithCoder:aDecoder];
     if (self) {
         _image = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(image))];
+        _imageURL = [aDecoder decodeObjectForKey:NSStringFromSelector(@selector(imageURL))];
+        _imageIdentifier = [[NSUUID UUID] UUIDString];
     }
     return self;
 }
@@ -123,6 +234,7 @@
 {
     [super encodeWithCoder:aCoder];
     [aCoder encodeObject:self.image forKey:NSStringFromSelector(@selector(image))];
+    [aCoder encodeObject:self.imageURL forKey:NSStringFromSelector(@selector(imageURL))];
 }
 
 #pragma mark - NSCopying
@@ -130,6 +242,7 @@
 - (instancetype)copyWithZone:(NSZone *)zone
 {
     JSQPhotoMediaItem *copy = [[JSQPhotoMediaItem allocWithZone:zone] initWithImage:self.image];
+    copy.imageURL = self.imageURL;
     copy.appliesMediaViewMaskAsOutgoing = self.appliesMediaViewMaskAsOutgoing;
     return copy;
 }
@@ -20,13 +20,25 @@
 
 #import "JSQMessagesMediaPlaceholderView.h"
 #import "JSQMessagesMediaViewBubbleImageMasker.h"
+#import "JSQMessagesMediaImageView.h"
+#import "JSQMessagesVideoPosterGenerator.h"
 
 #import "UIImage+JSQMessages.h"
 
 
 @interface JSQVideoMediaItem ()
 
-@property (strong, nonatomic) UIImageView *cachedVideoImageView;
+@property (strong, nonatomic) JSQMessagesMediaImageView *cachedVideoImageView;
+
+@property (strong, nonatomic) JSQMessagesLoadRequest *posterRequest;
+
++ (UIImage *)jsq_playIconImage;
+
+- (CGSize)jsq_posterPixelSize;
+
+- (void)jsq_loadPosterIntoImageView:(JSQMessagesMediaImageView *)imageView;
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView;
 
 @end
 
@@ -49,12 +61,16 @@
 - (void)dealloc
 {
     _fileURL = nil;
+    _cachedVideoImageView.windowHandler = nil;
     _cachedVideoImageView = nil;
 }
 
 - (void)clearCachedMediaViews
 {
     [super clearCachedMediaViews];
+    [[JSQMessagesVideoPosterGenerator sharedGenerator] cancelPosterRequest:_posterRequest];
+    _posterRequest = nil;
+    _cachedVideoImageView.windowHandler = nil;
     _cachedVideoImageView = nil;
 }
 
@@ -63,21 +79,85 @@
 - (void)setFileURL:(NSURL *)fileURL
 {
     _fileURL = [fileURL copy];
+    _cachedVideoImageView.windowHandler = nil;
     _cachedVideoImageView = nil;
 }
 
 - (void)setIsReadyToPlay:(BOOL)isReadyToPlay
 {
     _isReadyToPlay = isReadyToPlay;
+    _cachedVideoImageView.windowHandler = nil;
     _cachedVideoImageView = nil;
 }
 
 - (void)setAppliesMediaViewMaskAsOutgoing:(BOOL)appliesMediaViewMaskAsOutgoing
 {
     [super setAppliesMediaViewMaskAsOutgoing:appliesMediaViewMaskAsOutgoing];
+    _cachedVideoImageView.windowHandler = nil;
     _cachedVideoImageView = nil;
 }
 
+#pragma mark - Posters
+
++ (UIImage *)jsq_playIconImage
+{
+    static UIImage *_playIconImage = nil;
+    
+    //  tinted once and shared by every video item
+    static dispatch_once_t onceToken = 0;
+    dispatch_once(&onceToken, ^{
+        _playIconImage = [[UIImage jsq_defaultPlayImage] jsq_imageMaskedWithColor:[UIColor lightGrayColor]];
+    });
+    
+    return _playIconImage;
+}
+
+- (CGSize)jsq_posterPixelSize
+{
+    CGSize size = [self mediaViewDisplaySize];
+    CGFloat scale = [UIScreen mainScreen].scale;
+    return CGSizeMake(size.width * scale, size.height * scale);
+}
+
+- (void)jsq_loadPosterIntoImageView:(JSQMessagesMediaImageView *)imageView
+{
+    __weak JSQVideoMediaItem *weakSelf = self;
+    __weak JSQMessagesMediaImageView *weakImageView = imageView;
+    
+    JSQMessagesVideoPosterGenerator *generator = [JSQMessagesVideoPosterGenerator sharedGenerator];
+    [generator cancelPosterRequest:self.posterRequest];
+    
+    self.posterRequest = [generator generatePosterForFileURL:self.fileURL
+                                                   pixelSize:[self jsq_posterPixelSize]
+                                                  completion:^(UIImage *poster) {
+                                                      weakSelf.posterRequest = nil;
+                                                      
+                                                      //  the file URL may have changed in the meantime, which discards the view
+                                                      if (weakSelf.cachedVideoImageView == weakImageView) {
+                                                          weakImageView.image = poster;
+                                                      }
+                                                  }];
+}
+
+- (void)jsq_imageViewDidMoveToWindow:(JSQMessagesMediaImageView *)imageView
+{
+    if (imageView != self.cachedVideoImageView) {
+        return;
+    }
+    
+    if (imageView.window != nil) {
+        if (imageView.image == nil) {
+            [self jsq_loadPosterIntoImageView:imageView];
+        }
+        return;
+    }
+    
+    //  only this view stops waiting, other items may share the same poster
+    [[JSQMessagesVideoPosterGenerator sharedGenerator] cancelPosterRequest:self.posterRequest];
+    self.posterRequest = nil;
+    imageView.image = nil;
+}
+
 #pragma mark - JSQMessageMediaData protocol
 
 - (UIView *)mediaView
@@ -88,15 +168,29 @@
     
     if (self.cachedVideoImageView == nil) {
         CGSize size = [self mediaViewDisplaySize];
-        UIImage *playIcon = [[UIImage jsq_defaultPlayImage] jsq_imageMaskedWithColor:[UIColor lightGrayColor]];
         
-        UIImageView *imageView = [[UIImageView alloc] initWithImage:playIcon];
+        JSQMessagesMediaImageView *imageView = [[JSQMessagesMediaImageView alloc] initWithFrame:CGRectMake(0.0f, 0.0f, size.width, size.height)];
         imageView.backgroundColor = [UIColor blackColor];
-        imageView.frame = CGRectMake(0.0f, 0.0f, size.width, size.height);
-        imageView.contentMode = UIViewContentModeCenter;
+        imageView.contentMode = UIViewContentModeScaleAspectFill;
         imageView.clipsToBounds = YES;
+        
+        UIImageView *playIconView = [[UIImageView alloc] initWithImage:[JSQVideoMediaItem jsq_playIconImage]];
+        playIconView.frame = imageView.bounds;
+        playIconView.contentMode = UIViewContentModeCenter;
+        playIconView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        [imageView addSubview:playIconView];
+        
         [JSQMessagesMediaViewBubbleImageMasker applyBubbleImageMaskToMediaView:imageView isOutgoing:self.appliesMediaViewMaskAsOutgoing];
+        
+        __weak JSQVideoMediaItem *weakSelf = self;
+        imageView.windowHandler = ^(JSQMessagesMediaImageView *view) {
+            [weakSelf jsq_imageViewDidMoveToWindow:view];
+        };
+        
         self.cachedVideoImageView = imageView;
+        
+        //  start generating right away, the view may be requested ahead of display by the prefetcher
+        [self jsq_loadPosterIntoImageView:imageView];
     }
     
     return self.cachedVideoImageView;
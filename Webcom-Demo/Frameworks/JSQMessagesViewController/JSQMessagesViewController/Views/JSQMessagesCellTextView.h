@@ -24,4 +24,15 @@
  */
 @interface JSQMessagesCellTextView : UITextView
 
+/**
+ *  Applies link attributes previously computed by a `JSQMessagesDataDetector` to the current text of the text view.
+ *
+ *  @param links An attributed string whose `NSLinkAttributeName` attributes describe the detected ranges.
+ *  If its string does not match the current text of the text view, this method does nothing.
+ *
+ *  @discussion Use this method instead of setting `dataDetectorTypes`, which runs detection on the main thread
+ *  each time the text changes. The current `font` and `textColor` of the text view are preserved.
+ */
+- (void)jsq_applyDetectedLinks:(NSAttributedString *)links;
+
 @end
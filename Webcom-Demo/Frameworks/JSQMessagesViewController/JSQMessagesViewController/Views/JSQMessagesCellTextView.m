@@ -20,10 +20,8 @@
 
 @implementation JSQMessagesCellTextView
 
-- (void)awakeFromNib
+- (void)jsq_configureTextView
 {
-    [super awakeFromNib];
-    
     self.textColor = [UIColor whiteColor];
     self.editable = NO;
     self.selectable = YES;
@@ -42,6 +40,59 @@
                                  NSUnderlineStyleAttributeName : @(NSUnderlineStyleSingle | NSUnderlinePatternSolid) };
 }
 
+- (instancetype)initWithFrame:(CGRect)frame textContainer:(NSTextContainer *)textContainer
+{
+    self = [super initWithFrame:frame textContainer:textContainer];
+    if (self) {
+        [self jsq_configureTextView];
+    }
+    return self;
+}
+
+- (void)awakeFromNib
+{
+    [super awakeFromNib];
+    [self jsq_configureTextView];
+}
+
+- (void)jsq_applyDetectedLinks:(NSAttributedString *)links
+{
+    if (links.length == 0 || ![links.string isEqualToString:self.text]) {
+        return;
+    }
+
+    NSMutableAttributedString *attributedText = nil;
+    NSRange fullRange = NSMakeRange(0, links.length);
+
+    for (NSUInteger location = 0; location < links.length; ) {
+        NSRange range;
+        id link = [links attribute:NSLinkAttributeName atIndex:location longestEffectiveRange:&range inRange:fullRange];
+
+        if (link != nil) {
+            if (attributedText == nil) {
+                NSMutableDictionary *attributes = [NSMutableDictionary new];
+                if (self.font) {
+                    attributes[NSFontAttributeName] = self.font;
+                }
+                if (self.textColor) {
+                    attributes[NSForegroundColorAttributeName] = self.textColor;
+                }
+                attributedText = [[NSMutableAttributedString alloc] initWithString:links.string attributes:attributes];
+            }
+            [attributedText addAttribute:NSLinkAttributeName value:link range:range];
+        }
+
+        location = NSMaxRange(range);
+    }
+
+    //  nothing detected, keep the plain text
+    if (attributedText == nil) {
+        return;
+    }
+
+    self.attributedText = attributedText;
+}
+
 - (void)setSelectedRange:(NSRange)selectedRange
 {
     //  attempt to prevent selecting text
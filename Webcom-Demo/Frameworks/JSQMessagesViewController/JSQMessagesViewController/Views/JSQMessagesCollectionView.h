@@ -25,11 +25,15 @@
 
 @class JSQMessagesTypingIndicatorFooterView;
 @class JSQMessagesLoadEarlierHeaderView;
+@class JSQMessagesDayHeaderView;
 
 
 /**
  *  The `JSQMessagesCollectionView` class manages an ordered collection of message data items and presents
  *  them using a specialized layout for messages.
+ *
+ *  When initialized with `initWithFrame:collectionViewLayout:`, the collection view registers incoming and outgoing
+ *  cells that build their subviews in code and lay them out by frame. When loaded from a nib, it registers the cell nibs.
  */
 @interface JSQMessagesCollectionView : UICollectionView <JSQMessagesCollectionViewCellDelegate>
 
@@ -98,4 +102,26 @@
  */
 - (JSQMessagesLoadEarlierHeaderView *)dequeueLoadEarlierMessagesViewHeaderForIndexPath:(NSIndexPath *)indexPath;
 
+/**
+ *  Returns a `JSQMessagesDayHeaderView` object for the specified index path.
+ *
+ *  @param indexPath The index path specifying the location of the supplementary view in the collection view. This value must not be `nil`.
+ *
+ *  @return A valid `JSQMessagesDayHeaderView` object.
+ */
+- (JSQMessagesDayHeaderView *)dequeueDayHeaderViewForIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ *  Returns a `JSQMessagesDayHeaderView` object for the specified index path, whose accessory view
+ *  is a `JSQMessagesLoadEarlierHeaderView`.
+ *
+ *  @param indexPath The index path specifying the location of the supplementary view in the collection view. This value must not be `nil`.
+ *
+ *  @return A valid `JSQMessagesDayHeaderView` object.
+ *
+ *  @discussion Use this method for the first day section when the "load earlier messages" header is shown,
+ *  with a header height of `kJSQMessagesLoadEarlierHeaderViewHeight + kJSQMessagesDayHeaderViewHeight`.
+ */
+- (JSQMessagesDayHeaderView *)dequeueDayHeaderViewWithLoadEarlierMessagesViewForIndexPath:(NSIndexPath *)indexPath;
+
 @end
@@ -24,14 +24,20 @@
 
 #import "JSQMessagesTypingIndicatorFooterView.h"
 #import "JSQMessagesLoadEarlierHeaderView.h"
+#import "JSQMessagesDayHeaderView.h"
 
 #import "UIColor+JSQMessages.h"
 
 
 @interface JSQMessagesCollectionView () <JSQMessagesLoadEarlierHeaderViewDelegate>
 
+@property (strong, nonatomic) JSQMessagesLoadEarlierHeaderView *spareLoadEarlierMessagesView;
+
 - (void)jsq_configureCollectionView;
 
+- (void)jsq_registerCellNibs;
+- (void)jsq_registerCellClasses;
+
 @end
 
 
@@ -52,18 +58,6 @@
     self.alwaysBounceVertical = YES;
     self.bounces = YES;
     
-    [self registerNib:[JSQMessagesCollectionViewCellIncoming nib]
-          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming cellReuseIdentifier]];
-    
-    [self registerNib:[JSQMessagesCollectionViewCellOutgoing nib]
-          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing cellReuseIdentifier]];
-    
-    [self registerNib:[JSQMessagesCollectionViewCellIncoming nib]
-          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming mediaCellReuseIdentifier]];
-    
-    [self registerNib:[JSQMessagesCollectionViewCellOutgoing nib]
-          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing mediaCellReuseIdentifier]];
-    
     [self registerNib:[JSQMessagesTypingIndicatorFooterView nib]
           forSupplementaryViewOfKind:UICollectionElementKindSectionFooter
           withReuseIdentifier:[JSQMessagesTypingIndicatorFooterView footerReuseIdentifier]];
@@ -71,6 +65,10 @@
     [self registerNib:[JSQMessagesLoadEarlierHeaderView nib]
           forSupplementaryViewOfKind:UICollectionElementKindSectionHeader
           withReuseIdentifier:[JSQMessagesLoadEarlierHeaderView headerReuseIdentifier]];
+    
+    [self registerClass:[JSQMessagesDayHeaderView class]
+          forSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+          withReuseIdentifier:[JSQMessagesDayHeaderView headerReuseIdentifier]];
 
     _typingIndicatorDisplaysOnLeft = YES;
     _typingIndicatorMessageBubbleColor = [UIColor jsq_messageBubbleLightGrayColor];
@@ -79,11 +77,43 @@
     _loadEarlierMessagesHeaderTextColor = [UIColor jsq_messageBubbleBlueColor];
 }
 
+- (void)jsq_registerCellNibs
+{
+    [self registerNib:[JSQMessagesCollectionViewCellIncoming nib]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming cellReuseIdentifier]];
+    
+    [self registerNib:[JSQMessagesCollectionViewCellOutgoing nib]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing cellReuseIdentifier]];
+    
+    [self registerNib:[JSQMessagesCollectionViewCellIncoming nib]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming mediaCellReuseIdentifier]];
+    
+    [self registerNib:[JSQMessagesCollectionViewCellOutgoing nib]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing mediaCellReuseIdentifier]];
+}
+
+- (void)jsq_registerCellClasses
+{
+    //  cells built in code skip nib decoding and lay out their subviews by frame
+    [self registerClass:[JSQMessagesCollectionViewCellIncoming class]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming cellReuseIdentifier]];
+
+    [self registerClass:[JSQMessagesCollectionViewCellOutgoing class]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing cellReuseIdentifier]];
+
+    [self registerClass:[JSQMessagesCollectionViewCellIncoming class]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellIncoming mediaCellReuseIdentifier]];
+
+    [self registerClass:[JSQMessagesCollectionViewCellOutgoing class]
+          forCellWithReuseIdentifier:[JSQMessagesCollectionViewCellOutgoing mediaCellReuseIdentifier]];
+}
+
 - (instancetype)initWithFrame:(CGRect)frame collectionViewLayout:(UICollectionViewLayout *)layout
 {
     self = [super initWithFrame:frame collectionViewLayout:layout];
     if (self) {
         [self jsq_configureCollectionView];
+        [self jsq_registerCellClasses];
     }
     return self;
 }
@@ -92,6 +122,7 @@
 {
     [super awakeFromNib];
     [self jsq_configureCollectionView];
+    [self jsq_registerCellNibs];
 }
 
 #pragma mark - Typing indicator
@@ -124,6 +155,53 @@
     return headerView;
 }
 
+#pragma mark - Day header
+
+- (JSQMessagesDayHeaderView *)dequeueDayHeaderViewForIndexPath:(NSIndexPath *)indexPath
+{
+    JSQMessagesDayHeaderView *headerView = [super dequeueReusableSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                                                     withReuseIdentifier:[JSQMessagesDayHeaderView headerReuseIdentifier]
+                                                                            forIndexPath:indexPath];
+    
+    //  keep the load earlier view of a header reused for another section, instead of decoding a new one later
+    if ([headerView.accessoryView isKindOfClass:[JSQMessagesLoadEarlierHeaderView class]]) {
+        self.spareLoadEarlierMessagesView = (JSQMessagesLoadEarlierHeaderView *)headerView.accessoryView;
+    }
+    
+    headerView.accessoryView = nil;
+    return headerView;
+}
+
+- (JSQMessagesDayHeaderView *)dequeueDayHeaderViewWithLoadEarlierMessagesViewForIndexPath:(NSIndexPath *)indexPath
+{
+    JSQMessagesDayHeaderView *headerView = [super dequeueReusableSupplementaryViewOfKind:UICollectionElementKindSectionHeader
+                                                                     withReuseIdentifier:[JSQMessagesDayHeaderView headerReuseIdentifier]
+                                                                            forIndexPath:indexPath];
+    
+    //  each header owns its load earlier view, a view displayed by another header is never taken from it
+    JSQMessagesLoadEarlierHeaderView *loadEarlierView = nil;
+    
+    if ([headerView.accessoryView isKindOfClass:[JSQMessagesLoadEarlierHeaderView class]]) {
+        loadEarlierView = (JSQMessagesLoadEarlierHeaderView *)headerView.accessoryView;
+    }
+    else if (self.spareLoadEarlierMessagesView.superview == nil) {
+        loadEarlierView = self.spareLoadEarlierMessagesView;
+    }
+    
+    self.spareLoadEarlierMessagesView = nil;
+    
+    if (loadEarlierView == nil) {
+        loadEarlierView = [[[JSQMessagesLoadEarlierHeaderView nib] instantiateWithOwner:nil options:nil] firstObject];
+        loadEarlierView.translatesAutoresizingMaskIntoConstraints = YES;
+        loadEarlierView.delegate = self;
+    }
+    
+    loadEarlierView.loadButton.tintColor = self.loadEarlierMessagesHeaderTextColor;
+    headerView.accessoryView = loadEarlierView;
+    
+    return headerView;
+}
+
 #pragma mark - Load earlier messages header delegate
 
 - (void)headerView:(JSQMessagesLoadEarlierHeaderView *)headerView didPressLoadButton:(UIButton *)sender
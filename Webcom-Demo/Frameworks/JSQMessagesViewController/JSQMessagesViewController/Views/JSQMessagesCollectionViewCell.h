@@ -161,6 +161,24 @@
  */
 @property (weak, nonatomic) UIView *mediaView;
 
+/**
+ *  Specifies whether the cell displays a pre-rendered bitmap of its labels, message bubble and text
+ *  instead of its live subviews. The default value is `NO`.
+ *
+ *  @discussion When `YES`, the cell only shows its message bubble image as a placeholder until
+ *  `renderedContentImage` is set. The live subviews are shown again while the cell is highlighted or selected.
+ *  Links in the message text are not interactive while the bitmap is displayed.
+ *
+ *  @see `JSQMessagesCellRenderer`.
+ */
+@property (assign, nonatomic) BOOL displaysRenderedContent;
+
+/**
+ *  The pre-rendered bitmap of the cell content. This value is only displayed if `displaysRenderedContent` is `YES`.
+ *  It is reset to `nil` when the cell is reused.
+ */
+@property (strong, nonatomic) UIImage *renderedContentImage;
+
 /**
  *  Returns the underlying gesture recognizer for tap gestures in the avatarImageView of the cell.
  *  This gesture handles the tap event for the avatarImageView and notifies the cell's delegate.
@@ -62,10 +62,21 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
 
 @property (weak, nonatomic, readwrite) UITapGestureRecognizer *tapGestureRecognizer;
 
+@property (weak, nonatomic) UIImageView *renderedContentImageView;
+
+@property (assign, nonatomic) BOOL jsq_usesManualLayout;
+
+@property (strong, nonatomic) JSQMessagesCollectionViewLayoutAttributes *currentLayoutAttributes;
+
+- (void)jsq_configureCell;
+- (void)jsq_loadSubviews;
+
 - (void)jsq_handleTapGesture:(UITapGestureRecognizer *)tap;
 
 - (void)jsq_updateConstraint:(NSLayoutConstraint *)constraint withConstant:(CGFloat)constant;
 
+- (void)jsq_updateRenderedContentVisibility;
+
 @end
 
 
@@ -103,20 +114,10 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
 
 #pragma mark - Initialization
 
-- (void)awakeFromNib
+- (void)jsq_configureCell
 {
-    [super awakeFromNib];
-
-    [self setTranslatesAutoresizingMaskIntoConstraints:NO];
-
     self.backgroundColor = [UIColor whiteColor];
 
-    self.cellTopLabelHeightConstraint.constant = 0.0f;
-    self.messageBubbleTopLabelHeightConstraint.constant = 0.0f;
-    self.cellBottomLabelHeightConstraint.constant = 0.0f;
-
-    self.avatarViewSize = CGSizeZero;
-
     self.cellTopLabel.textAlignment = NSTextAlignmentCenter;
     self.cellTopLabel.font = [UIFont boldSystemFontOfSize:12.0f];
     self.cellTopLabel.textColor = [UIColor lightGrayColor];
@@ -130,6 +131,88 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
     UITapGestureRecognizer *tap = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(jsq_handleTapGesture:)];
     [self addGestureRecognizer:tap];
     self.tapGestureRecognizer = tap;
+
+    //  sits above the labels and message bubble, below the avatar
+    UIImageView *renderedContentImageView = [[UIImageView alloc] initWithFrame:self.contentView.bounds];
+    renderedContentImageView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    renderedContentImageView.userInteractionEnabled = NO;
+    renderedContentImageView.hidden = YES;
+    [self.avatarContainerView.superview insertSubview:renderedContentImageView belowSubview:self.avatarContainerView];
+    self.renderedContentImageView = renderedContentImageView;
+}
+
+- (void)jsq_loadSubviews
+{
+    //  mirrors the view hierarchy of the cell nibs, laid out by frame in `layoutSubviews`
+    UIView *contentView = self.contentView;
+    self.clipsToBounds = YES;
+    contentView.clipsToBounds = YES;
+
+    JSQMessagesLabel *cellTopLabel = [[JSQMessagesLabel alloc] initWithFrame:CGRectZero];
+    JSQMessagesLabel *messageBubbleTopLabel = [[JSQMessagesLabel alloc] initWithFrame:CGRectZero];
+    JSQMessagesLabel *cellBottomLabel = [[JSQMessagesLabel alloc] initWithFrame:CGRectZero];
+
+    for (JSQMessagesLabel *label in @[ cellTopLabel, messageBubbleTopLabel, cellBottomLabel ]) {
+        [label setTranslatesAutoresizingMaskIntoConstraints:YES];
+        label.userInteractionEnabled = NO;
+        label.textAlignment = NSTextAlignmentCenter;
+    }
+
+    UIView *messageBubbleContainerView = [[UIView alloc] initWithFrame:CGRectZero];
+
+    UIImageView *messageBubbleImageView = [[UIImageView alloc] initWithFrame:CGRectZero];
+    messageBubbleImageView.userInteractionEnabled = NO;
+    [messageBubbleContainerView addSubview:messageBubbleImageView];
+
+    JSQMessagesCellTextView *textView = [[JSQMessagesCellTextView alloc] initWithFrame:CGRectZero textContainer:nil];
+    [messageBubbleContainerView addSubview:textView];
+
+    UIView *avatarContainerView = [[UIView alloc] initWithFrame:CGRectZero];
+
+    UIImageView *avatarImageView = [[UIImageView alloc] initWithFrame:CGRectZero];
+    avatarImageView.userInteractionEnabled = NO;
+    [avatarContainerView addSubview:avatarImageView];
+
+    [contentView addSubview:cellTopLabel];
+    [contentView addSubview:messageBubbleTopLabel];
+    [contentView addSubview:messageBubbleContainerView];
+    [contentView addSubview:avatarContainerView];
+    [contentView addSubview:cellBottomLabel];
+
+    self.cellTopLabel = cellTopLabel;
+    self.messageBubbleTopLabel = messageBubbleTopLabel;
+    self.cellBottomLabel = cellBottomLabel;
+    self.messageBubbleContainerView = messageBubbleContainerView;
+    self.messageBubbleImageView = messageBubbleImageView;
+    self.textView = textView;
+    self.avatarContainerView = avatarContainerView;
+    self.avatarImageView = avatarImageView;
+}
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        _jsq_usesManualLayout = YES;
+        [self jsq_loadSubviews];
+        [self jsq_configureCell];
+    }
+    return self;
+}
+
+- (void)awakeFromNib
+{
+    [super awakeFromNib];
+
+    [self setTranslatesAutoresizingMaskIntoConstraints:NO];
+
+    self.cellTopLabelHeightConstraint.constant = 0.0f;
+    self.messageBubbleTopLabelHeightConstraint.constant = 0.0f;
+    self.cellBottomLabelHeightConstraint.constant = 0.0f;
+
+    self.avatarViewSize = CGSizeZero;
+
+    [self jsq_configureCell];
 }
 
 - (void)dealloc
@@ -146,6 +229,8 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
 
     _avatarImageView = nil;
 
+    _currentLayoutAttributes = nil;
+
     [_tapGestureRecognizer removeTarget:nil action:NULL];
     _tapGestureRecognizer = nil;
 }
@@ -160,12 +245,13 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
     self.messageBubbleTopLabel.text = nil;
     self.cellBottomLabel.text = nil;
 
-    self.textView.dataDetectorTypes = UIDataDetectorTypeNone;
     self.textView.text = nil;
     self.textView.attributedText = nil;
 
     self.avatarImageView.image = nil;
     self.avatarImageView.highlightedImage = nil;
+
+    self.renderedContentImage = nil;
 }
 
 - (UICollectionViewLayoutAttributes *)preferredLayoutAttributesFittingAttributes:(UICollectionViewLayoutAttributes *)layoutAttributes
@@ -187,6 +273,15 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
         self.textView.textContainerInset = customAttributes.textViewTextContainerInsets;
     }
 
+    if (self.jsq_usesManualLayout) {
+        //  the subviews are already laid out for identical attributes
+        if (![customAttributes isEqual:self.currentLayoutAttributes]) {
+            self.currentLayoutAttributes = customAttributes;
+            [self setNeedsLayout];
+        }
+        return;
+    }
+
     self.textViewFrameInsets = customAttributes.textViewFrameInsets;
 
     [self jsq_updateConstraint:self.messageBubbleContainerWidthConstraint
@@ -209,16 +304,42 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
     }
 }
 
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+
+    if (!self.jsq_usesManualLayout) {
+        return;
+    }
+
+    //  all frames are precomputed by the layout
+    JSQMessagesCollectionViewLayoutAttributes *attributes = self.currentLayoutAttributes;
+
+    self.cellTopLabel.frame = attributes.cellTopLabelFrame;
+    self.messageBubbleTopLabel.frame = attributes.messageBubbleTopLabelFrame;
+    self.cellBottomLabel.frame = attributes.cellBottomLabelFrame;
+
+    self.avatarContainerView.frame = attributes.avatarContainerViewFrame;
+    self.avatarImageView.frame = self.avatarContainerView.bounds;
+
+    self.messageBubbleContainerView.frame = attributes.messageBubbleContainerViewFrame;
+    self.messageBubbleImageView.frame = self.messageBubbleContainerView.bounds;
+    self.mediaView.frame = self.messageBubbleContainerView.bounds;
+    self.textView.frame = attributes.textViewFrame;
+}
+
 - (void)setHighlighted:(BOOL)highlighted
 {
     [super setHighlighted:highlighted];
     self.messageBubbleImageView.highlighted = highlighted;
+    [self jsq_updateRenderedContentVisibility];
 }
 
 - (void)setSelected:(BOOL)selected
 {
     [super setSelected:selected];
     self.messageBubbleImageView.highlighted = selected;
+    [self jsq_updateRenderedContentVisibility];
 }
 
 //  FIXME: radar 18326340
@@ -312,11 +433,18 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
     [self.messageBubbleImageView removeFromSuperview];
     [self.textView removeFromSuperview];
 
-    [mediaView setTranslatesAutoresizingMaskIntoConstraints:NO];
     mediaView.frame = self.messageBubbleContainerView.bounds;
-
     [self.messageBubbleContainerView addSubview:mediaView];
-    [self.messageBubbleContainerView jsq_pinAllEdgesOfSubview:mediaView];
+
+    if (self.jsq_usesManualLayout) {
+        [mediaView setTranslatesAutoresizingMaskIntoConstraints:YES];
+        mediaView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    }
+    else {
+        [mediaView setTranslatesAutoresizingMaskIntoConstraints:NO];
+        [self.messageBubbleContainerView jsq_pinAllEdgesOfSubview:mediaView];
+    }
+
     _mediaView = mediaView;
 
     //  because of cell re-use (and caching media views, if using built-in library media item)
@@ -331,6 +459,22 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
     });
 }
 
+- (void)setDisplaysRenderedContent:(BOOL)displaysRenderedContent
+{
+    if (_displaysRenderedContent == displaysRenderedContent) {
+        return;
+    }
+
+    _displaysRenderedContent = displaysRenderedContent;
+    [self jsq_updateRenderedContentVisibility];
+}
+
+- (void)setRenderedContentImage:(UIImage *)renderedContentImage
+{
+    _renderedContentImage = renderedContentImage;
+    [self jsq_updateRenderedContentVisibility];
+}
+
 #pragma mark - Getters
 
 - (CGSize)avatarViewSize
@@ -349,6 +493,23 @@ static NSMutableSet *jsqMessagesCollectionViewCellActions = nil;
 
 #pragma mark - Utilities
 
+- (void)jsq_updateRenderedContentVisibility
+{
+    BOOL showsLiveContent = !self.displaysRenderedContent || self.highlighted || self.selected;
+    BOOL showsRenderedContent = !showsLiveContent && self.renderedContentImage != nil;
+
+    self.renderedContentImageView.image = showsRenderedContent ? self.renderedContentImage : nil;
+    self.renderedContentImageView.hidden = !showsRenderedContent;
+
+    //  while the bitmap is pending, the bubble image alone serves as a cheap placeholder
+    self.messageBubbleImageView.hidden = showsRenderedContent;
+    self.textView.hidden = !showsLiveContent;
+
+    self.cellTopLabel.hidden = !showsLiveContent;
+    self.messageBubbleTopLabel.hidden = !showsLiveContent;
+    self.cellBottomLabel.hidden = !showsLiveContent;
+}
+
 - (void)jsq_updateConstraint:(NSLayoutConstraint *)constraint withConstant:(CGFloat)constant
 {
     if (constraint.constant == constant) {
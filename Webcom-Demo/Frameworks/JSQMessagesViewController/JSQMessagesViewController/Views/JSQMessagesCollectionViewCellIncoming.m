@@ -22,6 +22,16 @@
 
 #pragma mark - Overrides
 
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        self.messageBubbleTopLabel.textAlignment = NSTextAlignmentLeft;
+        self.cellBottomLabel.textAlignment = NSTextAlignmentLeft;
+    }
+    return self;
+}
+
 - (void)awakeFromNib
 {
     [super awakeFromNib];
@@ -22,6 +22,16 @@
 
 #pragma mark - Overrides
 
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        self.messageBubbleTopLabel.textAlignment = NSTextAlignmentRight;
+        self.cellBottomLabel.textAlignment = NSTextAlignmentRight;
+    }
+    return self;
+}
+
 - (void)awakeFromNib
 {
     [super awakeFromNib];
@@ -34,6 +34,23 @@
  */
 - (BOOL)composerTextView:(JSQMessagesComposerTextView *)textView shouldPasteWithSender:(id)sender;
 
+@optional
+
+/**
+ *  Asks the delegate whether or not the `textView` should insert a large pasted text, once it has been measured.
+ *
+ *  @param textView The text view the text was pasted into.
+ *  @param text     The pasted text. Its length is at least the `largePasteThreshold` of the text view.
+ *  @param height   The height of the text when laid out at the current width and font of the text view.
+ *
+ *  @return `YES` to insert the text, `NO` to handle it yourself, for example by sending it as an attachment.
+ *
+ *  @discussion This method is called on the main thread. If it is not implemented, the text is inserted.
+ */
+- (BOOL)composerTextView:(JSQMessagesComposerTextView *)textView
+    shouldInsertLargePastedText:(NSString *)text
+                 measuredHeight:(CGFloat)height;
+
 @end
 
 /**
@@ -57,11 +74,36 @@
  */
 @property (weak, nonatomic) id<JSQMessagesComposerTextViewPasteDelegate> pasteDelegate;
 
+/**
+ *  The length, in characters, from which a pasted text is measured on a background queue before it is inserted.
+ *  The default value is `16384`. Specify `NSNotFound` to always paste synchronously.
+ *
+ *  @discussion Large texts are measured in chunks, and the paste delegate is given a chance to handle them
+ *  instead, see `composerTextView:shouldInsertLargePastedText:measuredHeight:`. The text is then inserted
+ *  in the same chunks, one per run loop turn, so that laying it out never blocks the main thread for long.
+ *  The chunks replace the selection at the time the insertion starts, and editing is locked until the last one
+ *  is inserted. The delegate is asked and notified once, and the whole paste is a single undo step.
+ *  A pending measurement or insertion is dropped if the text of the text view is set in the meantime.
+ */
+@property (assign, nonatomic) NSUInteger largePasteThreshold;
+
+/**
+ *  Returns whether or not a large pasted text is being measured.
+ */
+@property (assign, nonatomic, readonly, getter=isMeasuringPastedText) BOOL measuringPastedText;
+
+/**
+ *  Returns whether or not a large pasted text is being inserted.
+ */
+@property (assign, nonatomic, readonly, getter=isInsertingPastedText) BOOL insertingPastedText;
+
 /**
  *  Determines whether or not the text view contains text after trimming white space 
  *  from the front and back of its string.
  *
  *  @return `YES` if the text view contains text, `NO` otherwise.
+ *
+ *  @discussion This method stops at the first character that is not white space, it does not copy the text.
  */
 - (BOOL)hasText;
 
@@ -23,15 +23,47 @@
 #import "NSString+JSQMessages.h"
 
 
+static const NSUInteger kJSQMessagesComposerTextViewMeasurementChunkLength = 8192;
+
+
 @interface JSQMessagesComposerTextView ()
 
+@property (strong, nonatomic, readonly) CATextLayer *placeholderLayer;
+
+@property (strong, nonatomic, readonly) NSOperationQueue *measurementQueue;
+
+@property (strong, nonatomic) NSOperation *pendingPasteOperation;
+
+@property (copy, nonatomic) NSString *pendingInsertionText;
+
+@property (assign, nonatomic) NSUInteger pendingInsertionLocation;
+
+@property (assign, nonatomic) NSRange pendingInsertionRange;
+
+@property (copy, nonatomic) NSString *pendingReplacedText;
+
 - (void)jsq_configureTextView;
 
 - (void)jsq_addTextViewNotificationObservers;
 - (void)jsq_removeTextViewNotificationObservers;
 - (void)jsq_didReceiveTextViewNotification:(NSNotification *)notification;
 
-- (NSDictionary *)jsq_placeholderTextAttributes;
+- (void)jsq_updatePlaceholderLayer;
+- (void)jsq_updatePlaceholderLayerVisibility;
+
+- (void)jsq_cancelPendingPaste;
+- (void)jsq_pasteLargeText:(NSString *)text;
+- (void)jsq_finishMeasuringPastedText:(NSString *)text height:(CGFloat)height operation:(NSOperation *)operation;
+- (void)jsq_insertNextChunkOfPastedText:(NSString *)text;
+- (void)jsq_finishInsertingPastedText;
+- (void)jsq_replaceTextInRange:(NSRange)range withText:(NSString *)text;
+
++ (NSRange)jsq_rangeOfChunkOfText:(NSString *)text atLocation:(NSUInteger)location;
+
++ (CGFloat)jsq_heightOfText:(NSString *)text
+             withAttributes:(NSDictionary *)attributes
+                      width:(CGFloat)width
+                  operation:(NSOperation *)operation;
 
 @end
 
@@ -57,15 +89,35 @@
     self.textContainerInset = UIEdgeInsetsMake(4.0f, 2.0f, 4.0f, 2.0f);
     self.contentInset = UIEdgeInsetsMake(1.0f, 0.0f, 1.0f, 0.0f);
     
+    //  only lay out the visible part of long texts
+    self.layoutManager.allowsNonContiguousLayout = YES;
+    
     self.scrollEnabled = YES;
     self.scrollsToTop = NO;
     self.userInteractionEnabled = YES;
     
+    if (_placeholderLayer == nil) {
+        _placeholderLayer = [CATextLayer new];
+        _placeholderLayer.contentsScale = [UIScreen mainScreen].scale;
+        _placeholderLayer.truncationMode = kCATruncationEnd;
+        _placeholderLayer.wrapped = NO;
+        
+        //  behind the text and the caret
+        [self.layer insertSublayer:_placeholderLayer atIndex:0];
+    }
+    
+    if (_measurementQueue == nil) {
+        _measurementQueue = [NSOperationQueue new];
+        _measurementQueue.name = @"com.jessesquires.JSQMessagesComposerTextView";
+        _measurementQueue.maxConcurrentOperationCount = 1;
+    }
+    
+    _largePasteThreshold = 16384;
+    
     self.font = [UIFont systemFontOfSize:16.0f];
     self.textColor = [UIColor blackColor];
     self.textAlignment = NSTextAlignmentNatural;
     
-    self.contentMode = UIViewContentModeRedraw;
     self.dataDetectorTypes = UIDataDetectorTypeNone;
     self.keyboardAppearance = UIKeyboardAppearanceDefault;
     self.keyboardType = UIKeyboardTypeDefault;
@@ -76,6 +128,8 @@
     _placeHolder = nil;
     _placeHolderTextColor = [UIColor lightGrayColor];
     
+    [self jsq_updatePlaceholderLayer];
+    
     [self jsq_addTextViewNotificationObservers];
 }
 
@@ -97,6 +151,12 @@
 - (void)dealloc
 {
     [self jsq_removeTextViewNotificationObservers];
+    [_measurementQueue cancelAllOperations];
+    _measurementQueue = nil;
+    _pendingPasteOperation = nil;
+    _pendingInsertionText = nil;
+    _pendingReplacedText = nil;
+    _placeholderLayer = nil;
     _placeHolder = nil;
     _placeHolderTextColor = nil;
 }
@@ -105,7 +165,9 @@
 
 - (BOOL)hasText
 {
-    return ([[self.text jsq_stringByTrimingWhitespace] length] > 0);
+    //  stops at the first non white space character, instead of trimming a copy of the whole text
+    NSCharacterSet *nonWhitespaceCharacterSet = [[NSCharacterSet whitespaceAndNewlineCharacterSet] invertedSet];
+    return ([self.textStorage.string rangeOfCharacterFromSet:nonWhitespaceCharacterSet].location != NSNotFound);
 }
 
 #pragma mark - Setters
@@ -117,7 +179,7 @@
     }
     
     _placeHolder = [placeHolder copy];
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayer];
 }
 
 - (void)setPlaceHolderTextColor:(UIColor *)placeHolderTextColor
@@ -127,54 +189,378 @@
     }
     
     _placeHolderTextColor = placeHolderTextColor;
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayer];
+}
+
+#pragma mark - Getters
+
+- (BOOL)isMeasuringPastedText
+{
+    return (self.pendingPasteOperation != nil);
+}
+
+- (BOOL)isInsertingPastedText
+{
+    return (self.pendingInsertionText != nil);
 }
 
 #pragma mark - UITextView overrides
 
 - (void)setText:(NSString *)text
 {
+    [self jsq_cancelPendingPaste];
     [super setText:text];
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayerVisibility];
 }
 
 - (void)setAttributedText:(NSAttributedString *)attributedText
 {
+    [self jsq_cancelPendingPaste];
     [super setAttributedText:attributedText];
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayerVisibility];
 }
 
 - (void)setFont:(UIFont *)font
 {
     [super setFont:font];
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayer];
 }
 
 - (void)setTextAlignment:(NSTextAlignment)textAlignment
 {
     [super setTextAlignment:textAlignment];
-    [self setNeedsDisplay];
+    [self jsq_updatePlaceholderLayer];
+}
+
+- (void)insertText:(NSString *)text
+{
+    //  editing is locked while a large paste is inserted, the chunks are inserted at a tracked location
+    if (self.isInsertingPastedText) {
+        return;
+    }
+    
+    [super insertText:text];
+}
+
+- (void)deleteBackward
+{
+    if (self.isInsertingPastedText) {
+        return;
+    }
+    
+    [super deleteBackward];
+}
+
+- (void)setMarkedText:(NSString *)markedText selectedRange:(NSRange)selectedRange
+{
+    if (self.isInsertingPastedText) {
+        return;
+    }
+    
+    [super setMarkedText:markedText selectedRange:selectedRange];
+}
+
+- (void)cut:(id)sender
+{
+    if (self.isInsertingPastedText) {
+        return;
+    }
+    
+    [super cut:sender];
 }
 
 - (void)paste:(id)sender
 {
-    if (!self.pasteDelegate || [self.pasteDelegate composerTextView:self shouldPasteWithSender:sender]) {
+    if (self.isInsertingPastedText) {
+        return;
+    }
+    
+    if (self.pasteDelegate && ![self.pasteDelegate composerTextView:self shouldPasteWithSender:sender]) {
+        return;
+    }
+    
+    NSString *text = [UIPasteboard generalPasteboard].string;
+    
+    if (self.largePasteThreshold == NSNotFound || [text length] < self.largePasteThreshold) {
         [super paste:sender];
+        return;
+    }
+    
+    [self jsq_pasteLargeText:text];
+}
+
+#pragma mark - Layout
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    CGRect placeholderFrame = CGRectInset(self.bounds, 7.0f, 5.0f);
+    if (CGRectEqualToRect(self.placeholderLayer.frame, placeholderFrame)) {
+        return;
+    }
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.placeholderLayer.frame = placeholderFrame;
+    [CATransaction commit];
+}
+
+- (void)didMoveToWindow
+{
+    [super didMoveToWindow];
+    
+    if (self.window != nil) {
+        self.placeholderLayer.contentsScale = self.window.screen.scale;
+    }
+}
+
+#pragma mark - Placeholder
+
+- (void)jsq_updatePlaceholderLayer
+{
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    UIFont *font = self.font;
+    self.placeholderLayer.font = (__bridge CFTypeRef)font;
+    self.placeholderLayer.fontSize = font.pointSize;
+    self.placeholderLayer.foregroundColor = self.placeHolderTextColor.CGColor;
+    self.placeholderLayer.string = self.placeHolder;
+    
+    switch (self.textAlignment) {
+        case NSTextAlignmentLeft:
+            self.placeholderLayer.alignmentMode = kCAAlignmentLeft;
+            break;
+        case NSTextAlignmentCenter:
+            self.placeholderLayer.alignmentMode = kCAAlignmentCenter;
+            break;
+        case NSTextAlignmentRight:
+            self.placeholderLayer.alignmentMode = kCAAlignmentRight;
+            break;
+        case NSTextAlignmentJustified:
+            self.placeholderLayer.alignmentMode = kCAAlignmentJustified;
+            break;
+        case NSTextAlignmentNatural:
+            self.placeholderLayer.alignmentMode = kCAAlignmentNatural;
+            break;
+    }
+    
+    [CATransaction commit];
+    
+    [self jsq_updatePlaceholderLayerVisibility];
+}
+
+- (void)jsq_updatePlaceholderLayerVisibility
+{
+    BOOL hidden = ([self.textStorage length] > 0 || [self.placeHolder length] == 0);
+    if (self.placeholderLayer.hidden == hidden) {
+        return;
+    }
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.placeholderLayer.hidden = hidden;
+    [CATransaction commit];
+}
+
+#pragma mark - Large paste
+
+- (void)jsq_cancelPendingPaste
+{
+    [self.pendingPasteOperation cancel];
+    self.pendingPasteOperation = nil;
+    self.pendingInsertionText = nil;
+    self.pendingReplacedText = nil;
+}
+
+- (void)jsq_pasteLargeText:(NSString *)text
+{
+    [self jsq_cancelPendingPaste];
+    
+    NSDictionary *attributes = @{ NSFontAttributeName : self.font };
+    CGFloat width = CGRectGetWidth(self.bounds)
+                    - self.textContainerInset.left
+                    - self.textContainerInset.right
+                    - 2.0f * self.textContainer.lineFragmentPadding;
+    
+    NSBlockOperation *operation = [NSBlockOperation new];
+    __weak NSBlockOperation *weakOperation = operation;
+    __weak JSQMessagesComposerTextView *weakSelf = self;
+    
+    [operation addExecutionBlock:^{
+        NSOperation *strongOperation = weakOperation;
+        
+        CGFloat height = [JSQMessagesComposerTextView jsq_heightOfText:text
+                                                         withAttributes:attributes
+                                                                  width:MAX(width, 1.0f)
+                                                              operation:strongOperation];
+        
+        if (strongOperation.isCancelled) {
+            return;
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf jsq_finishMeasuringPastedText:text height:height operation:strongOperation];
+        });
+    }];
+    
+    self.pendingPasteOperation = operation;
+    [self.measurementQueue addOperation:operation];
+}
+
+- (void)jsq_finishMeasuringPastedText:(NSString *)text height:(CGFloat)height operation:(NSOperation *)operation
+{
+    //  a newer paste, or setting the text, supersedes this one
+    if (operation != self.pendingPasteOperation) {
+        return;
+    }
+    
+    self.pendingPasteOperation = nil;
+    
+    if ([self.pasteDelegate respondsToSelector:@selector(composerTextView:shouldInsertLargePastedText:measuredHeight:)]
+        && ![self.pasteDelegate composerTextView:self shouldInsertLargePastedText:text measuredHeight:height]) {
+        return;
+    }
+    
+    NSRange selectedRange = self.selectedRange;
+    
+    //  the delegate is asked once for the whole text, as for a regular paste
+    if ([self.delegate respondsToSelector:@selector(textView:shouldChangeTextInRange:replacementText:)]
+        && ![self.delegate textView:self shouldChangeTextInRange:selectedRange replacementText:text]) {
+        return;
+    }
+    
+    self.pendingReplacedText = [self.textStorage.string substringWithRange:selectedRange];
+    [self.textStorage deleteCharactersInRange:selectedRange];
+    
+    self.pendingInsertionText = text;
+    self.pendingInsertionLocation = 0;
+    self.pendingInsertionRange = NSMakeRange(selectedRange.location, 0);
+    [self jsq_insertNextChunkOfPastedText:self.pendingInsertionText];
+}
+
+- (void)jsq_insertNextChunkOfPastedText:(NSString *)text
+{
+    //  a newer paste, or setting the text, supersedes this one
+    if (text == nil || text != self.pendingInsertionText) {
+        return;
+    }
+    
+    NSRange range = [JSQMessagesComposerTextView jsq_rangeOfChunkOfText:text atLocation:self.pendingInsertionLocation];
+    self.pendingInsertionLocation = NSMaxRange(range);
+    
+    //  edits the storage directly, at the end of the chunks inserted so far, whatever the caret does meanwhile,
+    //  one chunk per run loop turn so that text layout does not block the main thread for the whole text
+    NSRange insertionRange = self.pendingInsertionRange;
+    NSAttributedString *chunk = [[NSAttributedString alloc] initWithString:[text substringWithRange:range]
+                                                                attributes:self.typingAttributes];
+    [self.textStorage insertAttributedString:chunk atIndex:NSMaxRange(insertionRange)];
+    self.pendingInsertionRange = NSMakeRange(insertionRange.location, insertionRange.length + range.length);
+    
+    if (self.pendingInsertionLocation >= [text length]) {
+        [self jsq_finishInsertingPastedText];
+        return;
+    }
+    
+    __weak JSQMessagesComposerTextView *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf jsq_insertNextChunkOfPastedText:text];
+    });
+}
+
+- (void)jsq_finishInsertingPastedText
+{
+    NSRange insertionRange = self.pendingInsertionRange;
+    
+    //  the whole paste is a single undo step, whose undo restores the text it replaced
+    [[self.undoManager prepareWithInvocationTarget:self] jsq_replaceTextInRange:insertionRange withText:self.pendingReplacedText];
+    
+    self.pendingInsertionText = nil;
+    self.pendingReplacedText = nil;
+    
+    self.selectedRange = NSMakeRange(NSMaxRange(insertionRange), 0);
+    [self scrollRangeToVisible:self.selectedRange];
+    
+    [self jsq_updatePlaceholderLayerVisibility];
+    
+    //  notified once, like a regular paste
+    [[NSNotificationCenter defaultCenter] postNotificationName:UITextViewTextDidChangeNotification object:self];
+    
+    if ([self.delegate respondsToSelector:@selector(textViewDidChange:)]) {
+        [self.delegate textViewDidChange:self];
+    }
+}
+
+- (void)jsq_replaceTextInRange:(NSRange)range withText:(NSString *)text
+{
+    NSString *replacedText = [self.textStorage.string substringWithRange:range];
+    NSRange replacementRange = NSMakeRange(range.location, [text length]);
+    
+    //  registered while undoing, so this is the redo
+    [[self.undoManager prepareWithInvocationTarget:self] jsq_replaceTextInRange:replacementRange withText:replacedText];
+    
+    [self.textStorage replaceCharactersInRange:range
+                          withAttributedString:[[NSAttributedString alloc] initWithString:text attributes:self.typingAttributes]];
+    
+    self.selectedRange = NSMakeRange(NSMaxRange(replacementRange), 0);
+    [self jsq_updatePlaceholderLayerVisibility];
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:UITextViewTextDidChangeNotification object:self];
+    
+    if ([self.delegate respondsToSelector:@selector(textViewDidChange:)]) {
+        [self.delegate textViewDidChange:self];
     }
 }
 
-#pragma mark - Drawing
++ (NSRange)jsq_rangeOfChunkOfText:(NSString *)text atLocation:(NSUInteger)location
+{
+    NSUInteger length = [text length];
+    NSRange range = NSMakeRange(location, MIN(kJSQMessagesComposerTextViewMeasurementChunkLength, length - location));
+    
+    if (NSMaxRange(range) >= length) {
+        return range;
+    }
+    
+    //  end the chunk after its last line break when there is one, so that lines are not split in two pieces
+    NSRange newlineRange = [text rangeOfCharacterFromSet:[NSCharacterSet newlineCharacterSet]
+                                                 options:NSBackwardsSearch
+                                                   range:range];
+    if (newlineRange.location != NSNotFound) {
+        range.length = NSMaxRange(newlineRange) - range.location;
+        return range;
+    }
+    
+    return [text rangeOfComposedCharacterSequencesForRange:range];
+}
 
-- (void)drawRect:(CGRect)rect
++ (CGFloat)jsq_heightOfText:(NSString *)text
+             withAttributes:(NSDictionary *)attributes
+                      width:(CGFloat)width
+                  operation:(NSOperation *)operation
 {
-    [super drawRect:rect];
+    NSUInteger length = [text length];
+    NSUInteger location = 0;
+    CGFloat height = 0.0f;
     
-    if ([self.text length] == 0 && self.placeHolder) {
-        [self.placeHolderTextColor set];
+    while (location < length) {
+        if (operation.isCancelled) {
+            return 0.0f;
+        }
         
-        [self.placeHolder drawInRect:CGRectInset(rect, 7.0f, 5.0f)
-                      withAttributes:[self jsq_placeholderTextAttributes]];
+        @autoreleasepool {
+            NSRange range = [JSQMessagesComposerTextView jsq_rangeOfChunkOfText:text atLocation:location];
+            
+            CGRect chunkRect = [[text substringWithRange:range] boundingRectWithSize:CGSizeMake(width, CGFLOAT_MAX)
+                                                                             options:(NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingUsesFontLeading)
+                                                                          attributes:attributes
+                                                                             context:nil];
+            height += ceilf(CGRectGetHeight(chunkRect));
+            location = NSMaxRange(range);
+        }
     }
+    
+    return height;
 }
 
 #pragma mark - Notifications
@@ -214,20 +600,7 @@
 
 - (void)jsq_didReceiveTextViewNotification:(NSNotification *)notification
 {
-    [self setNeedsDisplay];
-}
-
-#pragma mark - Utilities
-
-- (NSDictionary *)jsq_placeholderTextAttributes
-{
-    NSMutableParagraphStyle *paragraphStyle = [[NSMutableParagraphStyle alloc] init];
-    paragraphStyle.lineBreakMode = NSLineBreakByTruncatingTail;
-    paragraphStyle.alignment = self.textAlignment;
-    
-    return @{ NSFontAttributeName : self.font,
-              NSForegroundColorAttributeName : self.placeHolderTextColor,
-              NSParagraphStyleAttributeName : paragraphStyle };
+    [self jsq_updatePlaceholderLayerVisibility];
 }
 
 @end
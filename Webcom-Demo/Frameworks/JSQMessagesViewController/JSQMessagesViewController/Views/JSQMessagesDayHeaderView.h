@@ -0,0 +1,57 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  A constant defining the default height of a `JSQMessagesDayHeaderView`.
+ */
+FOUNDATION_EXPORT const CGFloat kJSQMessagesDayHeaderViewHeight;
+
+/**
+ *  The `JSQMessagesDayHeaderView` class implements a reusable view that is placed at the top
+ *  of each day section of a `JSQMessagesCollectionView`, and displays the day of its messages.
+ *
+ *  @see `JSQMessagesDaySections`.
+ */
+@interface JSQMessagesDayHeaderView : UICollectionReusableView
+
+/**
+ *  Returns the label displaying the day.
+ */
+@property (weak, nonatomic, readonly) UILabel *textLabel;
+
+/**
+ *  A view displayed above the day. It fills the header, except for the bottom `kJSQMessagesDayHeaderViewHeight` points
+ *  that show the day. The view controller uses it to display the "load earlier messages" header above the first day.
+ *
+ *  @discussion The default value is `nil`. The header must be made taller by the height of this view.
+ */
+@property (strong, nonatomic) UIView *accessoryView;
+
+#pragma mark - Class methods
+
+/**
+ *  Returns the default string used to identify the reusable header view.
+ *
+ *  @return The string used to identify the reusable header view.
+ */
++ (NSString *)headerReuseIdentifier;
+
+@end
@@ -0,0 +1,114 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesDayHeaderView.h"
+
+
+const CGFloat kJSQMessagesDayHeaderViewHeight = 32.0f;
+
+
+@interface JSQMessagesDayHeaderView ()
+
+@property (weak, nonatomic, readwrite) UILabel *textLabel;
+
+@end
+
+
+
+@implementation JSQMessagesDayHeaderView
+
+#pragma mark - Class methods
+
++ (NSString *)headerReuseIdentifier
+{
+    return NSStringFromClass([JSQMessagesDayHeaderView class]);
+}
+
+#pragma mark - Initialization
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        self.backgroundColor = [UIColor clearColor];
+        
+        UILabel *textLabel = [[UILabel alloc] initWithFrame:self.bounds];
+        textLabel.textAlignment = NSTextAlignmentCenter;
+        textLabel.backgroundColor = [UIColor clearColor];
+        [self addSubview:textLabel];
+        _textLabel = textLabel;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    _accessoryView = nil;
+}
+
+#pragma mark - Setters
+
+- (void)setAccessoryView:(UIView *)accessoryView
+{
+    if (_accessoryView == accessoryView) {
+        return;
+    }
+    
+    //  the view may have been moved to another header since
+    if (_accessoryView.superview == self) {
+        [_accessoryView removeFromSuperview];
+    }
+    
+    _accessoryView = accessoryView;
+    
+    if (accessoryView != nil) {
+        [self addSubview:accessoryView];
+    }
+    
+    [self setNeedsLayout];
+}
+
+#pragma mark - Layout
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    
+    if (self.accessoryView == nil) {
+        self.textLabel.frame = self.bounds;
+        return;
+    }
+    
+    CGRect accessoryFrame = CGRectZero;
+    CGRect textFrame = CGRectZero;
+    CGRectDivide(self.bounds, &textFrame, &accessoryFrame, MIN(kJSQMessagesDayHeaderViewHeight, CGRectGetHeight(self.bounds)), CGRectMaxYEdge);
+    
+    self.accessoryView.frame = accessoryFrame;
+    self.textLabel.frame = textFrame;
+}
+
+#pragma mark - Reusable view
+
+- (void)prepareForReuse
+{
+    [super prepareForReuse];
+    self.textLabel.attributedText = nil;
+}
+
+@end
@@ -102,6 +102,8 @@
  *  Loads the content view for the toolbar.
  *
  *  @discussion Override this method to provide a custom content view for the toolbar.
+ *  The default implementation loads the content view from its nib if the toolbar was loaded from a nib,
+ *  and builds it in code if the toolbar was initialized with `initWithFrame:`.
  *
  *  @return An initialized `JSQMessagesToolbarContentView` if successful, otherwise `nil`.
  */
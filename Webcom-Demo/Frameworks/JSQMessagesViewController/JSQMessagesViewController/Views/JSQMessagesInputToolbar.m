@@ -33,6 +33,10 @@ static void * kJSQMessagesInputToolbarKeyValueObservingContext = &kJSQMessagesIn
 
 @property (assign, nonatomic) BOOL jsq_isObserving;
 
+@property (assign, nonatomic) BOOL jsq_usesManualLayout;
+
+- (void)jsq_configureInputToolbar;
+
 - (void)jsq_leftBarButtonPressed:(UIButton *)sender;
 - (void)jsq_rightBarButtonPressed:(UIButton *)sender;
 
@@ -49,11 +53,8 @@ static void * kJSQMessagesInputToolbarKeyValueObservingContext = &kJSQMessagesIn
 
 #pragma mark - Initialization
 
-- (void)awakeFromNib
+- (void)jsq_configureInputToolbar
 {
-    [super awakeFromNib];
-    [self setTranslatesAutoresizingMaskIntoConstraints:NO];
-
     self.jsq_isObserving = NO;
     self.sendButtonOnRight = YES;
 
@@ -61,10 +62,19 @@ static void * kJSQMessagesInputToolbarKeyValueObservingContext = &kJSQMessagesIn
     self.maximumHeight = NSNotFound;
 
     JSQMessagesToolbarContentView *toolbarContentView = [self loadToolbarContentView];
-    toolbarContentView.frame = self.frame;
     [self addSubview:toolbarContentView];
-    [self jsq_pinAllEdgesOfSubview:toolbarContentView];
-    [self setNeedsUpdateConstraints];
+
+    if (self.jsq_usesManualLayout) {
+        [toolbarContentView setTranslatesAutoresizingMaskIntoConstraints:YES];
+        toolbarContentView.frame = self.bounds;
+        toolbarContentView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    }
+    else {
+        toolbarContentView.frame = self.frame;
+        [self jsq_pinAllEdgesOfSubview:toolbarContentView];
+        [self setNeedsUpdateConstraints];
+    }
+
     _contentView = toolbarContentView;
 
     [self jsq_addObservers];
@@ -75,8 +85,29 @@ static void * kJSQMessagesInputToolbarKeyValueObservingContext = &kJSQMessagesIn
     [self toggleSendButtonEnabled];
 }
 
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        _jsq_usesManualLayout = YES;
+        [self jsq_configureInputToolbar];
+    }
+    return self;
+}
+
+- (void)awakeFromNib
+{
+    [super awakeFromNib];
+    [self setTranslatesAutoresizingMaskIntoConstraints:NO];
+    [self jsq_configureInputToolbar];
+}
+
 - (JSQMessagesToolbarContentView *)loadToolbarContentView
 {
+    if (self.jsq_usesManualLayout) {
+        return [[JSQMessagesToolbarContentView alloc] initWithFrame:self.bounds];
+    }
+
     NSArray *nibViews = [[NSBundle bundleForClass:[JSQMessagesInputToolbar class]] loadNibNamed:NSStringFromClass([JSQMessagesToolbarContentView class])
                                                                                           owner:nil
                                                                                         options:nil];
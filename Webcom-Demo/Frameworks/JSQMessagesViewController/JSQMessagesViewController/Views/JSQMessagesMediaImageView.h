@@ -0,0 +1,35 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  A `JSQMessagesMediaImageView` is an image view that reports when it enters or leaves a window.
+ *  Media items use it to load their images only while a cell displays them, and to release
+ *  their bitmaps once the cell is reused.
+ */
+@interface JSQMessagesMediaImageView : UIImageView
+
+/**
+ *  A block called each time the view enters or leaves a window. Check the `window` property of the view
+ *  to tell both cases apart. The default value is `nil`.
+ */
+@property (copy, nonatomic) void (^windowHandler)(JSQMessagesMediaImageView *imageView);
+
+@end
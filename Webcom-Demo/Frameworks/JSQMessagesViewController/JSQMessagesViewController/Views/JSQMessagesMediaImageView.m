@@ -0,0 +1,43 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import "JSQMessagesMediaImageView.h"
+
+
+@implementation JSQMessagesMediaImageView
+
+#pragma mark - Lifecycle
+
+- (void)dealloc
+{
+    _windowHandler = nil;
+}
+
+#pragma mark - UIView overrides
+
+- (void)didMoveToWindow
+{
+    [super didMoveToWindow];
+    
+    if (self.windowHandler) {
+        self.windowHandler(self);
+    }
+}
+
+@end
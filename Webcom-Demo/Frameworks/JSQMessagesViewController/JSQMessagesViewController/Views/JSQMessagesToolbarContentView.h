@@ -31,6 +31,8 @@ FOUNDATION_EXPORT const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingD
  *  A `JSQMessagesToolbarContentView` represents the content displayed in a `JSQMessagesInputToolbar`.
  *  These subviews consist of a left button, a text view, and a right button. One button is used as
  *  the send button, and the other as the accessory button. The text view is used for composing messages.
+ *
+ *  A content view initialized with `initWithFrame:` builds its subviews in code and lays them out by frame.
  */
 @interface JSQMessagesToolbarContentView : UIView
 
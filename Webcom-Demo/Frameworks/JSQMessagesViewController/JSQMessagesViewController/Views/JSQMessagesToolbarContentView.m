@@ -22,6 +22,13 @@
 
 const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
 
+static const CGFloat kJSQMessagesToolbarContentViewLeftBarButtonWidthDefault = 34.0f;
+static const CGFloat kJSQMessagesToolbarContentViewRightBarButtonWidthDefault = 50.0f;
+static const CGFloat kJSQMessagesToolbarContentViewBarButtonHeight = 32.0f;
+static const CGFloat kJSQMessagesToolbarContentViewBarButtonBottomSpacing = 6.0f;
+static const CGFloat kJSQMessagesToolbarContentViewTextViewVerticalSpacing = 7.0f;
+static const CGFloat kJSQMessagesToolbarContentViewTextViewHorizontalSpacing = 8.0f;
+
 
 @interface JSQMessagesToolbarContentView ()
 
@@ -36,6 +43,12 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
 @property (weak, nonatomic) IBOutlet NSLayoutConstraint *leftHorizontalSpacingConstraint;
 @property (weak, nonatomic) IBOutlet NSLayoutConstraint *rightHorizontalSpacingConstraint;
 
+@property (assign, nonatomic) BOOL jsq_usesManualLayout;
+
+- (void)jsq_configureToolbarContentView;
+- (void)jsq_loadSubviews;
+- (void)jsq_addBarButtonItem:(UIButton *)barButtonItem toContainerView:(UIView *)containerView;
+
 @end
 
 
@@ -52,16 +65,63 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
 
 #pragma mark - Initialization
 
+- (void)jsq_configureToolbarContentView
+{
+    self.leftContentPadding = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
+    self.rightContentPadding = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
+
+    self.backgroundColor = [UIColor clearColor];
+}
+
+- (void)jsq_loadSubviews
+{
+    //  mirrors the view hierarchy of the nib, laid out by frame in `layoutSubviews`
+    UIView *leftBarButtonContainerView = [[UIView alloc] initWithFrame:CGRectMake(0.0f,
+                                                                                  0.0f,
+                                                                                  kJSQMessagesToolbarContentViewLeftBarButtonWidthDefault,
+                                                                                  kJSQMessagesToolbarContentViewBarButtonHeight)];
+
+    UIView *rightBarButtonContainerView = [[UIView alloc] initWithFrame:CGRectMake(0.0f,
+                                                                                   0.0f,
+                                                                                   kJSQMessagesToolbarContentViewRightBarButtonWidthDefault,
+                                                                                   kJSQMessagesToolbarContentViewBarButtonHeight)];
+
+    JSQMessagesComposerTextView *textView = [[JSQMessagesComposerTextView alloc] initWithFrame:CGRectZero textContainer:nil];
+    [textView setTranslatesAutoresizingMaskIntoConstraints:YES];
+
+    [self addSubview:leftBarButtonContainerView];
+    [self addSubview:rightBarButtonContainerView];
+    [self addSubview:textView];
+
+    self.leftBarButtonContainerView = leftBarButtonContainerView;
+    self.rightBarButtonContainerView = rightBarButtonContainerView;
+    self.textView = textView;
+
+    _leftBarButtonItemWidth = CGRectGetWidth(leftBarButtonContainerView.frame);
+    _rightBarButtonItemWidth = CGRectGetWidth(rightBarButtonContainerView.frame);
+}
+
+- (instancetype)initWithFrame:(CGRect)frame
+{
+    self = [super initWithFrame:frame];
+    if (self) {
+        _jsq_usesManualLayout = YES;
+        [self jsq_loadSubviews];
+        [self jsq_configureToolbarContentView];
+    }
+    return self;
+}
+
 - (void)awakeFromNib
 {
     [super awakeFromNib];
 
     [self setTranslatesAutoresizingMaskIntoConstraints:NO];
 
-    self.leftHorizontalSpacingConstraint.constant = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
-    self.rightHorizontalSpacingConstraint.constant = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
+    _leftBarButtonItemWidth = self.leftBarButtonContainerViewWidthConstraint.constant;
+    _rightBarButtonItemWidth = self.rightBarButtonContainerViewWidthConstraint.constant;
 
-    self.backgroundColor = [UIColor clearColor];
+    [self jsq_configureToolbarContentView];
 }
 
 - (void)dealloc
@@ -90,7 +150,7 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
 
     if (!leftBarButtonItem) {
         _leftBarButtonItem = nil;
-        self.leftHorizontalSpacingConstraint.constant = 0.0f;
+        self.leftContentPadding = 0.0f;
         self.leftBarButtonItemWidth = 0.0f;
         self.leftBarButtonContainerView.hidden = YES;
         return;
@@ -101,22 +161,20 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
     }
 
     self.leftBarButtonContainerView.hidden = NO;
-    self.leftHorizontalSpacingConstraint.constant = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
+    self.leftContentPadding = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
     self.leftBarButtonItemWidth = CGRectGetWidth(leftBarButtonItem.frame);
 
-    [leftBarButtonItem setTranslatesAutoresizingMaskIntoConstraints:NO];
-
-    [self.leftBarButtonContainerView addSubview:leftBarButtonItem];
-    [self.leftBarButtonContainerView jsq_pinAllEdgesOfSubview:leftBarButtonItem];
-    [self setNeedsUpdateConstraints];
+    [self jsq_addBarButtonItem:leftBarButtonItem toContainerView:self.leftBarButtonContainerView];
 
     _leftBarButtonItem = leftBarButtonItem;
 }
 
 - (void)setLeftBarButtonItemWidth:(CGFloat)leftBarButtonItemWidth
 {
+    _leftBarButtonItemWidth = leftBarButtonItemWidth;
     self.leftBarButtonContainerViewWidthConstraint.constant = leftBarButtonItemWidth;
     [self setNeedsUpdateConstraints];
+    [self setNeedsLayout];
 }
 
 - (void)setRightBarButtonItem:(UIButton *)rightBarButtonItem
@@ -127,7 +185,7 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
 
     if (!rightBarButtonItem) {
         _rightBarButtonItem = nil;
-        self.rightHorizontalSpacingConstraint.constant = 0.0f;
+        self.rightContentPadding = 0.0f;
         self.rightBarButtonItemWidth = 0.0f;
         self.rightBarButtonContainerView.hidden = YES;
         return;
@@ -138,59 +196,89 @@ const CGFloat kJSQMessagesToolbarContentViewHorizontalSpacingDefault = 8.0f;
     }
 
     self.rightBarButtonContainerView.hidden = NO;
-    self.rightHorizontalSpacingConstraint.constant = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
+    self.rightContentPadding = kJSQMessagesToolbarContentViewHorizontalSpacingDefault;
     self.rightBarButtonItemWidth = CGRectGetWidth(rightBarButtonItem.frame);
 
-    [rightBarButtonItem setTranslatesAutoresizingMaskIntoConstraints:NO];
-
-    [self.rightBarButtonContainerView addSubview:rightBarButtonItem];
-    [self.rightBarButtonContainerView jsq_pinAllEdgesOfSubview:rightBarButtonItem];
-    [self setNeedsUpdateConstraints];
+    [self jsq_addBarButtonItem:rightBarButtonItem toContainerView:self.rightBarButtonContainerView];
 
     _rightBarButtonItem = rightBarButtonItem;
 }
 
 - (void)setRightBarButtonItemWidth:(CGFloat)rightBarButtonItemWidth
 {
+    _rightBarButtonItemWidth = rightBarButtonItemWidth;
     self.rightBarButtonContainerViewWidthConstraint.constant = rightBarButtonItemWidth;
     [self setNeedsUpdateConstraints];
+    [self setNeedsLayout];
 }
 
 - (void)setRightContentPadding:(CGFloat)rightContentPadding
 {
+    _rightContentPadding = rightContentPadding;
     self.rightHorizontalSpacingConstraint.constant = rightContentPadding;
     [self setNeedsUpdateConstraints];
+    [self setNeedsLayout];
 }
 
 - (void)setLeftContentPadding:(CGFloat)leftContentPadding
 {
+    _leftContentPadding = leftContentPadding;
     self.leftHorizontalSpacingConstraint.constant = leftContentPadding;
     [self setNeedsUpdateConstraints];
+    [self setNeedsLayout];
 }
 
-#pragma mark - Getters
+#pragma mark - Utilities
 
-- (CGFloat)leftBarButtonItemWidth
+- (void)jsq_addBarButtonItem:(UIButton *)barButtonItem toContainerView:(UIView *)containerView
 {
-    return self.leftBarButtonContainerViewWidthConstraint.constant;
-}
+    [containerView addSubview:barButtonItem];
 
-- (CGFloat)rightBarButtonItemWidth
-{
-    return self.rightBarButtonContainerViewWidthConstraint.constant;
+    if (self.jsq_usesManualLayout) {
+        [barButtonItem setTranslatesAutoresizingMaskIntoConstraints:YES];
+        [self setNeedsLayout];
+    }
+    else {
+        [barButtonItem setTranslatesAutoresizingMaskIntoConstraints:NO];
+        [containerView jsq_pinAllEdgesOfSubview:barButtonItem];
+        [self setNeedsUpdateConstraints];
+    }
 }
 
-- (CGFloat)rightContentPadding
-{
-    return self.rightHorizontalSpacingConstraint.constant;
-}
+#pragma mark - UIView overrides
 
-- (CGFloat)leftContentPadding
+- (void)layoutSubviews
 {
-    return self.leftHorizontalSpacingConstraint.constant;
-}
+    [super layoutSubviews];
 
-#pragma mark - UIView overrides
+    if (!self.jsq_usesManualLayout) {
+        return;
+    }
+
+    CGRect bounds = self.bounds;
+    CGFloat barButtonMinY = CGRectGetHeight(bounds) - kJSQMessagesToolbarContentViewBarButtonBottomSpacing - kJSQMessagesToolbarContentViewBarButtonHeight;
+
+    self.leftBarButtonContainerView.frame = CGRectMake(self.leftContentPadding,
+                                                       barButtonMinY,
+                                                       self.leftBarButtonItemWidth,
+                                                       kJSQMessagesToolbarContentViewBarButtonHeight);
+
+    self.rightBarButtonContainerView.frame = CGRectMake(CGRectGetWidth(bounds) - self.rightContentPadding - self.rightBarButtonItemWidth,
+                                                        barButtonMinY,
+                                                        self.rightBarButtonItemWidth,
+                                                        kJSQMessagesToolbarContentViewBarButtonHeight);
+
+    self.leftBarButtonItem.frame = self.leftBarButtonContainerView.bounds;
+    self.rightBarButtonItem.frame = self.rightBarButtonContainerView.bounds;
+
+    CGFloat textViewMinX = CGRectGetMaxX(self.leftBarButtonContainerView.frame) + kJSQMessagesToolbarContentViewTextViewHorizontalSpacing;
+    CGFloat textViewMaxX = CGRectGetMinX(self.rightBarButtonContainerView.frame) - kJSQMessagesToolbarContentViewTextViewHorizontalSpacing;
+
+    self.textView.frame = CGRectMake(textViewMinX,
+                                     kJSQMessagesToolbarContentViewTextViewVerticalSpacing,
+                                     MAX(textViewMaxX - textViewMinX, 0.0f),
+                                     MAX(CGRectGetHeight(bounds) - 2.0f * kJSQMessagesToolbarContentViewTextViewVerticalSpacing, 0.0f));
+}
 
 - (void)setNeedsDisplay
 {
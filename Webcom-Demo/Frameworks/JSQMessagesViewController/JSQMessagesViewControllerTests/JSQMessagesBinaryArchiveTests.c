@@ -0,0 +1,679 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+
+//  Portable tests and throughput check for the binary archive codec, they do not need Foundation nor Xcode.
+//
+//  From this directory:
+//
+//      cc -std=c99 -O2 -Wall -Wextra -I ../JSQMessagesViewController/Model
+//          JSQMessagesBinaryArchiveTests.c ../JSQMessagesViewController/Model/JSQMessagesBinaryArchiveCodec.c
+//          -o JSQMessagesBinaryArchiveTests && ./JSQMessagesBinaryArchiveTests
+//
+//  Add -DJSQ_BINARY_ARCHIVE_BENCHMARK_ONLY to skip the tests.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "JSQMessagesBinaryArchiveCodec.h"
+
+
+static int jsq_failureCount = 0;
+
+#define JSQAssert(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            jsq_failureCount++; \
+            fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+        } \
+    } while (0)
+
+
+static uint32_t jsq_randomState = 0x9e3779b9u;
+
+static uint32_t jsq_random(void)
+{
+    //  xorshift32, so that runs are reproducible
+    jsq_randomState ^= jsq_randomState << 13;
+    jsq_randomState ^= jsq_randomState >> 17;
+    jsq_randomState ^= jsq_randomState << 5;
+    return jsq_randomState;
+}
+
+static double jsq_now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+static JSQMessagesBinaryReader jsq_readerForWriter(const JSQMessagesBinaryWriter *writer)
+{
+    JSQMessagesBinaryReader reader = { writer->bytes, writer->length, 0 };
+    return reader;
+}
+
+static int jsq_rangesEqual(const uint8_t *bytes1, size_t length1, const uint8_t *bytes2, size_t length2)
+{
+    return length1 == length2 && (length1 == 0 || memcmp(bytes1, bytes2, length1) == 0);
+}
+
+static int jsq_recordsEqual(const JSQMessagesBinaryRecord *record1, const JSQMessagesBinaryRecord *record2)
+{
+    if (record1->senderIndex != record2->senderIndex
+        || record1->encodedDateDelta != record2->encodedDateDelta
+        || record1->type != record2->type) {
+        return 0;
+    }
+
+    if (record1->type == JSQMessagesBinaryArchiveTypeText) {
+        return jsq_rangesEqual(record1->string, record1->stringLength, record2->string, record2->stringLength);
+    }
+
+    return record1->mediaFlags == record2->mediaFlags
+        && jsq_rangesEqual(record1->string, record1->stringLength, record2->string, record2->stringLength)
+        && jsq_rangesEqual(record1->payload, record1->payloadLength, record2->payload, record2->payloadLength)
+        && record1->latitudeBits == record2->latitudeBits
+        && record1->longitudeBits == record2->longitudeBits;
+}
+
+
+//  MARK: - Fixtures
+
+static const uint8_t kJSQImageBytes[] = { 0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d };
+
+//  one record of each type, with the fields the archive writes for it
+static size_t jsq_makeRecords(JSQMessagesBinaryRecord *records)
+{
+    static const char text[] = "Hello, wörld \xf0\x9f\x91\x8b";
+    static const char textWithNul[] = { 'a', '\0', 'b' };
+    static const char imageURL[] = "https://example.com/image.png";
+    static const char videoURL[] = "file:///tmp/video.mp4";
+
+    size_t count = 0;
+    memset(records, 0, 8 * sizeof(*records));
+
+    records[count].senderIndex = 0;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(0);
+    records[count].type = JSQMessagesBinaryArchiveTypeText;
+    records[count].string = (const uint8_t *)text;
+    records[count].stringLength = sizeof(text) - 1;
+    count++;
+
+    records[count].senderIndex = 1;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(-12345);
+    records[count].type = JSQMessagesBinaryArchiveTypeText;
+    records[count].string = (const uint8_t *)textWithNul;
+    records[count].stringLength = sizeof(textWithNul);
+    count++;
+
+    records[count].senderIndex = 2;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(1);
+    records[count].type = JSQMessagesBinaryArchiveTypeText;
+    count++;
+
+    records[count].senderIndex = 300;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(INT64_MAX);
+    records[count].type = JSQMessagesBinaryArchiveTypePhoto;
+    records[count].mediaFlags = JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing;
+    records[count].string = (const uint8_t *)imageURL;
+    records[count].stringLength = sizeof(imageURL) - 1;
+    count++;
+
+    records[count].senderIndex = 3;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(INT64_MIN);
+    records[count].type = JSQMessagesBinaryArchiveTypePhoto;
+    records[count].payload = kJSQImageBytes;
+    records[count].payloadLength = sizeof(kJSQImageBytes);
+    count++;
+
+    records[count].senderIndex = 4;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(42);
+    records[count].type = JSQMessagesBinaryArchiveTypeLocation;
+    records[count].mediaFlags = JSQMessagesBinaryArchiveMediaFlagsHasContent;
+    records[count].latitudeBits = JSQMessagesBinaryBitsOfDouble(48.8566);
+    records[count].longitudeBits = JSQMessagesBinaryBitsOfDouble(-2.3522);
+    count++;
+
+    records[count].senderIndex = 5;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(-1);
+    records[count].type = JSQMessagesBinaryArchiveTypeVideo;
+    records[count].mediaFlags = JSQMessagesBinaryArchiveMediaFlagsReadyToPlay | JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing;
+    records[count].string = (const uint8_t *)videoURL;
+    records[count].stringLength = sizeof(videoURL) - 1;
+    count++;
+
+    records[count].senderIndex = 6;
+    records[count].encodedDateDelta = JSQMessagesBinaryZigzagEncode(7);
+    records[count].type = JSQMessagesBinaryArchiveTypeOtherMedia;
+    records[count].mediaFlags = JSQMessagesBinaryArchiveMediaFlagsMaskAsOutgoing;
+    count++;
+
+    return count;
+}
+
+
+//  MARK: - Tests
+
+static void jsq_testVarints(void)
+{
+    static const uint64_t values[] = {
+        0, 1, 127, 128, 255, 300, 16383, 16384, 2097151, 2097152,
+        UINT32_MAX, (uint64_t)UINT32_MAX + 1, UINT64_MAX / 2, UINT64_MAX - 1, UINT64_MAX
+    };
+    static const size_t lengths[] = { 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 5, 5, 9, 10, 10 };
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        JSQMessagesBinaryWriter writer;
+        JSQMessagesBinaryWriterInit(&writer, 0);
+        JSQMessagesBinaryWriteVarint(&writer, values[i]);
+
+        JSQAssert(writer.length == lengths[i], "varint %llu: %zu bytes, expected %zu",
+                  (unsigned long long)values[i], writer.length, lengths[i]);
+
+        JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+        uint64_t value = 0;
+        JSQAssert(JSQMessagesBinaryReadVarint(&reader, &value) && value == values[i] && reader.offset == writer.length,
+                  "varint %llu does not round-trip", (unsigned long long)values[i]);
+
+        //  every shorter prefix is a truncated varint
+        for (size_t length = 0; length < writer.length; length++) {
+            JSQMessagesBinaryReader truncatedReader = { writer.bytes, length, 0 };
+            JSQAssert(!JSQMessagesBinaryReadVarint(&truncatedReader, &value),
+                      "varint %llu truncated to %zu bytes is accepted", (unsigned long long)values[i], length);
+        }
+
+        free(writer.bytes);
+    }
+
+    //  a varint cannot be longer than 10 bytes
+    uint8_t overlong[11];
+    memset(overlong, 0x80, sizeof(overlong));
+    overlong[10] = 0x00;
+
+    JSQMessagesBinaryReader reader = { overlong, sizeof(overlong), 0 };
+    uint64_t value = 0;
+    JSQAssert(!JSQMessagesBinaryReadVarint(&reader, &value), "an 11 byte varint is accepted");
+}
+
+static void jsq_testZigzag(void)
+{
+    static const struct {
+        int64_t value;
+        uint64_t encoded;
+    } cases[] = {
+        { 0, 0 }, { -1, 1 }, { 1, 2 }, { -2, 3 }, { 2, 4 },
+        { INT64_MAX, UINT64_MAX - 1 }, { INT64_MIN, UINT64_MAX }
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        JSQAssert(JSQMessagesBinaryZigzagEncode(cases[i].value) == cases[i].encoded,
+                  "zigzag of %lld is %llu", (long long)cases[i].value, (unsigned long long)JSQMessagesBinaryZigzagEncode(cases[i].value));
+        JSQAssert(JSQMessagesBinaryZigzagDecode(cases[i].encoded) == cases[i].value,
+                  "zigzag %llu decodes to %lld", (unsigned long long)cases[i].encoded, (long long)JSQMessagesBinaryZigzagDecode(cases[i].encoded));
+    }
+
+    for (int i = 0; i < 100000; i++) {
+        int64_t value = (int64_t)(((uint64_t)jsq_random() << 32) | jsq_random());
+        JSQAssert(JSQMessagesBinaryZigzagDecode(JSQMessagesBinaryZigzagEncode(value)) == value,
+                  "zigzag of %lld does not round-trip", (long long)value);
+    }
+}
+
+static void jsq_testDates(void)
+{
+    //  dates are written as differences of bit patterns, which must round-trip exactly, going back in time too
+    static const double timeIntervals[] = {
+        0.0, -0.0, 480000000.123456, 480000000.123457, 480000001.0, 1.0, -978307200.0, 1e300, 5e-324, 480000000.5
+    };
+
+    JSQMessagesBinaryWriter writer;
+    JSQMessagesBinaryWriterInit(&writer, 0);
+
+    uint64_t previousBits = 0;
+    for (size_t i = 0; i < sizeof(timeIntervals) / sizeof(timeIntervals[0]); i++) {
+        uint64_t bits = JSQMessagesBinaryBitsOfDouble(timeIntervals[i]);
+        JSQMessagesBinaryWriteVarint(&writer, JSQMessagesBinaryZigzagEncode((int64_t)(bits - previousBits)));
+        previousBits = bits;
+    }
+
+    JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+    uint64_t bits = 0;
+
+    for (size_t i = 0; i < sizeof(timeIntervals) / sizeof(timeIntervals[0]); i++) {
+        uint64_t encodedDelta = 0;
+        JSQAssert(JSQMessagesBinaryReadVarint(&reader, &encodedDelta), "date %zu cannot be read", i);
+
+        bits += (uint64_t)JSQMessagesBinaryZigzagDecode(encodedDelta);
+        JSQAssert(bits == JSQMessagesBinaryBitsOfDouble(timeIntervals[i]), "date %zu is %.17g, expected %.17g",
+                  i, JSQMessagesBinaryDoubleWithBits(bits), timeIntervals[i]);
+    }
+
+    //  messages sent a second apart take a few bytes each
+    JSQMessagesBinaryWriter closeDates;
+    JSQMessagesBinaryWriterInit(&closeDates, 0);
+
+    uint64_t delta = JSQMessagesBinaryBitsOfDouble(480000001.0) - JSQMessagesBinaryBitsOfDouble(480000000.0);
+    JSQMessagesBinaryWriteVarint(&closeDates, JSQMessagesBinaryZigzagEncode((int64_t)delta));
+    JSQAssert(closeDates.length <= 6, "a one second delta takes %zu bytes", closeDates.length);
+
+    free(writer.bytes);
+    free(closeDates.bytes);
+}
+
+static void jsq_testRecordRoundTrip(void)
+{
+    JSQMessagesBinaryRecord records[8];
+    size_t count = jsq_makeRecords(records);
+
+    JSQMessagesBinaryWriter writer;
+    JSQMessagesBinaryWriterInit(&writer, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        JSQMessagesBinaryWriteRecord(&writer, &records[i]);
+    }
+
+    JSQAssert(!writer.failed, "writing records failed");
+
+    JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+
+    for (size_t i = 0; i < count; i++) {
+        JSQMessagesBinaryRecord record;
+        JSQAssert(JSQMessagesBinaryReadRecord(&reader, &record), "record %zu of type %u cannot be read", i, records[i].type);
+        JSQAssert(jsq_recordsEqual(&record, &records[i]), "record %zu of type %u does not round-trip", i, records[i].type);
+
+        //  nothing is copied, byte ranges point into the archive
+        if (record.stringLength > 0) {
+            JSQAssert(record.string >= writer.bytes && record.string + record.stringLength <= writer.bytes + writer.length,
+                      "record %zu does not point into the archive", i);
+        }
+    }
+
+    JSQAssert(reader.offset == writer.length, "%zu bytes left after the last record", writer.length - reader.offset);
+
+    JSQMessagesBinaryRecord record;
+    JSQAssert(!JSQMessagesBinaryReadRecord(&reader, &record), "a record is read past the end of the archive");
+
+    free(writer.bytes);
+}
+
+static void jsq_testTruncatedRecords(void)
+{
+    JSQMessagesBinaryRecord records[8];
+    size_t count = jsq_makeRecords(records);
+
+    for (size_t i = 0; i < count; i++) {
+        JSQMessagesBinaryWriter writer;
+        JSQMessagesBinaryWriterInit(&writer, 0);
+        JSQMessagesBinaryWriteRecord(&writer, &records[i]);
+
+        for (size_t length = 0; length < writer.length; length++) {
+            JSQMessagesBinaryReader reader = { writer.bytes, length, 0 };
+            JSQMessagesBinaryRecord record;
+            JSQAssert(!JSQMessagesBinaryReadRecord(&reader, &record),
+                      "record %zu of type %u truncated to %zu of %zu bytes is accepted", i, records[i].type, length, writer.length);
+        }
+
+        free(writer.bytes);
+    }
+}
+
+static void jsq_testCorruptRecords(void)
+{
+    JSQMessagesBinaryRecord record;
+
+    //  sender 0, date delta 0, unknown type 7
+    static const uint8_t unknownType[] = { 0x00, 0x00, 0x07, 0x00 };
+    JSQMessagesBinaryReader reader = { unknownType, sizeof(unknownType), 0 };
+    JSQAssert(!JSQMessagesBinaryReadRecord(&reader, &record), "a record of unknown type is accepted");
+
+    //  a text whose length runs past the end of the archive
+    static const uint8_t overrunningText[] = { 0x00, 0x00, JSQMessagesBinaryArchiveTypeText, 0x05, 'a', 'b' };
+    reader = (JSQMessagesBinaryReader){ overrunningText, sizeof(overrunningText), 0 };
+    JSQAssert(!JSQMessagesBinaryReadRecord(&reader, &record), "a text running past the archive is accepted");
+
+    //  a length that would wrap around the address space
+    static const uint8_t hugeLength[] = { 0x00, 0x00, JSQMessagesBinaryArchiveTypeText, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 'a' };
+    reader = (JSQMessagesBinaryReader){ hugeLength, sizeof(hugeLength), 0 };
+    JSQAssert(!JSQMessagesBinaryReadRecord(&reader, &record), "a text of 2^64 - 1 bytes is accepted");
+
+    //  random bytes must never be read out of bounds, whatever they decode to
+    uint8_t noise[64];
+    for (int iteration = 0; iteration < 100000; iteration++) {
+        size_t length = jsq_random() % sizeof(noise);
+        for (size_t i = 0; i < length; i++) {
+            noise[i] = (uint8_t)jsq_random();
+        }
+
+        reader = (JSQMessagesBinaryReader){ noise, length, 0 };
+        while (reader.offset < reader.length && JSQMessagesBinaryReadRecord(&reader, &record)) {
+            JSQAssert(reader.offset <= reader.length, "reading noise went past the end");
+            JSQAssert(record.stringLength == 0 || (record.string >= noise && record.string + record.stringLength <= noise + length),
+                      "a record read from noise points outside of it");
+            JSQAssert(record.payloadLength == 0 || (record.payload >= noise && record.payload + record.payloadLength <= noise + length),
+                      "a record read from noise points outside of it");
+        }
+    }
+}
+
+static void jsq_testHeader(void)
+{
+    JSQMessagesBinaryWriter writer;
+    JSQMessagesBinaryWriterInit(&writer, 0);
+    JSQMessagesBinaryWriteHeader(&writer, 1);
+
+    JSQAssert(writer.length == 5 && memcmp(writer.bytes, "JSQM\x01", 5) == 0, "unexpected header bytes");
+
+    JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+    JSQAssert(JSQMessagesBinaryReadHeader(&reader, 1) && reader.offset == 5, "the header of version 1 cannot be read");
+
+    //  version mismatch, in both directions
+    reader = jsq_readerForWriter(&writer);
+    JSQAssert(!JSQMessagesBinaryReadHeader(&reader, 2), "an archive of version 1 is read as version 2");
+
+    writer.bytes[4] = 2;
+    reader = jsq_readerForWriter(&writer);
+    JSQAssert(!JSQMessagesBinaryReadHeader(&reader, 1), "an archive of version 2 is read as version 1");
+
+    //  bad magic number
+    writer.bytes[4] = 1;
+    writer.bytes[0] = 'X';
+    reader = jsq_readerForWriter(&writer);
+    JSQAssert(!JSQMessagesBinaryReadHeader(&reader, 1), "an archive with a bad magic number is accepted");
+
+    //  truncated header
+    writer.bytes[0] = 'J';
+    for (size_t length = 0; length < 5; length++) {
+        JSQMessagesBinaryReader truncatedReader = { writer.bytes, length, 0 };
+        JSQAssert(!JSQMessagesBinaryReadHeader(&truncatedReader, 1), "a header truncated to %zu bytes is accepted", length);
+    }
+
+    free(writer.bytes);
+}
+
+static void jsq_testArchiveRoundTrip(void)
+{
+    //  the layout written by JSQMessagesBinaryArchive: header, sender table, then the records
+    static const char *senders[][2] = { { "jsq", "Jesse" }, { "cook", "Tim" }, { "", "" } };
+    enum { kSenderCount = 3, kMessageCount = 1000 };
+
+    JSQMessagesBinaryWriter writer;
+    JSQMessagesBinaryWriterInit(&writer, 0);
+    JSQMessagesBinaryWriteHeader(&writer, 1);
+    JSQMessagesBinaryWriteVarint(&writer, kSenderCount);
+
+    for (size_t i = 0; i < kSenderCount; i++) {
+        JSQMessagesBinaryWriteBytes(&writer, senders[i][0], strlen(senders[i][0]));
+        JSQMessagesBinaryWriteBytes(&writer, senders[i][1], strlen(senders[i][1]));
+    }
+
+    JSQMessagesBinaryWriteVarint(&writer, kMessageCount);
+
+    static char texts[kMessageCount][32];
+    double timeIntervals[kMessageCount];
+    uint64_t previousBits = 0;
+
+    for (size_t i = 0; i < kMessageCount; i++) {
+        snprintf(texts[i], sizeof(texts[i]), "message %zu", i);
+        timeIntervals[i] = 480000000.0 + (double)i * 1.5 - (i % 7 == 0 ? 100.0 : 0.0);
+
+        uint64_t bits = JSQMessagesBinaryBitsOfDouble(timeIntervals[i]);
+
+        JSQMessagesBinaryRecord record;
+        memset(&record, 0, sizeof(record));
+        record.senderIndex = i % kSenderCount;
+        record.encodedDateDelta = JSQMessagesBinaryZigzagEncode((int64_t)(bits - previousBits));
+        record.type = JSQMessagesBinaryArchiveTypeText;
+        record.string = (const uint8_t *)texts[i];
+        record.stringLength = strlen(texts[i]);
+        JSQMessagesBinaryWriteRecord(&writer, &record);
+
+        previousBits = bits;
+    }
+
+    JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+    uint64_t senderCount = 0;
+
+    JSQAssert(JSQMessagesBinaryReadHeader(&reader, 1), "the archive header cannot be read");
+    JSQAssert(JSQMessagesBinaryReadVarint(&reader, &senderCount) && senderCount == kSenderCount, "unexpected sender count");
+
+    for (size_t i = 0; i < kSenderCount; i++) {
+        const uint8_t *senderId = NULL;
+        const uint8_t *displayName = NULL;
+        size_t senderIdLength = 0;
+        size_t displayNameLength = 0;
+
+        JSQAssert(JSQMessagesBinaryReadBytes(&reader, &senderId, &senderIdLength)
+                  && JSQMessagesBinaryReadBytes(&reader, &displayName, &displayNameLength)
+                  && jsq_rangesEqual(senderId, senderIdLength, (const uint8_t *)senders[i][0], strlen(senders[i][0]))
+                  && jsq_rangesEqual(displayName, displayNameLength, (const uint8_t *)senders[i][1], strlen(senders[i][1])),
+                  "sender %zu does not round-trip", i);
+    }
+
+    uint64_t messageCount = 0;
+    JSQAssert(JSQMessagesBinaryReadVarint(&reader, &messageCount) && messageCount == kMessageCount, "unexpected message count");
+
+    uint64_t bits = 0;
+    for (size_t i = 0; i < kMessageCount; i++) {
+        JSQMessagesBinaryRecord record;
+        if (!JSQMessagesBinaryReadRecord(&reader, &record)) {
+            JSQAssert(0, "message %zu cannot be read", i);
+            break;
+        }
+
+        bits += (uint64_t)JSQMessagesBinaryZigzagDecode(record.encodedDateDelta);
+
+        JSQAssert(record.senderIndex == i % kSenderCount, "message %zu has sender %llu", i, (unsigned long long)record.senderIndex);
+        JSQAssert(JSQMessagesBinaryDoubleWithBits(bits) == timeIntervals[i], "message %zu has the wrong date", i);
+        JSQAssert(jsq_rangesEqual(record.string, record.stringLength, (const uint8_t *)texts[i], strlen(texts[i])),
+                  "message %zu has the wrong text", i);
+    }
+
+    JSQAssert(reader.offset == reader.length, "%zu bytes left after the last message", reader.length - reader.offset);
+
+    free(writer.bytes);
+}
+
+
+static void jsq_testUTF8Validation(void)
+{
+    static const struct {
+        const char *bytes;
+        size_t length;
+        int isValid;
+    } cases[] = {
+        { "", 0, 1 },
+        { "hello", 5, 1 },
+        { "a\0b", 3, 1 },
+        { "w\xc3\xb6rld", 6, 1 },
+        { "\xe2\x82\xac", 3, 1 },
+        { "\xf0\x9f\x91\x8b", 4, 1 },
+        { "\xed\x9f\xbf", 3, 1 },
+        { "\xf4\x8f\xbf\xbf", 4, 1 },
+        { "\x80", 1, 0 },
+        { "\xbf", 1, 0 },
+        { "\xc0\xaf", 2, 0 },
+        { "\xc1\xbf", 2, 0 },
+        { "\xe0\x80\xaf", 3, 0 },
+        { "\xf0\x80\x80\xaf", 4, 0 },
+        { "\xed\xa0\x80", 3, 0 },
+        { "\xed\xbf\xbf", 3, 0 },
+        { "\xf4\x90\x80\x80", 4, 0 },
+        { "\xf5\x80\x80\x80", 4, 0 },
+        { "\xff", 1, 0 },
+        { "\xc3", 1, 0 },
+        { "\xe2\x82", 2, 0 },
+        { "\xf0\x9f\x91", 3, 0 },
+        { "\xe2\x28\xa1", 3, 0 },
+        { "ok\xc3\x28", 4, 0 },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        JSQAssert(JSQMessagesBinaryIsValidUTF8((const uint8_t *)cases[i].bytes, cases[i].length) == (bool)cases[i].isValid,
+                  "UTF-8 case %zu is %s", i, cases[i].isValid ? "rejected" : "accepted");
+    }
+
+    //  every code point outside of the surrogates round-trips through a hand-written encoder
+    for (uint32_t codePoint = 0; codePoint <= 0x10ffff; codePoint++) {
+        if (codePoint >= 0xd800 && codePoint <= 0xdfff) {
+            continue;
+        }
+
+        uint8_t bytes[4];
+        size_t length = 0;
+
+        if (codePoint < 0x80) {
+            bytes[length++] = (uint8_t)codePoint;
+        }
+        else if (codePoint < 0x800) {
+            bytes[length++] = (uint8_t)(0xc0 | (codePoint >> 6));
+            bytes[length++] = (uint8_t)(0x80 | (codePoint & 0x3f));
+        }
+        else if (codePoint < 0x10000) {
+            bytes[length++] = (uint8_t)(0xe0 | (codePoint >> 12));
+            bytes[length++] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3f));
+            bytes[length++] = (uint8_t)(0x80 | (codePoint & 0x3f));
+        }
+        else {
+            bytes[length++] = (uint8_t)(0xf0 | (codePoint >> 18));
+            bytes[length++] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3f));
+            bytes[length++] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3f));
+            bytes[length++] = (uint8_t)(0x80 | (codePoint & 0x3f));
+        }
+
+        if (!JSQMessagesBinaryIsValidUTF8(bytes, length)) {
+            JSQAssert(0, "U+%04X is rejected", (unsigned int)codePoint);
+            break;
+        }
+    }
+}
+
+
+//  MARK: - Throughput
+
+static void jsq_benchmark(void)
+{
+    //  a large room: short texts from a handful of senders, a few seconds apart
+    enum { kMessageCount = 1000000, kIterations = 5 };
+
+    static const char *texts[] = {
+        "ok",
+        "See you tomorrow at the station",
+        "Did you get the slides I sent this morning? The numbers on page 4 look off to me.",
+        "\xf0\x9f\x91\x8d",
+    };
+
+    JSQMessagesBinaryWriter writer;
+    double writeTime = 0.0;
+    double readTime = 0.0;
+    uint64_t checksum = 0;
+
+    for (int iteration = 0; iteration < kIterations; iteration++) {
+        double start = jsq_now();
+
+        JSQMessagesBinaryWriterInit(&writer, 0);
+        uint64_t previousBits = 0;
+
+        for (size_t i = 0; i < kMessageCount; i++) {
+            const char *text = texts[i % 4];
+            uint64_t bits = JSQMessagesBinaryBitsOfDouble(480000000.0 + (double)i * 3.0);
+
+            JSQMessagesBinaryRecord record;
+            memset(&record, 0, sizeof(record));
+            record.senderIndex = i % 5;
+            record.encodedDateDelta = JSQMessagesBinaryZigzagEncode((int64_t)(bits - previousBits));
+            record.type = JSQMessagesBinaryArchiveTypeText;
+            record.string = (const uint8_t *)text;
+            record.stringLength = strlen(text);
+            JSQMessagesBinaryWriteRecord(&writer, &record);
+
+            previousBits = bits;
+        }
+
+        writeTime += jsq_now() - start;
+        start = jsq_now();
+
+        JSQMessagesBinaryReader reader = jsq_readerForWriter(&writer);
+        JSQMessagesBinaryRecord record;
+        uint64_t bits = 0;
+        size_t count = 0;
+
+        while (JSQMessagesBinaryReadRecord(&reader, &record)) {
+            bits += (uint64_t)JSQMessagesBinaryZigzagDecode(record.encodedDateDelta);
+            checksum += record.stringLength + record.senderIndex;
+            count++;
+        }
+
+        readTime += jsq_now() - start;
+
+        JSQAssert(count == kMessageCount && !writer.failed, "%zu of %d messages read back", count, kMessageCount);
+        checksum += bits;
+
+        if (iteration < kIterations - 1) {
+            free(writer.bytes);
+        }
+    }
+
+    double megabytes = (double)writer.length * kIterations / 1e6;
+    double messages = (double)kMessageCount * kIterations;
+
+    printf("archive:   %8.1f bytes/message\n", (double)writer.length / kMessageCount);
+    printf("write:     %8.1f Mmessage/s %8.1f MB/s\n", messages / writeTime / 1e6, megabytes / writeTime);
+    printf("read:      %8.1f Mmessage/s %8.1f MB/s\n", messages / readTime / 1e6, megabytes / readTime);
+    printf("checksum:  %llu\n", (unsigned long long)checksum);
+
+    //  a generous floor, it only catches accidental quadratic behavior such as a buffer growing linearly
+    JSQAssert(messages / readTime > 1e6, "reading is slower than a million messages per second");
+    JSQAssert(messages / writeTime > 1e6, "writing is slower than a million messages per second");
+
+    free(writer.bytes);
+}
+
+
+int main(void)
+{
+#ifndef JSQ_BINARY_ARCHIVE_BENCHMARK_ONLY
+    jsq_testVarints();
+    jsq_testZigzag();
+    jsq_testDates();
+    jsq_testRecordRoundTrip();
+    jsq_testTruncatedRecords();
+    jsq_testCorruptRecords();
+    jsq_testHeader();
+    jsq_testArchiveRoundTrip();
+    jsq_testUTF8Validation();
+
+    if (jsq_failureCount > 0) {
+        fprintf(stderr, "%d failure(s)\n", jsq_failureCount);
+        return EXIT_FAILURE;
+    }
+
+    printf("all binary archive tests passed\n");
+#endif
+
+    jsq_benchmark();
+    return (jsq_failureCount > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
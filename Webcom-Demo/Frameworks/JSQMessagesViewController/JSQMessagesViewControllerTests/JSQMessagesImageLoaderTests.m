@@ -0,0 +1,114 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <XCTest/XCTest.h>
+
+#import "JSQMessagesImageLoader.h"
+
+
+@interface JSQMessagesImageLoaderTests : XCTestCase
+@end
+
+
+@implementation JSQMessagesImageLoaderTests
+
+- (UIImage *)jsq_imageWithScale:(CGFloat)scale
+{
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(4.0f, 4.0f), YES, scale);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+- (void)testCancellingOneRequestKeepsOtherRequestsForTheSameKey
+{
+    JSQMessagesImageLoader *loader = [[JSQMessagesImageLoader alloc] initWithName:[[NSUUID UUID] UUIDString]];
+    loader.maxConcurrentLoadCount = 1;
+    
+    //  occupy the only slot, so that the shared load is still pending when the first request is cancelled
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [loader loadImageForKey:@"blocking" usingBlock:^UIImage *(CGFloat scale) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return nil;
+    } completion:nil];
+    
+    __block NSUInteger loadCount = 0;
+    UIImage *(^block)(CGFloat) = ^UIImage *(CGFloat scale) {
+        loadCount++;
+        return [self jsq_imageWithScale:scale];
+    };
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"second request completes"];
+    
+    JSQMessagesLoadRequest *firstRequest = [loader loadImageForKey:@"shared" usingBlock:block completion:^(UIImage *image) {
+        XCTFail(@"A cancelled request must not be completed");
+    }];
+    
+    JSQMessagesLoadRequest *secondRequest = [loader loadImageForKey:@"shared" usingBlock:block completion:^(UIImage *image) {
+        XCTAssertNotNil(image);
+        [expectation fulfill];
+    }];
+    
+    XCTAssertNotNil(firstRequest);
+    XCTAssertNotNil(secondRequest);
+    XCTAssertNotEqual(firstRequest, secondRequest);
+    
+    [loader cancelLoadRequest:firstRequest];
+    dispatch_semaphore_signal(semaphore);
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(loadCount, (NSUInteger)1, @"Requests for the same key should be coalesced into a single load");
+    XCTAssertNotNil([loader cachedImageForKey:@"shared"]);
+    
+    [loader.diskCache removeAllImages];
+}
+
+- (void)testCancellingEveryRequestCancelsTheLoad
+{
+    JSQMessagesImageLoader *loader = [[JSQMessagesImageLoader alloc] initWithName:[[NSUUID UUID] UUIDString]];
+    loader.maxConcurrentLoadCount = 1;
+    
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    XCTestExpectation *expectation = [self expectationWithDescription:@"blocking load completes"];
+    [loader loadImageForKey:@"blocking" usingBlock:^UIImage *(CGFloat scale) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return nil;
+    } completion:^(UIImage *image) {
+        [expectation fulfill];
+    }];
+    
+    __block NSUInteger loadCount = 0;
+    UIImage *(^block)(CGFloat) = ^UIImage *(CGFloat scale) {
+        loadCount++;
+        return [self jsq_imageWithScale:scale];
+    };
+    
+    JSQMessagesLoadRequest *firstRequest = [loader loadImageForKey:@"shared" usingBlock:block completion:nil];
+    JSQMessagesLoadRequest *secondRequest = [loader loadImageForKey:@"shared" usingBlock:block completion:nil];
+    
+    [loader cancelLoadRequest:firstRequest];
+    [loader cancelLoadRequest:secondRequest];
+    dispatch_semaphore_signal(semaphore);
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(loadCount, (NSUInteger)0, @"A load nobody waits on anymore should be cancelled");
+    XCTAssertNil([loader cachedImageForKey:@"shared"]);
+}
+
+@end
@@ -0,0 +1,168 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+#import <XCTest/XCTest.h>
+
+#import "JSQMessagesImageLoader.h"
+#import "JSQMessagesMapSnapshotCache.h"
+
+
+@interface JSQMessagesMapSnapshotCache (JSQTesting)
+
+@property (strong, nonatomic, readonly) JSQMessagesImageLoader *loader;
+
+- (MKMapSnapshotter *)jsq_snapshotterWithOptions:(MKMapSnapshotOptions *)options;
+
+@end
+
+
+/**
+ *  A snapshot of a blank map, which maps the region of its options linearly to its image.
+ */
+@interface JSQFakeMapSnapshot : MKMapSnapshot
+
+@property (strong, nonatomic) MKMapSnapshotOptions *options;
+
+@end
+
+
+@implementation JSQFakeMapSnapshot
+
+- (UIImage *)image
+{
+    UIGraphicsBeginImageContextWithOptions(self.options.size, YES, self.options.scale);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+- (CGPoint)pointForCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    MKCoordinateRegion region = self.options.region;
+    CGSize size = self.options.size;
+    
+    return CGPointMake((coordinate.longitude - region.center.longitude) / region.span.longitudeDelta * size.width + size.width / 2.0f,
+                       (region.center.latitude - coordinate.latitude) / region.span.latitudeDelta * size.height + size.height / 2.0f);
+}
+
+@end
+
+
+/**
+ *  A snapshotter that completes with a `JSQFakeMapSnapshot`, without loading any map data.
+ */
+@interface JSQFakeMapSnapshotter : MKMapSnapshotter
+
+@property (strong, nonatomic) MKMapSnapshotOptions *options;
+
+@end
+
+
+@implementation JSQFakeMapSnapshotter
+
+- (instancetype)initWithOptions:(MKMapSnapshotOptions *)options
+{
+    self = [super initWithOptions:options];
+    if (self) {
+        _options = options;
+    }
+    return self;
+}
+
+- (void)startWithQueue:(dispatch_queue_t)queue completionHandler:(MKMapSnapshotCompletionHandler)completionHandler
+{
+    JSQFakeMapSnapshot *snapshot = [[JSQFakeMapSnapshot alloc] init];
+    snapshot.options = self.options;
+    
+    dispatch_async(queue, ^{
+        completionHandler(snapshot, nil);
+    });
+}
+
+- (void)cancel
+{
+}
+
+@end
+
+
+/**
+ *  A map snapshot cache that creates fake snapshotters and counts them.
+ */
+@interface JSQFakeMapSnapshotCache : JSQMessagesMapSnapshotCache
+
+@property (assign, atomic) NSUInteger snapshotterCount;
+
+@end
+
+
+@implementation JSQFakeMapSnapshotCache
+
+- (MKMapSnapshotter *)jsq_snapshotterWithOptions:(MKMapSnapshotOptions *)options
+{
+    self.snapshotterCount++;
+    return [[JSQFakeMapSnapshotter alloc] initWithOptions:options];
+}
+
+@end
+
+
+
+@interface JSQMessagesMapSnapshotCacheTests : XCTestCase
+@end
+
+
+@implementation JSQMessagesMapSnapshotCacheTests
+
+- (void)testNearbyLocationsShareASnapshotWhenOneIsCancelled
+{
+    JSQFakeMapSnapshotCache *cache = [[JSQFakeMapSnapshotCache alloc] initWithName:[[NSUUID UUID] UUIDString]];
+    
+    //  about 1 m apart, both quantize to the same snapshot at this size and zoom level
+    CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(48.858370, 2.294481);
+    CLLocationCoordinate2D nearbyCoordinate = CLLocationCoordinate2DMake(48.858375, 2.294486);
+    MKCoordinateRegion region = MKCoordinateRegionMakeWithDistance(coordinate, 500.0, 500.0);
+    MKCoordinateRegion nearbyRegion = MKCoordinateRegionMakeWithDistance(nearbyCoordinate, 500.0, 500.0);
+    CGSize size = CGSizeMake(210.0f, 150.0f);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"remaining item gets its snapshot"];
+    
+    //  the first item scrolls off screen before the snapshot is ready
+    JSQMessagesLoadRequest *request = [cache snapshotForCoordinate:coordinate region:region size:size completion:^(UIImage *snapshot) {
+        XCTFail(@"A cancelled request must not be completed");
+    }];
+    
+    [cache snapshotForCoordinate:nearbyCoordinate region:nearbyRegion size:size completion:^(UIImage *snapshot) {
+        XCTAssertNotNil(snapshot, @"Cancelling another item must not cancel the shared snapshot");
+        [expectation fulfill];
+    }];
+    
+    [cache cancelSnapshotRequest:request];
+    
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(cache.snapshotterCount, (NSUInteger)1, @"Nearby locations should be coalesced into a single snapshotter");
+    
+    XCTAssertEqual([cache cachedSnapshotForCoordinate:coordinate region:region size:size],
+                   [cache cachedSnapshotForCoordinate:nearbyCoordinate region:nearbyRegion size:size],
+                   @"Nearby locations should share a single snapshot");
+    
+    [cache.loader.diskCache removeAllImages];
+}
+
+@end
@@ -0,0 +1,285 @@
+//
+//  Created by Jesse Squires
+//  http://www.jessesquires.com
+//
+//
+//  Documentation
+//  http://cocoadocs.org/docsets/JSQMessagesViewController
+//
+//
+//  GitHub
+//  https://github.com/jessesquires/JSQMessagesViewController
+//
+//
+//  License
+//  Copyright (c) 2014 Jesse Squires
+//  Released under an MIT license: http://opensource.org/licenses/MIT
+//
+
+
+//  Portable tests and benchmark for the tint kernel, they do not need CoreGraphics nor Xcode.
+//
+//  From this directory:
+//
+//      cc -std=c99 -O2 -Wall -Wextra -I ../JSQMessagesViewController/Factories
+//          JSQMessagesTintKernelTests.c ../JSQMessagesViewController/Factories/JSQMessagesTintKernel.c
+//          -lm -o JSQMessagesTintKernelTests && ./JSQMessagesTintKernelTests
+//
+//  Add -DJSQ_TINT_KERNEL_BENCHMARK_ONLY to skip the tests, or -mno-sse2 on x86 to test the scalar path alone.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "JSQMessagesTintKernel.h"
+
+
+static int jsq_failureCount = 0;
+
+#define JSQAssert(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            jsq_failureCount++; \
+            fprintf(stderr, "%s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+        } \
+    } while (0)
+
+
+static uint32_t jsq_randomState = 0x9e3779b9u;
+
+static uint32_t jsq_random(void)
+{
+    //  xorshift32, so that runs are reproducible
+    jsq_randomState ^= jsq_randomState << 13;
+    jsq_randomState ^= jsq_randomState >> 17;
+    jsq_randomState ^= jsq_randomState << 5;
+    return jsq_randomState;
+}
+
+static JSQMessagesTintColor jsq_randomColor(void)
+{
+    uint32_t value = jsq_random();
+    JSQMessagesTintColor color = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    return color;
+}
+
+static double jsq_now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+
+//  MARK: - Reference
+
+//  CoreGraphics fills a clipped rect into an 8-bit premultiplied RGBA bitmap by premultiplying the color,
+//  then scaling it by the coverage of the mask, each step rounded to nearest.
+static uint8_t jsq_referenceComponent(uint8_t component, uint8_t alpha, uint8_t maskValue)
+{
+    double premultiplied = floor(component * alpha / 255.0 + 0.5);
+    return (uint8_t)floor(premultiplied * maskValue / 255.0 + 0.5);
+}
+
+static void jsq_referenceTint(const uint8_t *mask,
+                              size_t maskBytesPerRow,
+                              size_t width,
+                              size_t height,
+                              JSQMessagesTintColor color,
+                              uint8_t *destination,
+                              size_t destinationBytesPerRow)
+{
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint8_t maskValue = mask[y * maskBytesPerRow + x];
+            uint8_t *pixel = destination + y * destinationBytesPerRow + 4 * x;
+            pixel[0] = jsq_referenceComponent(color.red, color.alpha, maskValue);
+            pixel[1] = jsq_referenceComponent(color.green, color.alpha, maskValue);
+            pixel[2] = jsq_referenceComponent(color.blue, color.alpha, maskValue);
+            pixel[3] = jsq_referenceComponent(255, color.alpha, maskValue);
+        }
+    }
+}
+
+
+//  MARK: - Tests
+
+static void jsq_testKnownValues(void)
+{
+    //  single pixels worked out by hand from the CoreGraphics compositing rules
+    static const struct {
+        JSQMessagesTintColor color;
+        uint8_t mask;
+        uint8_t expected[4];
+    } cases[] = {
+        { { 255, 255, 255, 255 }, 255, { 255, 255, 255, 255 } },
+        { { 255, 255, 255, 255 }, 0, { 0, 0, 0, 0 } },
+        { { 255, 255, 255, 255 }, 128, { 128, 128, 128, 128 } },
+        { { 241, 110, 0, 255 }, 255, { 241, 110, 0, 255 } },
+        { { 241, 110, 0, 255 }, 64, { 60, 28, 0, 64 } },
+        { { 229, 229, 234, 255 }, 200, { 180, 180, 184, 200 } },
+        { { 0, 122, 255, 128 }, 255, { 0, 61, 128, 128 } },
+        { { 0, 122, 255, 128 }, 100, { 0, 24, 50, 50 } },
+        { { 10, 20, 30, 0 }, 255, { 0, 0, 0, 0 } },
+        { { 255, 0, 0, 1 }, 255, { 1, 0, 0, 1 } },
+    };
+    
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint8_t pixel[4] = { 0 };
+        JSQMessagesTintKernelApply(&cases[i].mask, 1, 1, 1, cases[i].color, pixel, cases[i].color, NULL, 4);
+        
+        JSQAssert(memcmp(pixel, cases[i].expected, 4) == 0,
+                  "case %zu: got %u %u %u %u, expected %u %u %u %u", i,
+                  pixel[0], pixel[1], pixel[2], pixel[3],
+                  cases[i].expected[0], cases[i].expected[1], cases[i].expected[2], cases[i].expected[3]);
+    }
+}
+
+static void jsq_testEveryMaskAndColorValue(void)
+{
+    //  one row holding every mask value, for every component and alpha value, exercises vector and scalar paths
+    uint8_t mask[256];
+    uint8_t pixels[256 * 4];
+    uint8_t expected[256 * 4];
+    
+    for (int i = 0; i < 256; i++) {
+        mask[i] = (uint8_t)i;
+    }
+    
+    for (int alpha = 0; alpha < 256; alpha++) {
+        for (int component = 0; component < 256; component++) {
+            JSQMessagesTintColor color = { (uint8_t)component, (uint8_t)(255 - component), (uint8_t)(component ^ 0x5a), (uint8_t)alpha };
+            
+            JSQMessagesTintKernelApply(mask, sizeof(mask), 256, 1, color, pixels, color, NULL, sizeof(pixels));
+            jsq_referenceTint(mask, sizeof(mask), 256, 1, color, expected, sizeof(expected));
+            
+            if (memcmp(pixels, expected, sizeof(pixels)) != 0) {
+                JSQAssert(0, "mismatch for color %d %d %d %d", color.red, color.green, color.blue, color.alpha);
+                return;
+            }
+        }
+    }
+}
+
+static void jsq_testRandomMasks(void)
+{
+    enum { kPadding = 16, kMaxSize = 67 };
+    
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        size_t width = 1 + jsq_random() % kMaxSize;
+        size_t height = 1 + jsq_random() % 9;
+        size_t maskBytesPerRow = width + jsq_random() % kPadding;
+        size_t destinationBytesPerRow = 4 * width + jsq_random() % kPadding;
+        
+        JSQMessagesTintColor color = jsq_randomColor();
+        JSQMessagesTintColor highlightedColor = jsq_randomColor();
+        
+        size_t destinationLength = destinationBytesPerRow * height;
+        uint8_t *mask = malloc(maskBytesPerRow * height);
+        uint8_t *destination = malloc(destinationLength);
+        uint8_t *highlightedDestination = malloc(destinationLength);
+        uint8_t *expected = malloc(destinationLength);
+        uint8_t *highlightedExpected = malloc(destinationLength);
+        
+        for (size_t i = 0; i < maskBytesPerRow * height; i++) {
+            mask[i] = (uint8_t)jsq_random();
+        }
+        
+        //  row padding must be left untouched, so the expected buffers start with the same bytes
+        memset(destination, 0xcd, destinationLength);
+        memset(highlightedDestination, 0xcd, destinationLength);
+        memset(expected, 0xcd, destinationLength);
+        memset(highlightedExpected, 0xcd, destinationLength);
+        
+        int withHighlight = iteration % 2;
+        
+        JSQMessagesTintKernelApply(mask, maskBytesPerRow, width, height,
+                                   color, destination,
+                                   highlightedColor, withHighlight ? highlightedDestination : NULL,
+                                   destinationBytesPerRow);
+        
+        jsq_referenceTint(mask, maskBytesPerRow, width, height, color, expected, destinationBytesPerRow);
+        JSQAssert(memcmp(destination, expected, destinationLength) == 0,
+                  "iteration %d: %zux%zu mask does not match the reference", iteration, width, height);
+        
+        if (withHighlight) {
+            jsq_referenceTint(mask, maskBytesPerRow, width, height, highlightedColor, highlightedExpected, destinationBytesPerRow);
+        }
+        JSQAssert(memcmp(highlightedDestination, highlightedExpected, destinationLength) == 0,
+                  "iteration %d: %zux%zu highlighted buffer does not match the reference", iteration, width, height);
+        
+        free(mask);
+        free(destination);
+        free(highlightedDestination);
+        free(expected);
+        free(highlightedExpected);
+    }
+}
+
+
+//  MARK: - Benchmark
+
+static void jsq_benchmark(void)
+{
+    //  about the size of a bubble template at @3x
+    enum { kWidth = 126, kHeight = 105, kIterations = 20000 };
+    
+    uint8_t *mask = malloc(kWidth * kHeight);
+    uint8_t *destination = malloc(4 * kWidth * kHeight);
+    uint8_t *highlightedDestination = malloc(4 * kWidth * kHeight);
+    
+    for (size_t i = 0; i < kWidth * kHeight; i++) {
+        mask[i] = (uint8_t)jsq_random();
+    }
+    
+    JSQMessagesTintColor color = { 241, 110, 0, 255 };
+    JSQMessagesTintColor highlightedColor = { 180, 82, 0, 255 };
+    
+    double start = jsq_now();
+    for (int i = 0; i < kIterations; i++) {
+        JSQMessagesTintKernelApply(mask, kWidth, kWidth, kHeight, color, destination, highlightedColor, highlightedDestination, 4 * kWidth);
+    }
+    double kernelTime = jsq_now() - start;
+    
+    start = jsq_now();
+    for (int i = 0; i < kIterations / 10; i++) {
+        jsq_referenceTint(mask, kWidth, kWidth, kHeight, color, destination, 4 * kWidth);
+        jsq_referenceTint(mask, kWidth, kWidth, kHeight, highlightedColor, highlightedDestination, 4 * kWidth);
+    }
+    double referenceTime = (jsq_now() - start) * 10.0;
+    
+    double pixels = (double)kWidth * kHeight * kIterations * 2.0;
+    printf("kernel:    %8.1f Mpixel/s\n", pixels / kernelTime / 1e6);
+    printf("reference: %8.1f Mpixel/s\n", pixels / referenceTime / 1e6);
+    printf("speedup:   %8.1fx\n", referenceTime / kernelTime);
+    
+    free(mask);
+    free(destination);
+    free(highlightedDestination);
+}
+
+
+int main(void)
+{
+#ifndef JSQ_TINT_KERNEL_BENCHMARK_ONLY
+    jsq_testKnownValues();
+    jsq_testEveryMaskAndColorValue();
+    jsq_testRandomMasks();
+    
+    if (jsq_failureCount > 0) {
+        fprintf(stderr, "%d failure(s)\n", jsq_failureCount);
+        return EXIT_FAILURE;
+    }
+    
+    printf("all tint kernel tests passed\n");
+#endif
+    
+    jsq_benchmark();
+    return EXIT_SUCCESS;
+}
@@ -43,10 +43,35 @@ FOUNDATION_EXPORT NSString * const kJSQSystemSoundTypeWAV;
  */
 typedef void(^JSQSystemSoundPlayerCompletionBlock)(void);
 
+/**
+ *  An integer handle to a loaded system sound. This is the underlying `SystemSoundID`.
+ */
+typedef UInt32 JSQSystemSoundHandle;
+
+/**
+ *  The value of a handle that does not refer to any loaded sound.
+ */
+FOUNDATION_EXPORT const JSQSystemSoundHandle JSQSystemSoundHandleNone;
+
+/**
+ *  A block called on the main queue after a sound has been loaded.
+ *
+ *  @param handle The handle of the loaded sound, or `JSQSystemSoundHandleNone` if it could not be loaded.
+ */
+typedef void(^JSQSystemSoundPlayerLoadCompletionBlock)(JSQSystemSoundHandle handle);
+
 /**
  *  The `JSQSystemSoundPlayer` class enables you to play sound effects, alert sounds, or other short sounds.
- *  It lazily loads and caches all `SystemSoundID` objects and purges them upon
- *  receiving the `UIApplicationDidReceiveMemoryWarningNotification` notification.
+ *  It lazily loads and caches `SystemSoundID` objects in a least recently used cache bounded by `maximumCachedSoundCount`.
+ *  Upon receiving the `UIApplicationDidReceiveMemoryWarningNotification` notification, it purges only the cold sounds,
+ *  that is the sounds that are neither pinned nor playing. Pinned sounds, like the sounds of sent and received messages,
+ *  stay loaded.
+ *
+ *  Sound files are loaded on a background queue. Playback is coalesced so that a sound plays at most once per
+ *  `burstInterval`, and limited to `maximumSoundsPerSecond` overall, so that a burst of messages does not
+ *  turn into a burst of sounds. Sounds that are skipped do not execute their completion blocks.
+ *
+ *  @warning The methods of this class should be called on the main thread.
  */
 @interface JSQSystemSoundPlayer : NSObject
 
@@ -65,6 +90,29 @@ typedef void(^JSQSystemSoundPlayerCompletionBlock)(void);
  */
 @property (strong, nonatomic) NSBundle *bundle;
 
+/**
+ *  The time interval, in seconds, during which further requests to play a sound that has just been played are ignored.
+ *  The default value is `0.25`. Specify `0` to disable coalescing.
+ */
+@property (assign, nonatomic) NSTimeInterval burstInterval;
+
+/**
+ *  The maximum number of sounds played per second, all sounds combined. Requests over this rate are ignored.
+ *  The default value is `4`. Specify `0` to disable rate limiting.
+ */
+@property (assign, nonatomic) NSUInteger maximumSoundsPerSecond;
+
+/**
+ *  The maximum number of sounds kept loaded. When it is exceeded, the least recently used sounds
+ *  that are neither pinned nor playing are unloaded. The default value is `16`. Specify `0` for no limit.
+ */
+@property (assign, nonatomic) NSUInteger maximumCachedSoundCount;
+
+/**
+ *  Returns the number of times sounds had to be loaded again after being evicted from the cache.
+ */
+@property (assign, nonatomic, readonly) NSUInteger totalReloadCount;
+
 /**
  *  Returns the shared `JSQSystemSoundPlayer` object. This method always returns the same sound system player object.
  *
@@ -180,7 +228,7 @@ typedef void(^JSQSystemSoundPlayerCompletionBlock)(void);
 
 /**
  *  Preloads a system sound object corresponding to an audio file with the given filename and extension.
- *  The system sound player will initialize, load, and cache the corresponding `SystemSoundID`.
+ *  The system sound player will initialize, load, and cache the corresponding `SystemSoundID` on a background queue.
  *
  *  @param filename      A string containing the base name of the audio file to play.
  *  @param fileExtension A string containing the extension of the audio file to play.
@@ -189,4 +237,79 @@ typedef void(^JSQSystemSoundPlayerCompletionBlock)(void);
  */
 - (void)preloadSoundWithFilename:(NSString *)filename fileExtension:(NSString *)fileExtension;
 
+/**
+ *  Loads a system sound object corresponding to an audio file with the given filename and extension in the given bundle,
+ *  on a background queue, and caches it under the given filename. Concurrent loads of the same file are coalesced.
+ *
+ *  @param filename      A string containing the base name of the audio file to load.
+ *  @param fileExtension A string containing the extension of the audio file to load.
+ *  This parameter must be one of `kJSQSystemSoundTypeCAF`, `kJSQSystemSoundTypeAIF`, `kJSQSystemSoundTypeAIFF`, or `kJSQSystemSoundTypeWAV`.
+ *  @param bundle        The bundle in which to search for the audio file. This value must not be `nil`.
+ *  @param completion    A block called on the main queue with the handle of the sound. May be `nil`.
+ *  If the sound is already loaded, the block is called synchronously.
+ */
+- (void)loadSoundWithFilename:(NSString *)filename
+                fileExtension:(NSString *)fileExtension
+                       bundle:(NSBundle *)bundle
+                   completion:(JSQSystemSoundPlayerLoadCompletionBlock)completion;
+
+/**
+ *  Returns the handle of the loaded sound for the given filename.
+ *
+ *  @param filename The filename of the sound.
+ *
+ *  @return The handle of the sound, or `JSQSystemSoundHandleNone` if it is not loaded.
+ */
+- (JSQSystemSoundHandle)soundHandleForFilename:(NSString *)filename;
+
+/**
+ *  Plays the loaded sound with the given handle. This does not touch the file system or the bundle.
+ *
+ *  @param handle A handle returned by `soundHandleForFilename:` or passed to a load completion block.
+ *
+ *  @warning Handles are invalidated when sounds are stopped or purged.
+ */
+- (void)playSoundWithHandle:(JSQSystemSoundHandle)handle;
+
+/**
+ *  Plays the loaded sound with the given handle *as an alert*, invoking device vibration if available.
+ *
+ *  @param handle A handle returned by `soundHandleForFilename:` or passed to a load completion block.
+ *
+ *  @warning Handles are invalidated when sounds are stopped or purged.
+ */
+- (void)playAlertSoundWithHandle:(JSQSystemSoundHandle)handle;
+
+/**
+ *  Pins the sound with the given filename, so that it is never evicted from the cache.
+ *  The sound does not have to be loaded yet.
+ *
+ *  @param filename The filename of the sound.
+ *
+ *  @discussion Pinned sounds are still unloaded by `stopAllSounds` and `stopSoundWithFilename:`.
+ */
+- (void)pinSoundWithFilename:(NSString *)filename;
+
+/**
+ *  Unpins the sound with the given filename, so that it can be evicted from the cache again.
+ *
+ *  @param filename The filename of the sound.
+ */
+- (void)unpinSoundWithFilename:(NSString *)filename;
+
+/**
+ *  Unloads all sounds that are neither pinned nor playing.
+ *  This method is called when the application receives a memory warning.
+ */
+- (void)purgeColdSounds;
+
+/**
+ *  Returns the number of times the sound with the given filename had to be loaded again after being evicted from the cache.
+ *
+ *  @param filename The filename of the sound.
+ *
+ *  @return The reload count of the sound.
+ */
+- (NSUInteger)reloadCountForSoundWithFilename:(NSString *)filename;
+
 @end
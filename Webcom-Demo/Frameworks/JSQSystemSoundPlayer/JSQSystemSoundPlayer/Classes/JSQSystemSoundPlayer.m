@@ -29,24 +29,47 @@ NSString * const kJSQSystemSoundTypeAIF = @"aif";
 NSString * const kJSQSystemSoundTypeAIFF = @"aiff";
 NSString * const kJSQSystemSoundTypeWAV = @"wav";
 
+const JSQSystemSoundHandle JSQSystemSoundHandleNone = 0;
+
 @interface JSQSystemSoundPlayer ()
 
 @property (strong, nonatomic) NSMutableDictionary *sounds;
 @property (strong, nonatomic) NSMutableDictionary *completionBlocks;
 
+@property (strong, nonatomic) NSMutableDictionary *filenamesForSoundIDs;
+@property (strong, nonatomic) NSMutableOrderedSet *recentlyUsedFilenames;
+@property (strong, nonatomic) NSMutableSet *pinnedFilenames;
+@property (strong, nonatomic) NSMutableSet *evictedFilenames;
+@property (strong, nonatomic) NSCountedSet *reloadCounts;
+@property (assign, nonatomic, readwrite) NSUInteger totalReloadCount;
+
+@property (strong, nonatomic) NSMutableDictionary *pendingLoads;
+@property (strong, nonatomic) dispatch_queue_t loadingQueue;
+
+@property (strong, nonatomic) NSMutableDictionary *lastPlayTimes;
+@property (assign, nonatomic) double availablePlayTokens;
+@property (assign, nonatomic) CFAbsoluteTime lastPlayTokensRefillTime;
+
 - (void)playSoundWithName:(NSString *)filename
                 extension:(NSString *)extension
                   isAlert:(BOOL)isAlert
           completionBlock:(JSQSystemSoundPlayerCompletionBlock)completionBlock;
 
-- (BOOL)readSoundPlayerOnFromUserDefaults;
+- (void)playSoundID:(SystemSoundID)soundID
+            isAlert:(BOOL)isAlert
+    completionBlock:(JSQSystemSoundPlayerCompletionBlock)completionBlock;
 
-- (NSData *)dataWithSoundID:(SystemSoundID)soundID;
-- (SystemSoundID)soundIDFromData:(NSData *)data;
+- (BOOL)shouldPlaySoundID:(SystemSoundID)soundID;
+
+- (BOOL)readSoundPlayerOnFromUserDefaults;
 
 - (SystemSoundID)soundIDForFilename:(NSString *)filenameKey;
-- (void)addSoundIDForAudioFileWithName:(NSString *)filename
-                             extension:(NSString *)extension;
+- (void)finishLoadingSoundID:(SystemSoundID)soundID forFilename:(NSString *)filename;
+
+- (void)markSoundIDAsRecentlyUsed:(SystemSoundID)soundID;
+- (BOOL)isSoundWithFilenameCold:(NSString *)filename;
+- (void)evictSoundWithFilename:(NSString *)filename;
+- (void)evictSoundsExceedingMaximumCount;
 
 - (JSQSystemSoundPlayerCompletionBlock)completionBlockForSoundID:(SystemSoundID)soundID;
 - (void)addCompletionBlock:(JSQSystemSoundPlayerCompletionBlock)block
@@ -54,7 +77,8 @@ NSString * const kJSQSystemSoundTypeWAV = @"wav";
 - (void)removeCompletionBlockForSoundID:(SystemSoundID)soundID;
 
 - (SystemSoundID)createSoundIDWithName:(NSString *)filename
-                             extension:(NSString *)extension;
+                             extension:(NSString *)extension
+                                bundle:(NSBundle *)bundle;
 
 - (void)unloadSoundIDs;
 - (void)unloadSoundIDForFileNamed:(NSString *)filename;
@@ -104,6 +128,19 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
         _on = [self readSoundPlayerOnFromUserDefaults];
         _sounds = [[NSMutableDictionary alloc] init];
         _completionBlocks = [[NSMutableDictionary alloc] init];
+        _filenamesForSoundIDs = [[NSMutableDictionary alloc] init];
+        _recentlyUsedFilenames = [[NSMutableOrderedSet alloc] init];
+        _pinnedFilenames = [[NSMutableSet alloc] init];
+        _evictedFilenames = [[NSMutableSet alloc] init];
+        _reloadCounts = [[NSCountedSet alloc] init];
+        _maximumCachedSoundCount = 16;
+        _pendingLoads = [[NSMutableDictionary alloc] init];
+        _loadingQueue = dispatch_queue_create("com.jessesquires.JSQSystemSoundPlayer.loading", DISPATCH_QUEUE_SERIAL);
+        _lastPlayTimes = [[NSMutableDictionary alloc] init];
+        _burstInterval = 0.25;
+        _maximumSoundsPerSecond = 4;
+        _availablePlayTokens = _maximumSoundsPerSecond;
+        _lastPlayTokensRefillTime = CFAbsoluteTimeGetCurrent();
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(didReceiveMemoryWarningNotification:)
                                                      name:UIApplicationDidReceiveMemoryWarningNotification
@@ -117,6 +154,13 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
     [self unloadSoundIDs];
     _sounds = nil;
     _completionBlocks = nil;
+    _filenamesForSoundIDs = nil;
+    _recentlyUsedFilenames = nil;
+    _pinnedFilenames = nil;
+    _evictedFilenames = nil;
+    _reloadCounts = nil;
+    _pendingLoads = nil;
+    _lastPlayTimes = nil;
     [[NSNotificationCenter defaultCenter] removeObserver:self
                                                     name:UIApplicationDidReceiveMemoryWarningNotification
                                                   object:nil];
@@ -137,34 +181,89 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
         return;
     }
     
-    if (![self.sounds objectForKey:filename]) {
-        [self addSoundIDForAudioFileWithName:filename extension:extension];
-    }
-    
     SystemSoundID soundID = [self soundIDForFilename:filename];
     if (soundID) {
-        if (completionBlock) {
-            OSStatus error = AudioServicesAddSystemSoundCompletion(soundID,
-                                                                   NULL,
-                                                                   NULL,
-                                                                   systemServicesSoundCompletion,
-                                                                   NULL);
-            
-            if (error) {
-                [self logError:error withMessage:@"Warning! Completion block could not be added to SystemSoundID."];
-            }
-            else {
-                [self addCompletionBlock:completionBlock toSoundID:soundID];
-            }
-        }
+        [self playSoundID:soundID isAlert:isAlert completionBlock:completionBlock];
+        return;
+    }
+    
+    //  play once the file is loaded in the background, the rate limits still apply then
+    __weak JSQSystemSoundPlayer *weakSelf = self;
+    [self loadSoundWithFilename:filename
+                  fileExtension:extension
+                         bundle:self.bundle
+                     completion:^(JSQSystemSoundHandle handle) {
+                         if (handle != JSQSystemSoundHandleNone) {
+                             [weakSelf playSoundID:handle isAlert:isAlert completionBlock:completionBlock];
+                         }
+                     }];
+}
+
+- (void)playSoundID:(SystemSoundID)soundID
+            isAlert:(BOOL)isAlert
+    completionBlock:(JSQSystemSoundPlayerCompletionBlock)completionBlock
+{
+    if (!self.on || !soundID) {
+        return;
+    }
+    
+    [self markSoundIDAsRecentlyUsed:soundID];
+    
+    if (![self shouldPlaySoundID:soundID]) {
+        return;
+    }
+    
+    if (completionBlock) {
+        OSStatus error = AudioServicesAddSystemSoundCompletion(soundID,
+                                                               NULL,
+                                                               NULL,
+                                                               systemServicesSoundCompletion,
+                                                               NULL);
         
-        if (isAlert) {
-            AudioServicesPlayAlertSound(soundID);
+        if (error) {
+            [self logError:error withMessage:@"Warning! Completion block could not be added to SystemSoundID."];
         }
         else {
-            AudioServicesPlaySystemSound(soundID);
+            [self addCompletionBlock:completionBlock toSoundID:soundID];
+        }
+    }
+    
+    if (isAlert) {
+        AudioServicesPlayAlertSound(soundID);
+    }
+    else {
+        AudioServicesPlaySystemSound(soundID);
+    }
+}
+
+- (BOOL)shouldPlaySoundID:(SystemSoundID)soundID
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSNumber *key = @(soundID);
+    
+    //  one sound per burst, requests within the window of the sound that was played are dropped
+    NSNumber *lastPlayTime = [self.lastPlayTimes objectForKey:key];
+    if (lastPlayTime && now - [lastPlayTime doubleValue] < self.burstInterval) {
+        return NO;
+    }
+    
+    //  token bucket shared by all sounds, refilled at the maximum rate
+    if (self.maximumSoundsPerSecond > 0) {
+        double capacity = (double)self.maximumSoundsPerSecond;
+        double refill = (now - self.lastPlayTokensRefillTime) * capacity;
+        
+        self.availablePlayTokens = MIN(capacity, self.availablePlayTokens + MAX(refill, 0.0));
+        self.lastPlayTokensRefillTime = now;
+        
+        if (self.availablePlayTokens < 1.0) {
+            return NO;
         }
+        
+        self.availablePlayTokens -= 1.0;
     }
+    
+    [self.lastPlayTimes setObject:@(now) forKey:key];
+    return YES;
 }
 
 - (BOOL)readSoundPlayerOnFromUserDefaults
@@ -179,6 +278,21 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
     return [setting boolValue];
 }
 
+#pragma mark - Setters
+
+- (void)setMaximumSoundsPerSecond:(NSUInteger)maximumSoundsPerSecond
+{
+    _maximumSoundsPerSecond = maximumSoundsPerSecond;
+    _availablePlayTokens = maximumSoundsPerSecond;
+    _lastPlayTokensRefillTime = CFAbsoluteTimeGetCurrent();
+}
+
+- (void)setMaximumCachedSoundCount:(NSUInteger)maximumCachedSoundCount
+{
+    _maximumCachedSoundCount = maximumCachedSoundCount;
+    [self evictSoundsExceedingMaximumCount];
+}
+
 #pragma mark - Public API
 
 - (void)toggleSoundPlayerOn:(BOOL)on
@@ -243,55 +357,208 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
 - (void)stopSoundWithFilename:(NSString *)filename
 {
     SystemSoundID soundID = [self soundIDForFilename:filename];
-    NSData *data = [self dataWithSoundID:soundID];
     
     [self unloadSoundIDForFileNamed:filename];
     
     [_sounds removeObjectForKey:filename];
-    [_completionBlocks removeObjectForKey:data];
+    [_completionBlocks removeObjectForKey:@(soundID)];
+    [_lastPlayTimes removeObjectForKey:@(soundID)];
+    [_filenamesForSoundIDs removeObjectForKey:@(soundID)];
+    [_recentlyUsedFilenames removeObject:filename];
+    [[_pendingLoads objectForKey:filename] removeAllObjects];
 }
 
 - (void)preloadSoundWithFilename:(NSString *)filename fileExtension:(NSString *)extension
 {
-    if (![self.sounds objectForKey:filename]) {
-        [self addSoundIDForAudioFileWithName:filename extension:extension];
+    [self loadSoundWithFilename:filename fileExtension:extension bundle:self.bundle completion:nil];
+}
+
+- (void)loadSoundWithFilename:(NSString *)filename
+                fileExtension:(NSString *)extension
+                       bundle:(NSBundle *)bundle
+                   completion:(JSQSystemSoundPlayerLoadCompletionBlock)completion
+{
+    if (!filename || !extension || !bundle) {
+        return;
     }
+    
+    SystemSoundID soundID = [self soundIDForFilename:filename];
+    if (soundID) {
+        if (completion) {
+            completion(soundID);
+        }
+        return;
+    }
+    
+    NSMutableArray *completions = [self.pendingLoads objectForKey:filename];
+    BOOL isLoading = (completions != nil);
+    
+    if (!isLoading) {
+        completions = [[NSMutableArray alloc] init];
+        [self.pendingLoads setObject:completions forKey:filename];
+    }
+    
+    if (completion) {
+        [completions addObject:[completion copy]];
+    }
+    
+    if (isLoading) {
+        return;
+    }
+    
+    dispatch_async(self.loadingQueue, ^{
+        SystemSoundID loadedSoundID = [self createSoundIDWithName:filename extension:extension bundle:bundle];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishLoadingSoundID:loadedSoundID forFilename:filename];
+        });
+    });
 }
 
-#pragma mark - Sound data
+- (JSQSystemSoundHandle)soundHandleForFilename:(NSString *)filename
+{
+    return [self soundIDForFilename:filename];
+}
 
-- (NSData *)dataWithSoundID:(SystemSoundID)soundID
+- (void)playSoundWithHandle:(JSQSystemSoundHandle)handle
 {
-    return [NSData dataWithBytes:&soundID length:sizeof(SystemSoundID)];
+    [self playSoundID:handle isAlert:NO completionBlock:nil];
 }
 
-- (SystemSoundID)soundIDFromData:(NSData *)data
+- (void)playAlertSoundWithHandle:(JSQSystemSoundHandle)handle
 {
-    if (data == nil) {
-        return 0;
+    [self playSoundID:handle isAlert:YES completionBlock:nil];
+}
+
+- (void)pinSoundWithFilename:(NSString *)filename
+{
+    if (!filename) {
+        return;
+    }
+    
+    [self.pinnedFilenames addObject:filename];
+}
+
+- (void)unpinSoundWithFilename:(NSString *)filename
+{
+    if (!filename) {
+        return;
     }
     
-    SystemSoundID soundID;
-    [data getBytes:&soundID length:sizeof(SystemSoundID)];
-    return soundID;
+    [self.pinnedFilenames removeObject:filename];
+    [self evictSoundsExceedingMaximumCount];
+}
+
+- (void)purgeColdSounds
+{
+    for (NSString *eachFilename in [self.recentlyUsedFilenames array]) {
+        if ([self isSoundWithFilenameCold:eachFilename]) {
+            [self evictSoundWithFilename:eachFilename];
+        }
+    }
+}
+
+- (NSUInteger)reloadCountForSoundWithFilename:(NSString *)filename
+{
+    return [self.reloadCounts countForObject:filename];
 }
 
 #pragma mark - Sound files
 
 - (SystemSoundID)soundIDForFilename:(NSString *)filenameKey
 {
-    NSData *soundData = [self.sounds objectForKey:filenameKey];
-    return [self soundIDFromData:soundData];
+    if (!filenameKey) {
+        return 0;
+    }
+    
+    NSNumber *soundIDNumber = [self.sounds objectForKey:filenameKey];
+    return [soundIDNumber unsignedIntValue];
 }
 
-- (void)addSoundIDForAudioFileWithName:(NSString *)filename
-                             extension:(NSString *)extension
+- (void)finishLoadingSoundID:(SystemSoundID)soundID forFilename:(NSString *)filename
 {
-    SystemSoundID soundID = [self createSoundIDWithName:filename
-                                              extension:extension];
+    NSArray *completions = [self.pendingLoads objectForKey:filename];
+    [self.pendingLoads removeObjectForKey:filename];
+    
     if (soundID) {
-        NSData *data = [self dataWithSoundID:soundID];
-        [self.sounds setObject:data forKey:filename];
+        [self.sounds setObject:@(soundID) forKey:filename];
+        [self.filenamesForSoundIDs setObject:filename forKey:@(soundID)];
+        [self.recentlyUsedFilenames removeObject:filename];
+        [self.recentlyUsedFilenames addObject:filename];
+        
+        if ([self.evictedFilenames containsObject:filename]) {
+            [self.evictedFilenames removeObject:filename];
+            [self.reloadCounts addObject:filename];
+            self.totalReloadCount++;
+        }
+        
+        [self evictSoundsExceedingMaximumCount];
+    }
+    
+    for (JSQSystemSoundPlayerLoadCompletionBlock completion in completions) {
+        completion(soundID);
+    }
+}
+
+#pragma mark - Sound cache
+
+- (void)markSoundIDAsRecentlyUsed:(SystemSoundID)soundID
+{
+    NSString *filename = [self.filenamesForSoundIDs objectForKey:@(soundID)];
+    if (!filename) {
+        return;
+    }
+    
+    //  the most recently used sound is the last one
+    [self.recentlyUsedFilenames removeObject:filename];
+    [self.recentlyUsedFilenames addObject:filename];
+}
+
+- (BOOL)isSoundWithFilenameCold:(NSString *)filename
+{
+    if ([self.pinnedFilenames containsObject:filename]) {
+        return NO;
+    }
+    
+    //  a sound with a completion block is still playing
+    SystemSoundID soundID = [self soundIDForFilename:filename];
+    return ([self completionBlockForSoundID:soundID] == nil);
+}
+
+- (void)evictSoundWithFilename:(NSString *)filename
+{
+    SystemSoundID soundID = [self soundIDForFilename:filename];
+    if (!soundID) {
+        return;
+    }
+    
+    [self unloadSoundIDForFileNamed:filename];
+    
+    [self.sounds removeObjectForKey:filename];
+    [self.lastPlayTimes removeObjectForKey:@(soundID)];
+    [self.filenamesForSoundIDs removeObjectForKey:@(soundID)];
+    [self.recentlyUsedFilenames removeObject:filename];
+    [self.evictedFilenames addObject:filename];
+}
+
+- (void)evictSoundsExceedingMaximumCount
+{
+    if (self.maximumCachedSoundCount == 0) {
+        return;
+    }
+    
+    NSInteger excessCount = (NSInteger)[self.sounds count] - (NSInteger)self.maximumCachedSoundCount;
+    
+    //  least recently used first, pinned and playing sounds are skipped
+    for (NSString *eachFilename in [self.recentlyUsedFilenames array]) {
+        if (excessCount <= 0) {
+            break;
+        }
+        
+        if ([self isSoundWithFilenameCold:eachFilename]) {
+            [self evictSoundWithFilename:eachFilename];
+            excessCount--;
+        }
     }
 }
 
@@ -299,21 +566,18 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
 
 - (JSQSystemSoundPlayerCompletionBlock)completionBlockForSoundID:(SystemSoundID)soundID
 {
-    NSData *data = [self dataWithSoundID:soundID];
-    return [self.completionBlocks objectForKey:data];
+    return [self.completionBlocks objectForKey:@(soundID)];
 }
 
 - (void)addCompletionBlock:(JSQSystemSoundPlayerCompletionBlock)block
                  toSoundID:(SystemSoundID)soundID
 {
-    NSData *data = [self dataWithSoundID:soundID];
-    [self.completionBlocks setObject:block forKey:data];
+    [self.completionBlocks setObject:[block copy] forKey:@(soundID)];
 }
 
 - (void)removeCompletionBlockForSoundID:(SystemSoundID)soundID
 {
-    NSData *key = [self dataWithSoundID:soundID];
-    [self.completionBlocks removeObjectForKey:key];
+    [self.completionBlocks removeObjectForKey:@(soundID)];
     AudioServicesRemoveSystemSoundCompletion(soundID);
 }
 
@@ -321,8 +585,9 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
 
 - (SystemSoundID)createSoundIDWithName:(NSString *)filename
                              extension:(NSString *)extension
+                                bundle:(NSBundle *)bundle
 {
-    NSURL *fileURL = [self.bundle URLForResource:filename withExtension:extension];
+    NSURL *fileURL = [bundle URLForResource:filename withExtension:extension];
     
     if ([[NSFileManager defaultManager] fileExistsAtPath:[fileURL path]]) {
         SystemSoundID soundID;
@@ -349,6 +614,14 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
     
     [_sounds removeAllObjects];
     [_completionBlocks removeAllObjects];
+    [_lastPlayTimes removeAllObjects];
+    [_filenamesForSoundIDs removeAllObjects];
+    [_recentlyUsedFilenames removeAllObjects];
+    
+    //  loads in flight still complete and cache their sound, but no longer play it
+    for (NSMutableArray *completions in [_pendingLoads allValues]) {
+        [completions removeAllObjects];
+    }
 }
 
 - (void)unloadSoundIDForFileNamed:(NSString *)filename
@@ -394,7 +667,7 @@ static void systemServicesSoundCompletion(SystemSoundID  soundID, void *data)
 
 - (void)didReceiveMemoryWarningNotification:(NSNotification *)notification
 {
-    [self unloadSoundIDs];
+    [self purgeColdSounds];
 }
 
 @end
@@ -13,12 +13,21 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
 {
     // MARK: - Private properties
     
-    // Messages
-    private var messages = [JSQMessage]()
+    // Messages, stored in columns: message objects are only created for the rows being displayed
+    private let messages = JSQMessagesColumnStore()
     
     // Image factory for message bubbles
     // We set the default image because there is a bug in JSQMessageViewController which makes the image blurry on @2x and @3x screens
-    private let messagesBubbleImageFactory = JSQMessagesBubbleImageFactory(bubbleImage: UIImage(named: "bubble_min"), capInsets: UIEdgeInsetsZero)
+    private static let bubbleTemplateImage = UIImage(named: "bubble_min")!
+    private let messagesBubbleImageFactory = JSQMessagesBubbleImageFactory(bubbleImage: MessagesViewController.bubbleTemplateImage, capInsets: UIEdgeInsetsZero)
+    
+    // Bubble colors
+    private static let outgoingBubbleColor = UIColor(red: 241.0 / 255.0, green: 110.0 / 255.0, blue: 0.0, alpha: 1.0)
+    private static let incomingBubbleColor = UIColor(red: 229.0 / 255.0, green: 229.0 / 255.0, blue: 234.0 / 255.0, alpha: 1.0)
+    
+    // Bubble images, created once so that rendered cells can be cached
+    private lazy var outgoingBubbleImage: JSQMessagesBubbleImage = self.messagesBubbleImageFactory.outgoingMessagesBubbleImageWithColor(MessagesViewController.outgoingBubbleColor)
+    private lazy var incomingBubbleImage: JSQMessagesBubbleImage = self.messagesBubbleImageFactory.incomingMessagesBubbleImageWithColor(MessagesViewController.incomingBubbleColor)
     
     // Identifier of recipient for a private chat room, nil for general chat room
     private var recipientIdentifier: String?
@@ -60,10 +69,19 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
     
     // MARK: - Overriden methods
     
+    override class func loadsViewsFromNib() -> Bool
+    {
+        // Build the views in code instead of decoding the nibs
+        return false
+    }
+    
     override init(nibName nibNameOrNil: String?, bundle nibBundleOrNil: NSBundle?)
     {
         super.init(nibName: nibNameOrNil, bundle: nibBundleOrNil)
         
+        // Render the bubbles in the background, before the first messages are received
+        JSQMessagesBubbleImageAtlas.sharedAtlas().prepareWithTemplateImages([MessagesViewController.bubbleTemplateImage], colors: [MessagesViewController.outgoingBubbleColor, MessagesViewController.incomingBubbleColor], completion: nil)
+        
         senderDisplayName = ""
         senderId = ""
         
@@ -84,6 +102,9 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
         inputToolbar?.contentView?.rightBarButtonItem?.setTitleColor(UIApplication.sharedApplication().delegate?.window??.tintColor, forState: .Normal)
         collectionView?.collectionViewLayout.outgoingAvatarViewSize = CGSizeZero
         collectionView?.collectionViewLayout.incomingAvatarViewSize = CGSizeZero
+        
+        // Render text cells in the background while scrolling
+        cellRenderer = JSQMessagesCellRenderer.sharedRenderer()
     }
     
     override func didPressSendButton(button: UIButton!, withMessageText text: String!, senderId: String!, senderDisplayName: String!, date: NSDate!)
@@ -98,7 +119,13 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
     
     override func collectionView(collectionView: JSQMessagesCollectionView!, messageDataForItemAtIndexPath indexPath: NSIndexPath!) -> JSQMessageData!
     {
-        return messages[indexPath.row]
+        return messages.messageAtIndex(indexPath.row)
+    }
+    
+    func collectionView(collectionView: JSQMessagesCollectionView!, layoutMessageDataForItemAtIndexPath indexPath: NSIndexPath!) -> JSQMessageData!
+    {
+        // Sizing every row must not create a message object for each of them
+        return messages.layoutMessageDataAtIndex(indexPath.row)
     }
     
     override func collectionView(collectionView: JSQMessagesCollectionView!, avatarImageDataForItemAtIndexPath indexPath: NSIndexPath!) -> JSQMessageAvatarImageDataSource!
@@ -108,17 +135,12 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
     
     override func collectionView(collectionView: JSQMessagesCollectionView!, messageBubbleImageDataForItemAtIndexPath indexPath: NSIndexPath!) -> JSQMessageBubbleImageDataSource!
     {
-        let message = messages[indexPath.row]
-        let outgoingBubbleColor = UIColor(red: 241.0 / 255.0, green: 110.0 / 255.0, blue: 0.0, alpha: 1.0)
-        let incomingBubbleColor = UIColor(red: 229.0 / 255.0, green: 229.0 / 255.0, blue: 234.0 / 255.0, alpha: 1.0)
-        
-        return message.senderId == senderId ? messagesBubbleImageFactory.outgoingMessagesBubbleImageWithColor(outgoingBubbleColor) : messagesBubbleImageFactory.incomingMessagesBubbleImageWithColor(incomingBubbleColor)
+        return messages.senderOrdinalAtIndex(indexPath.row) == senderOrdinal ? outgoingBubbleImage : incomingBubbleImage
     }
     
     override func collectionView(collectionView: JSQMessagesCollectionView!, attributedTextForMessageBubbleTopLabelAtIndexPath indexPath: NSIndexPath!) -> NSAttributedString!
     {
-        let message = messages[indexPath.row]
-        let displayName = message.senderDisplayName ?? ""
+        let displayName = messages.senderDisplayNameAtIndex(indexPath.row) ?? ""
         
         return shouldShowMessageBubbleTopLabelAtIndexPath(indexPath) ? NSAttributedString(string: displayName) : nil
     }
@@ -133,9 +155,9 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
     override func collectionView(collectionView: UICollectionView, cellForItemAtIndexPath indexPath: NSIndexPath) -> UICollectionViewCell {
         
         let cell = super.collectionView(collectionView, cellForItemAtIndexPath: indexPath) as! JSQMessagesCollectionViewCell
-        let message = messages[indexPath.row]
+        let isOutgoingMessage = messages.senderOrdinalAtIndex(indexPath.row) == senderOrdinal
         
-        cell.textView?.textColor = message.senderId == senderId ? UIColor.whiteColor() : UIColor.blackColor()
+        cell.textView?.textColor = isOutgoingMessage ? UIColor.whiteColor() : UIColor.blackColor()
         
         return cell
     }
@@ -207,17 +229,14 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
      */
     private func shouldShowMessageBubbleTopLabelAtIndexPath(indexPath: NSIndexPath) -> Bool
     {
-        let message = messages[indexPath.row]
-        var previousMessage: JSQMessage?
+        let displayName = messages.senderDisplayNameAtIndex(indexPath.row) ?? ""
+        var previousDisplayName = ""
         
         if indexPath.row - 1 >= 0
         {
-            previousMessage = messages[indexPath.row - 1]
+            previousDisplayName = messages.senderDisplayNameAtIndex(indexPath.row - 1) ?? ""
         }
         
-        let displayName = message.senderDisplayName ?? ""
-        let previousDisplayName = previousMessage?.senderDisplayName ?? ""
-        
         // Label is displayed if user is in general chat AND message sender is not user AND previous message sender is different from the current message sender
         return recipientIdentifier == nil && senderDisplayName != displayName && displayName != previousDisplayName
     }
@@ -232,7 +251,7 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
     {
         title = recipientIdentifier ?? NSLocalizedString("GeneralChatRoomTitleKey", comment: "")
         
-        messages.removeAll()
+        messages.removeAllMessages()
         collectionView?.reloadData()
         
         if userIdentifier != nil
@@ -244,8 +263,7 @@ class MessagesViewController: JSQMessagesViewController, ChatRoomsViewController
                     (senderIdentifier: String, text: String) -> Void in
                     
                     // Insert new message
-                    let message = JSQMessage(senderId: senderIdentifier, displayName: senderIdentifier, text: text)
-                    self.messages.append(message)
+                    self.messages.appendMessageWithSenderId(senderIdentifier, senderDisplayName: senderIdentifier, date: NSDate(), text: text)
                     
                     if userIdentifier != senderIdentifier
                     {